@@ -30,760 +30,4302 @@
 
 /* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ Include ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
 #include "st7789.h"
+#include "st7789_bus.h"
+
+#include <stdlib.h>
 
 /* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ G Variables ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
-#ifdef ST7789_USE_DMA
+#if defined(ST7789_USE_DMA) && (ST7789_HOR_LEN > 0)
 
 #define LCD_BUFFER_LENGTH (ST7789_WIDTH_MODIFIED * ST7789_HOR_LEN)
+#define LCD_BUFFER_LINES  (((LCD_BUFFER_LENGTH * 2) + ST7789_CACHE_LINE - 1) / ST7789_CACHE_LINE)
 
-uint16_t LCDBuffer[LCD_BUFFER_LENGTH];
+/* Padded to whole cache lines, so no other variable shares a line with the buffer */
+ST7789_ALIGNED uint16_t LCDBuffer[LCD_BUFFER_LINES * (ST7789_CACHE_LINE / 2)];
 
 #endif
 
+ST7789_HandleTypeDef ST7789_Display; // Display of the ST7789_xxx functions
+
 /* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ G Enum ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
 /* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ G Struct ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
-/* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ G Types ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
-/* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ Function ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
-void ST7789_TransmitCommand(ST7789_CMDTypeDef CMD)
-{
-	
-	/* ---------------- Select Chip ----------------- */
-	ST7789_GPIO_WritePin(ST7789_CS_GPIO_PORT, ST7789_CS_GPIO_PIN, ST7789_GPIO_PIN_RESET);
-	
-	/* ------------- Set to Command Mode ------------ */
-	ST7789_GPIO_WritePin(ST7789_DC_GPIO_PORT, ST7789_DC_GPIO_PIN, ST7789_GPIO_PIN_RESET);
-	
-	/* ---------------- Transmit Data --------------- */
-	ST7789_SPI_Transmit(&CMD, 1, ST7789_SPI_TIMEOUT);
-	
-	/* ---------------- Unselect Chip --------------- */
-	ST7789_GPIO_WritePin(ST7789_CS_GPIO_PORT, ST7789_CS_GPIO_PIN, ST7789_GPIO_PIN_SET);
-	
-}
-
-void ST7789_TransmitSingleData(uint8_t Data)
-{
-	
-	/* ---------------- Select Chip ----------------- */
-	ST7789_GPIO_WritePin(ST7789_CS_GPIO_PORT, ST7789_CS_GPIO_PIN, ST7789_GPIO_PIN_RESET);
-	
-	/* -------------- Set to Data Mode -------------- */
-	ST7789_GPIO_WritePin(ST7789_DC_GPIO_PORT, ST7789_DC_GPIO_PIN, ST7789_GPIO_PIN_SET);
-	
-	/* ---------------- Transmit Data --------------- */
-	ST7789_SPI_Transmit(&Data, 1, ST7789_SPI_TIMEOUT);
-	
-	/* ---------------- Unselect Chip --------------- */
-	ST7789_GPIO_WritePin(ST7789_CS_GPIO_PORT, ST7789_CS_GPIO_PIN, ST7789_GPIO_PIN_SET);
+/* ------------------------------ Init Table ------------------------------ */
+/*
+	Format: Command, Parameter count (| ST7789_INIT_DELAY), Parameters..., (Delay (ms))
 	
-	
-}
-
-void ST7789_TransmitData(uint8_t *Data, uint32_t Size)
-{
-	
-	uint16_t tSize;
-	
-	/* ---------------- Select Chip ----------------- */
-	ST7789_GPIO_WritePin(ST7789_CS_GPIO_PORT, ST7789_CS_GPIO_PIN, ST7789_GPIO_PIN_RESET);
-	
-	/* -------------- Set to Data Mode -------------- */
-	ST7789_GPIO_WritePin(ST7789_DC_GPIO_PORT, ST7789_DC_GPIO_PIN, ST7789_GPIO_PIN_SET);
-	
-	/* ---------------- Transmit Data --------------- */	
-	while (Size > 0)
-	{
-		
-		/* ~~~~~~~~~~~~~~~ Calculate transmit size ~~~~~~~~~~~~~~~ */
-		tSize = Size > UINT16_MAX ? UINT16_MAX : Size;
-		
-		/* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
-		#ifdef ST7789_USE_DMA
-		
-		if (ST7789_DMA_MIN_SIZE <= Size)
-		{
-			ST7789_SPI_Transmit_DMA(Data, tSize);
-			while (ST7789_SPI.State != ST7789_SPI_STATE_READY) { }
-			//while (ST7789_SPI.hdmatx->State != ST7789_DMA_STATE_READY) { }
-		}
-		else
-		{
-			ST7789_SPI_Transmit(Data, tSize, ST7789_SPI_TIMEOUT);
-		}
-		
-		#else
-		
-		ST7789_SPI_Transmit(Data, tSize, ST7789_SPI_TIMEOUT);
-		
-		#endif
-		
-		Data += tSize;
-		Size -= tSize;
-		
-	}
-	
-	/* ---------------- Unselect Chip --------------- */
-	ST7789_GPIO_WritePin(ST7789_CS_GPIO_PORT, ST7789_CS_GPIO_PIN, ST7789_GPIO_PIN_SET);
-
-}
-
-/* ......................... Initialize ........................ */
-void ST7789_Init(void)
+	The cached registers (COLMOD, MADCTL, INV) are written after the table by ST7789_WriteRegister.
+*/
+static const uint8_t ST7789_InitTable[] =
 {
 	
-	uint8_t PorchSetting_Default[5] = {0x0C, 0x0C, 0x00, 0x33, 0x33};
-	uint8_t PVGAMCTRL_Default[14] = {0xD0, 0x04, 0x0D, 0x11, 0x13, 0x2B, 0x3F, 0x54, 0x4C, 0x18, 0x0D, 0x0B, 0x1F, 0x23};
-	uint8_t NVGAMCTRL_Default[14] = {0xD0, 0x04, 0x0C, 0x11, 0x13, 0x2C, 0x3F, 0x44, 0x51, 0x2F, 0x1F, 0x1F, 0x20, 0x23};
-	
-	#ifdef ST7789_USE_DMA
-	
-	memset(LCDBuffer, 0, sizeof(LCDBuffer));
-	
-	#endif
-		
-	/* ----------------- Reset Chip ----------------- */
-	ST7789_Delay(25);
-	ST7789_GPIO_WritePin(ST7789_RST_GPIO_PORT, ST7789_RST_GPIO_PIN, ST7789_GPIO_PIN_RESET);
-	ST7789_Delay(25);
-	ST7789_GPIO_WritePin(ST7789_RST_GPIO_PORT, ST7789_RST_GPIO_PIN, ST7789_GPIO_PIN_SET);
-	ST7789_Delay(50);
-	
-	/* ---------------------------------------------- */
-	ST7789_TransmitCommand(ST7789_CMD_COLMOD); // Set Color Mode
-	ST7789_TransmitSingleData(ST7789_COLOR_MODE_16BIT);
-	
-	ST7789_TransmitCommand(ST7789_CMD_PORCTRL); // Set Porch Control
-	ST7789_TransmitData(PorchSetting_Default, 5);
-	
-	ST7789_SetRotation(ST7789_ROTATION); // Set Display Rotation
+	ST7789_CMD_SLPOUT, ST7789_INIT_DELAY | 0, ST7789_INIT_SLPOUT_DELAY, // Out of sleep mode
+	ST7789_CMD_PORCTRL, 5, 0x0C, 0x0C, 0x00, 0x33, 0x33, // Set Porch Control
 	
 	/* Internal LCD Voltage generator settings */
-	ST7789_TransmitCommand(ST7789_CMD_GCTRL); // Gate Control
-	ST7789_TransmitSingleData(ST7789_REG_DEF_GCTRL);
-	
-	ST7789_TransmitCommand(ST7789_CMD_VCOMS); // VCOM setting
-	ST7789_TransmitSingleData(ST7789_REG_DEF_VCOMS); // 0.725v (Default: 0.75v -> 0x20)
+	ST7789_CMD_GCTRL, 1, ST7789_REG_DEF_GCTRL, // Gate Control
+	ST7789_CMD_VCOMS, 1, ST7789_REG_DEF_VCOMS, // VCOM setting, 0.725v (Default: 0.75v -> 0x20)
+	ST7789_CMD_LCMCTRL, 1, ST7789_REG_DEF_LCMCTRL, // LCM Control
+	ST7789_CMD_VDVVRHEN, 1, ST7789_REG_DEF_VDVVRHEN, // VDV and VRH Command Enable
+	ST7789_CMD_VRHS, 1, ST7789_REG_DEF_VRHS, // VRH set, +-4.45v (Default: +-4.1v -> 0x0B)
+	ST7789_CMD_VDVS, 1, ST7789_REG_DEF_VDVS, // VDV set
+	ST7789_CMD_FRCTRL2, 1, ST7789_REG_DEF_FRCTRL2, // Frame Rate Control in Normal Mode, Default value (60HZ)
+	ST7789_CMD_PWCTRL1, 2, ST7789_REG_DEF_PWCTRL1H, ST7789_REG_DEF_PWCTRL1L, // Power control
 	
-	ST7789_TransmitCommand(ST7789_CMD_LCMCTRL); // LCM Control
-	ST7789_TransmitSingleData(ST7789_REG_DEF_LCMCTRL);
-	
-	ST7789_TransmitCommand(ST7789_CMD_VDVVRHEN); // VDV and VRH Command Enable
-	ST7789_TransmitSingleData(ST7789_REG_DEF_VDVVRHEN);
+	/* Division line */
+	ST7789_CMD_PVGAMCTRL, 14, 0xD0, 0x04, 0x0D, 0x11, 0x13, 0x2B, 0x3F, 0x54, 0x4C, 0x18, 0x0D, 0x0B, 0x1F, 0x23,
+	ST7789_CMD_NVGAMCTRL, 14, 0xD0, 0x04, 0x0C, 0x11, 0x13, 0x2C, 0x3F, 0x44, 0x51, 0x2F, 0x1F, 0x1F, 0x20, 0x23,
 	
-	ST7789_TransmitCommand(ST7789_CMD_VRHS); // VRH set
-	ST7789_TransmitSingleData(ST7789_REG_DEF_VRHS); // +-4.45v (Default: +-4.1v -> 0x0B)
+	ST7789_CMD_NORON, 0, // Normal Display on
 	
-	ST7789_TransmitCommand(ST7789_CMD_VDVS); // VDV set
-	ST7789_TransmitSingleData(ST7789_REG_DEF_VDVS);
+	ST7789_CMD_NOP, ST7789_INIT_END
 	
-	ST7789_TransmitCommand(ST7789_CMD_FRCTRL2); // Frame Rate Control in Normal Mode
-	ST7789_TransmitSingleData(ST7789_REG_DEF_FRCTRL2); // Default value (60HZ)
+};
+
+static const int16_t ST7789_SineTable[91] = /* sin(0 ... 90 degrees) * 16384 */
+{
 	
-	ST7789_TransmitCommand(ST7789_CMD_PWCTRL1); // Power control
-	ST7789_TransmitSingleData(ST7789_REG_DEF_PWCTRL1H);
-	ST7789_TransmitSingleData(ST7789_REG_DEF_PWCTRL1L);
+	0, 286, 572, 857, 1143, 1428, 1713, 1997, 2280, 2563, 2845, 3126, 3406, 3686, 3964,
+	4240, 4516, 4790, 5063, 5334, 5604, 5872, 6138, 6402, 6664, 6924, 7182, 7438, 7692, 7943,
+	8192, 8438, 8682, 8923, 9162, 9397, 9630, 9860, 10087, 10311, 10531, 10749, 10963, 11174, 11381,
+	11585, 11786, 11982, 12176, 12365, 12551, 12733, 12911, 13085, 13255, 13421, 13583, 13741, 13894, 14044,
+	14189, 14330, 14466, 14598, 14726, 14849, 14968, 15082, 15191, 15296, 15396, 15491, 15582, 15668, 15749,
+	15826, 15897, 15964, 16026, 16083, 16135, 16182, 16225, 16262, 16294, 16322, 16344, 16362, 16374, 16382,
+	16384
 	
-	/* Division line */
-	ST7789_TransmitCommand(ST7789_CMD_PVGAMCTRL);
-	ST7789_TransmitData(PVGAMCTRL_Default, 14);
+};
+
+/* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ G Types ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+typedef struct /* Gradient Setup */
+{
 	
-	ST7789_TransmitCommand(ST7789_CMD_NVGAMCTRL);
-	ST7789_TransmitData(NVGAMCTRL_Default, 14);
+	uint8_t  Mode;
+	uint8_t  Dither;
 	
-	ST7789_TransmitCommand(ST7789_CMD_INVON); // Inversion ON
-	ST7789_TransmitCommand(ST7789_CMD_SLPOUT); // Out of sleep mode
-	ST7789_TransmitCommand(ST7789_CMD_NORON); // Normal Display on
-	ST7789_TransmitCommand(ST7789_CMD_DISPON); // Main screen turned on
+	int32_t  Channel[3]; // Red, green and blue of Color1 (8-bit, 8.8 fixed point)
+	int32_t  Delta[3];   // Color2 - Color1 (8-bit)
 	
-	ST7789_Delay(50);
-	ST7789_FillScreen(ST7789_COLOR_BLACK); // Fill with Black.
+	int32_t  X1;         // Start point (Radial: Center)
+	int32_t  Y1;
+	int32_t  DX;         // Direction to Color2
+	int32_t  DY;
+	int32_t  Length2;    // DX^2 + DY^2
+	uint32_t Radius;
 	
-}
-
-/* .......................... Control .......................... */
-void ST7789_SetRotation(uint8_t Rotation)
+}ST7789_GradientSetupTypeDef;
+
+typedef struct /* Arc Setup */
 {
 	
-	ST7789_TransmitCommand(ST7789_CMD_MADCTL);
-	
-	switch (Rotation)
-	{
-		case 0:
-		ST7789_TransmitSingleData(ST7789_REG_DEF_MADCTL_MX | ST7789_REG_DEF_MADCTL_MY | ST7789_REG_DEF_MADCTL_RGB);
-		break;
-		case 1:
-		ST7789_TransmitSingleData(ST7789_REG_DEF_MADCTL_MY | ST7789_REG_DEF_MADCTL_MV | ST7789_REG_DEF_MADCTL_RGB);
-		break;
-		case 2:
-		ST7789_TransmitSingleData(ST7789_REG_DEF_MADCTL_RGB);
-		break;
-		case 3:
-		ST7789_TransmitSingleData(ST7789_REG_DEF_MADCTL_MX | ST7789_REG_DEF_MADCTL_MV | ST7789_REG_DEF_MADCTL_RGB);
-		break;
-		default:
-		break;
-	}
+	int32_t StartCos; // Direction of the start angle (Q14)
+	int32_t StartSin;
+	int32_t EndCos;   // Direction of the end angle (Q14)
+	int32_t EndSin;
+	uint8_t Wide;     // Sweep over 180 degrees
+	uint8_t Full;     // Full ring
 	
-}
+}ST7789_ArcSetupTypeDef;
 
-void ST7789_SetWindowAddress(uint16_t XStart, uint16_t YStart, uint16_t XEnd, uint16_t YEnd)
+/* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ Function ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+static void ST7789_CleanCache(const void *Data, uint32_t Size)
 {
 	
-	XStart = XStart + ST7789_XS;
-	XEnd   = XEnd + ST7789_XS;
-	
-	uint8_t ColumnAddress[4] = {XStart >> 8, XStart & 0xFF, XEnd >> 8, XEnd & 0xFF};
+	#ifdef ST7789_CACHE_CLEAN
 	
-	YStart = YStart + ST7789_YS;
-	YEnd   = YEnd + ST7789_YS;
+	/* DMA reads the memory, so the data in the D-cache is written back first (whole lines) */
+	uintptr_t start = (uintptr_t)Data & ~(uintptr_t)(ST7789_CACHE_LINE - 1);
+	uintptr_t end   = ((uintptr_t)Data + Size + ST7789_CACHE_LINE - 1) & ~(uintptr_t)(ST7789_CACHE_LINE - 1);
 	
-	uint8_t RowAddress[4] = {YStart >> 8, YStart & 0xFF, YEnd >> 8, YEnd & 0xFF};
+	ST7789_CACHE_CLEAN(start, (uint32_t)(end - start));
 	
-	/* ------------- Set Column Address ------------- */
-	ST7789_TransmitCommand(ST7789_CMD_CASET);
-	ST7789_TransmitData(ColumnAddress, sizeof(ColumnAddress));
+	#else
 	
-	/* -------------- Set Row Address --------------- */
-	ST7789_TransmitCommand(ST7789_CMD_RASET);
-	ST7789_TransmitData(RowAddress, sizeof(RowAddress));
+	(void)Data;
+	(void)Size;
 	
-	/* ------------- Write Param to RAM ------------- */
-	ST7789_TransmitCommand(ST7789_CMD_RAMWR);
+	#endif
 	
 }
-
-void ST7789_InvertColors(ST7789_InvTypeDef Invert)
-{
-	
-	/* -------------- Transmit Command -------------- */
-	ST7789_TransmitCommand(Invert ? ST7789_INVERT_ON : ST7789_INVERT_OFF);
-	
-}
-
-void ST7789_TearEffect(ST7789_ColorModeTypeDef Tear)
-{
-	
-	/* -------------- Transmit Command -------------- */
-	ST7789_TransmitCommand(Tear ? ST7789_TEAR_ON : ST7789_TEAR_OFF);
-	
-}
-
-/* ...................... Color Converting ..................... */
-ST7789_ColorTypeDef ST7789_Color_GetFromRGB(uint8_t R, uint8_t G, uint8_t B)
+
+static void ST7789_TransmitCommand(ST7789_HandleTypeDef *hlcd, ST7789_CMDTypeDef CMD)
 {
 	
-	/* -------------- Convert to RGB565 ------------- */
-	/*
-		RGB888 bit Format: RRRRRRRRGGGGGGGGBBBBBBBB
-		RGB565 bit Format: RRRRRGGGGGGBBBBB
-	*/
-	uint16_t rgb565 = (((uint16_t)R & 0xF8) << 8)|(((uint16_t)G & 0xFC) << 3)|((uint16_t)B >> 3);
-	
-	return rgb565;
-	
+	ST7789_Disp_WaitForTransfer(hlcd);
+	
+	/* --------------- Transmit Command ------------- */
+	hlcd->Bus->WriteCommand(hlcd, (uint8_t)CMD);
+	hlcd->Bus->End(hlcd);
+	
 }
 
-ST7789_ColorTypeDef ST7789_Color_GetFromHex(uint32_t HexCode)
+static void ST7789_TransmitData(ST7789_HandleTypeDef *hlcd, uint8_t *Data, uint32_t Size)
 {
 	
-	/* -------------- Convert to RGB565 ------------- */
-	/*
-		RGB888 bit Format: RRRRRRRRGGGGGGGGBBBBBBBB
-		RGB565 bit Format: RRRRRGGGGGGBBBBB
-	*/
-	uint16_t rgb565 = (((HexCode & 0xF80000) >> 8) + ((HexCode & 0xFC00) >> 5) + ((HexCode & 0xF8) >> 3));
-	
-	return rgb565;
-	
-}
-
-/* ........................... Fill ............................ */
-void ST7789_Fill(uint16_t XStart, uint16_t YStart, uint16_t XEnd, uint16_t YEnd, ST7789_ColorTypeDef Color)
-{
+	ST7789_Disp_WaitForTransfer(hlcd);
 	
-	uint8_t colorBuff[2] = {Color >> 8, Color & 0xFF};
-	
-	uint16_t YCounter;
-	uint16_t XCounter;
-	
-	/* ---------------- Size Control ---------------- */
-	if ((XEnd < 0) || (XEnd >= ST7789_WIDTH_MODIFIED) || (YEnd < 0) || (YEnd >= ST7789_HEIGHT_MODIFIED))
+	/* Shorter data is written by the CPU */
+	if (ST7789_DMA_MIN_SIZE <= Size)
 	{
-		return;
+		ST7789_CleanCache(Data, Size);
 	}
 	
-	ST7789_SetWindowAddress(XStart, YStart, XEnd, YEnd);
-	
-	/* --------------- Write to Pixels -------------- */
-	for (YCounter = YStart; YCounter <= YEnd; YCounter++)
-	{
-		for (XCounter = XStart; XCounter <= XEnd; XCounter++)
-		{
-			ST7789_TransmitData(colorBuff, sizeof(colorBuff));
-		}
+	/* ---------------- Transmit Data --------------- */
+	if ((hlcd->Bus->WriteBulkAsync != NULL) && (ST7789_DMA_MIN_SIZE <= Size))
+	{
+		
+		/* The transfer runs in the background, the LCD is released by ST7789_Disp_WaitForTransfer */
+		hlcd->TxBusy = 1;
+		hlcd->TxSize = 0;
+		hlcd->Bus->WriteBulkAsync(hlcd, Data, Size);
+		
 	}
+	else
+	{
+		
+		hlcd->Bus->WriteBulk(hlcd, Data, Size);
+		hlcd->Bus->End(hlcd);
+		
+	}
 	
 }
-
-void ST7789_FillScreen(ST7789_ColorTypeDef Color)
+
+static ST7789_StatusTypeDef ST7789_TransmitRepeat(ST7789_HandleTypeDef *hlcd, uint16_t Color, uint32_t Count)
 {
 	
-	uint16_t widthCounter;
-
-	#ifndef ST7789_USE_DMA
-	uint16_t heightCounter;
-	#endif
-
-	uint16_t packetSize = ST7789_HEIGHT_MODIFIED / ST7789_HOR_LEN;
+	/* Short fills are cheaper as data than switching the bus to the repeat mode and back */
+	if ((hlcd->Bus->WriteRepeat == NULL) || (Count < ST7789_DMA_MIN_SIZE))
+	{
+		return ST7789_ERROR;
+	}
 	
-	#ifdef ST7789_USE_DMA
-
-	uint32_t colorCounter;
-	uint16_t newColor = (Color & 0xFF) << 8|(Color >> 8);
-
-	#else
-	uint8_t colorBuff[2] = {Color >> 8, Color & 0xFF};
-	#endif
+	ST7789_Disp_WaitForTransfer(hlcd);
 	
-	ST7789_SetWindowAddress(0, 0, ST7789_WIDTH_MODIFIED - 1, ST7789_HEIGHT_MODIFIED - 1);
+	/* The pixel must stay valid until the transfer is completed */
+	hlcd->RepeatPixel = Color;
+	ST7789_CleanCache(&hlcd->RepeatPixel, sizeof(hlcd->RepeatPixel));
 	
-	/* ------------- Transmit LCD Buffer ------------ */
-	#ifdef ST7789_USE_DMA
+	/* ------------- Repeat Single Pixel ------------ */
+	hlcd->TxBusy = 1;
+	hlcd->Bus->WriteRepeat(hlcd, &hlcd->RepeatPixel, Count);
 	
-	for (colorCounter = 0; colorCounter < (sizeof(LCDBuffer) / 2); colorCounter++)
-	{
-		LCDBuffer[colorCounter] = newColor;
-	}
+	return ST7789_OK;
 	
-	for (widthCounter = 0; widthCounter < packetSize; widthCounter++)
-	{
-		ST7789_TransmitData((uint8_t *)LCDBuffer, sizeof(LCDBuffer));
-	}
+}
 
-	#else
+static void ST7789_TransmitCommandData(ST7789_HandleTypeDef *hlcd, ST7789_CMDTypeDef CMD, const uint8_t *Data, uint8_t Size)
+{
+	
+	ST7789_Disp_WaitForTransfer(hlcd);
 	
-	for (widthCounter = 0; widthCounter < ST7789_WIDTH_MODIFIED; widthCounter++)
+	/* --------------- Transmit Command ------------- */
+	hlcd->Bus->WriteCommand(hlcd, (uint8_t)CMD);
+	
+	/* ------------ Transmit Parameters ------------- */
+	if (Size > 0)
 	{
-		for (heightCounter = 0; heightCounter < ST7789_HEIGHT_MODIFIED; heightCounter++)
-		{
-			ST7789_TransmitData(colorBuff, sizeof(colorBuff));
-		}
+		hlcd->Bus->WriteData(hlcd, Data, Size);
 	}
 	
-	#endif
+	hlcd->Bus->End(hlcd);
 	
-}
-
-/* .......................... Drawing .......................... */
-void ST7789_DrawPixel(uint16_t XPos, uint16_t YPos, ST7789_ColorTypeDef Color)
+}
+
+static void ST7789_WriteRegister(ST7789_HandleTypeDef *hlcd, ST7789_RegTypeDef Reg, ST7789_CMDTypeDef CMD, uint8_t *Data, uint8_t Size)
 {
 	
-	uint8_t colorBuff[2] = {Color >> 8, Color & 0xFF};
+	#ifdef ST7789_USE_REG_CACHE
 	
-	/* ---------------- Size Control ---------------- */
-	if ((XPos < 0) || (XPos >= ST7789_WIDTH_MODIFIED) || (YPos < 0) || (YPos >= ST7789_HEIGHT_MODIFIED))
+	uint8_t byteCounter;
+	uint8_t changed = !(hlcd->RegCache.Valid & (1U << Reg)) || (hlcd->RegCache.Command[Reg] != CMD);
+	
+	/* ------------- Compare with the LCD ----------- */
+	for (byteCounter = 0; byteCounter < Size; byteCounter++)
+	{
+		changed |= (hlcd->RegCache.Value[Reg][byteCounter] != Data[byteCounter]);
+		hlcd->RegCache.Value[Reg][byteCounter] = Data[byteCounter];
+	}
+	
+	if (!changed)
 	{
+		hlcd->RegCache.Stats.Skipped[Reg]++;
 		return;
 	}
 	
-	ST7789_SetWindowAddress(XPos, YPos, XPos, YPos);
+	hlcd->RegCache.Command[Reg] = CMD;
+	hlcd->RegCache.Valid       |= (1U << Reg);
 	
-	/* ---------------- Write Pixel ----------------- */
-	ST7789_TransmitData(colorBuff, sizeof(colorBuff));
+	#endif
 	
-}
-
-void ST7789_DrawPixel_4px(uint16_t XPos, uint16_t YPos, ST7789_ColorTypeDef Color)
+	hlcd->RegCache.Stats.Written[Reg]++;
+	
+	/* --------------- Write Register --------------- */
+	ST7789_TransmitCommandData(hlcd, CMD, Data, Size);
+	
+}
+
+static void ST7789_SetScrollArea(ST7789_HandleTypeDef *hlcd, uint16_t TopFixed, uint16_t ScrollArea, uint16_t BottomFixed)
 {
 	
-	/* ---------------- Size Control ---------------- */
-	if ((XPos <= 0) || (XPos > ST7789_WIDTH_MODIFIED) || (YPos <= 0) || (YPos > ST7789_HEIGHT_MODIFIED))
-	{
-		return;
-	}
+	uint8_t scrollDef[6] = {TopFixed >> 8, TopFixed & 0xFF, ScrollArea >> 8, ScrollArea & 0xFF, BottomFixed >> 8, BottomFixed & 0xFF};
 	
-	/* ---------------- Write Pixel ----------------- */
-	ST7789_Fill(XPos - 1, YPos - 1, XPos + 1, YPos + 1, Color);
+	/* ------------ Set Scrolling Area -------------- */
+	ST7789_TransmitCommand(hlcd, ST7789_CMD_VSCRDEF);
+	ST7789_TransmitData(hlcd, scrollDef, sizeof(scrollDef));
 	
-}
+}
 
-void ST7789_DrawLine(uint16_t XStart, uint16_t YStart, uint16_t XEnd, uint16_t YEnd, ST7789_ColorTypeDef Color)
+static void ST7789_SetScrollStart(ST7789_HandleTypeDef *hlcd, uint16_t Line)
 {
 	
-	uint16_t Swap;
-	uint8_t  Steep = abs(YEnd - YStart) > abs(XEnd - XStart);
+	uint8_t scrollStart[2] = {Line >> 8, Line & 0xFF};
 	
-	int16_t xDif;
-	int16_t yDif;
-	int16_t err;
-	int16_t yStep;
+	/* ------------ Set Scroll Start Line ----------- */
+	ST7789_TransmitCommand(hlcd, ST7789_CMD_VSCSAD);
+	ST7789_TransmitData(hlcd, scrollStart, sizeof(scrollStart));
 	
-	/* ------------------ Swap XY ------------------- */
-	if (Steep)
+}
+
+/* ........................... Transfer ........................ */
+void ST7789_Disp_WaitForTransfer(ST7789_HandleTypeDef *hlcd)
+{
+	
+	/* Every packet of a long transfer */
+	while (hlcd->TxBusy)
 	{
 		
-		Swap   = XStart;
-		XStart = YStart;
-		YStart = Swap;
+		#ifdef ST7789_USE_OS
 		
-		Swap   = XEnd;
-		XEnd   = YEnd;
-		YEnd   = Swap;
+		/* Block until the TX complete callback, the bus is polled again after a timeout (no callback) */
+		while (hlcd->TxBusy && hlcd->Bus->IsBusy(hlcd))
+		{
+			ST7789_OS_TxWait(&hlcd->OS, ST7789_OS_TX_TIMEOUT);
+		}
 		
-	}
-	
-	/* -------------- Swap XStart/XEnd -------------- */
-	if (XStart > XEnd)
-	{
+		#else
 		
-		Swap   = XStart;
-		XStart = XEnd;
-		XEnd   = Swap;
+		while (hlcd->Bus->IsBusy(hlcd)) { }
 		
-		Swap   = YStart;
-		YStart = YEnd;
-		YEnd   = Swap;
+		#endif
+		
+		ST7789_Disp_TxCpltCallback(hlcd);
 		
 	}
 	
-	/* ------------ Calculate Line Length ----------- */
-	xDif = XEnd - XStart;
-	yDif = abs(YEnd - YStart);
-	
-	err = xDif / 2;
+}
+
+void ST7789_Disp_TxCpltCallback(ST7789_HandleTypeDef *hlcd)
+{
 	
-	/* ------------- Modify Y Direction ------------- */
-	if (YStart < YEnd)
+	if (!hlcd->TxBusy)
 	{
-		yStep = 1;
-	}
-	else
-	{
-		yStep = -1;
+		return;
 	}
 	
-	/* ----------------- Draw Line ------------------ */
-	for (; XStart <= XEnd; XStart++)
+	/* ------------- Next Packet of the Data -------- */
+	if (hlcd->TxSize > 0)
 	{
 		
-		if (Steep)
-		{
-			ST7789_DrawPixel(YStart, XStart, Color);
-		}
-		else
+		/* The interrupt has already started it */
+		if (hlcd->Bus->IsBusy(hlcd))
 		{
-			ST7789_DrawPixel(XStart, YStart, Color);
+			return;
 		}
 		
-		err -= yDif;
-		
-		if (err < 0)
-		{
-			YStart += yStep;
-			err    += xDif;
-		}
+		hlcd->Bus->WriteBulkAsync(hlcd, hlcd->TxData, hlcd->TxSize);
+		return;
 		
 	}
 	
-}
-
-void ST7789_DrawRectangle(uint16_t XStart, uint16_t YStart, uint16_t XEnd, uint16_t YEnd, ST7789_ColorTypeDef Color)
-{
+	hlcd->TxBusy = 0;
 	
-	/* ------------ Write Rectangle Lines ----------- */
-	ST7789_DrawLine(XStart, YStart, XEnd, YStart, Color);
-	ST7789_DrawLine(XStart, YStart, XStart, YEnd, Color);
-	ST7789_DrawLine(XStart, YEnd, XEnd, YEnd, Color);
-	ST7789_DrawLine(XEnd, YStart, XEnd, YEnd, Color);
+	/* ----------------- Release LCD ---------------- */
+	hlcd->Bus->End(hlcd);
+	
+	/* Wake the task in ST7789_Disp_WaitForTransfer */
+	ST7789_OS_TX_SIGNAL(hlcd);
+	
+	if (hlcd->TxCpltHook != NULL)
+	{
+		hlcd->TxCpltHook(hlcd);
+	}
 	
 }
 
-void ST7789_DrawFilledRectangle(uint16_t XPos, uint16_t YPos, uint16_t Width, uint16_t Height, ST7789_ColorTypeDef Color)
+/* .......................... Memory ........................... */
+ST7789_StatusTypeDef ST7789_Disp_AddMemory(ST7789_HandleTypeDef *hlcd, void *Memory, uint32_t Size, ST7789_MemTypeDef Type)
 {
 	
-	uint8_t heightCounter;
+	uint8_t *spare;
+	uint32_t spareSize;
+	uint32_t align = (ST7789_MEM_ALIGN - ((uintptr_t)Memory & (ST7789_MEM_ALIGN - 1))) & (ST7789_MEM_ALIGN - 1);
 	
-	/* -------------- Position Control -------------- */
-	if (XPos >= ST7789_WIDTH_MODIFIED || YPos >= ST7789_HEIGHT_MODIFIED)
+	/* ------ Align to Word (Cache Line with D-cache) ----- */
+	if ((Memory == NULL) || (Size < (align + ST7789_MEM_ALIGN)))
 	{
-		return;
+		return ST7789_ERROR;
 	}
 	
-	/* ---------------- Size Control ---------------- */
-	if ((XPos + Width) >= ST7789_WIDTH_MODIFIED)
+	Memory = (uint8_t *)Memory + align;
+	Size   = (Size - align) & ~(uint32_t)(ST7789_MEM_ALIGN - 1);
+	
+	#ifndef ST7789_USE_DMA
+	
+	/* Transfers are blocking, every region can be the buffer */
+	Type = ST7789_MEM_DMA;
+	
+	#endif
+	
+	ST7789_OS_LOCK(hlcd);
+	
+	/* The buffers may be sent by the last transfer */
+	ST7789_Disp_WaitForTransfer(hlcd);
+	
+	/* -------- Largest DMA region is the buffer ------ */
+	if ((Type == ST7789_MEM_DMA) && ((Size / sizeof(uint16_t)) > hlcd->BufferLength))
 	{
-		Width = ST7789_WIDTH_MODIFIED - XPos;
+		
+		spare     = (uint8_t *)hlcd->Buffer;
+		spareSize = hlcd->BufferLength * sizeof(uint16_t);
+		
+		hlcd->Buffer       = (uint16_t *)Memory;
+		hlcd->BufferLength = Size / sizeof(uint16_t);
+		
 	}
-	
-	if ((YPos + Height) >= ST7789_HEIGHT_MODIFIED)
+	else
 	{
-		Height = ST7789_HEIGHT_MODIFIED - YPos;
+		
+		spare     = (uint8_t *)Memory;
+		spareSize = Size;
+		
 	}
 	
-	/* ----------------- Draw Lines ----------------- */
-	for (heightCounter = 0; heightCounter <= Height; heightCounter++)
+	/* ------------ The next one is scratch ---------- */
+	if (spareSize > hlcd->ScratchSize)
 	{
-		ST7789_DrawLine(XPos, YPos + heightCounter, XPos + Width, YPos + heightCounter, Color);
+		
+		hlcd->Scratch     = spare;
+		hlcd->ScratchSize = spareSize;
+		
+	}
+	else if (spare == (uint8_t *)Memory)
+	{
+		
+		ST7789_OS_UNLOCK(hlcd);
+		return ST7789_ERROR;
+		
 	}
 	
+	ST7789_OS_UNLOCK(hlcd);
+	
+	return ST7789_OK;
+	
 }
 
-void ST7789_DrawCircle(uint16_t XPos, uint16_t YPos, uint8_t Radius, ST7789_ColorTypeDef Color)
+/* ............................ OS ............................. */
+void ST7789_Disp_GetLockStats(ST7789_HandleTypeDef *hlcd, ST7789_OSStatsTypeDef *Stats)
 {
 	
-	int16_t f = 1 - Radius;
-	int16_t ddF_x = 1;
-	int16_t ddF_y = -2 * Radius;
-	int16_t x = 0;
-	int16_t y = Radius;
+	ST7789_OS_LOCK(hlcd);
+	*Stats = hlcd->OS.Stats;
+	ST7789_OS_UNLOCK(hlcd);
 	
-	/* ------------ Write Circle Pixels ------------- */
-	ST7789_DrawPixel(XPos, YPos + Radius, Color);
-	ST7789_DrawPixel(XPos, YPos - Radius, Color);
-	ST7789_DrawPixel(XPos + Radius, YPos, Color);
-	ST7789_DrawPixel(XPos - Radius, YPos, Color);
+}
+
+/* ......................... Initialize ........................ */
+void ST7789_Disp_Init(ST7789_HandleTypeDef *hlcd)
+{
+	ST7789_Disp_Init_FirstFrame(hlcd, NULL);
+}
+
+void ST7789_Disp_Init_FirstFrame(ST7789_HandleTypeDef *hlcd, ST7789_FirstFrameTypeDef Draw)
+{
 	
-	while (x < y)
+	const uint8_t *initTable = ST7789_InitTable;
+	uint8_t cmd;
+	uint8_t paramCount;
+	uint8_t colorMode = ST7789_COLOR_MODE_16BIT;
+	
+	ST7789_OS_LOCK(hlcd);
+	
+	hlcd->TxBusy = 0;
+	hlcd->TxSize = 0;
+	
+	if (hlcd->Bus == NULL)
+	{
+		hlcd->Bus = &ST7789_Bus_SPI;
+	}
+	
+	/* ----------------- Reset Chip ----------------- */
+	ST7789_Delay(ST7789_INIT_POWER_DELAY);
+	
+	if (hlcd->RSTPort != NULL)
 	{
 		
-		if (f >= 0)
-		{
-			y--;
-			ddF_y += 2;
-			f += ddF_y;
-		}
-		
-		x++;
-		ddF_x += 2;
-		f += ddF_x;
-
-		ST7789_DrawPixel(XPos + x, YPos + y, Color);
-		ST7789_DrawPixel(XPos - x, YPos + y, Color);
-		ST7789_DrawPixel(XPos + x, YPos - y, Color);
-		ST7789_DrawPixel(XPos - x, YPos - y, Color);
-
-		ST7789_DrawPixel(XPos + y, YPos + x, Color);
-		ST7789_DrawPixel(XPos - y, YPos + x, Color);
-		ST7789_DrawPixel(XPos + y, YPos - x, Color);
-		ST7789_DrawPixel(XPos - y, YPos - x, Color);
+		ST7789_GPIO_WritePin(ST7789_GPIO_PORT(hlcd->RSTPort), hlcd->RSTPin, ST7789_GPIO_PIN_RESET);
+		ST7789_Delay(ST7789_INIT_RESET_DELAY);
+		ST7789_GPIO_WritePin(ST7789_GPIO_PORT(hlcd->RSTPort), hlcd->RSTPin, ST7789_GPIO_PIN_SET);
 		
 	}
+	else
+	{
+		ST7789_TransmitCommand(hlcd, ST7789_CMD_SWRESET);
+	}
 	
-}
-
-void ST7789_DrawFilledCircle(int16_t XPos, int16_t YPos, int16_t Radius, ST7789_ColorTypeDef Color)
-{
+	ST7789_Delay(ST7789_INIT_READY_DELAY);
 	
-	int16_t f = 1 - Radius;
-	int16_t ddF_x = 1;
-	int16_t ddF_y = -2 * Radius;
-	int16_t x = 0;
-	int16_t y = Radius;
+	/* Registers are reset */
+	ST7789_Disp_RegCache_Invalidate(hlcd);
 	
-	/* ------------ Write Circle Pixels ------------- */
-	ST7789_DrawPixel(XPos, YPos + Radius, Color);
-	ST7789_DrawPixel(XPos, YPos - Radius, Color);
-	ST7789_DrawPixel(XPos + Radius, YPos, Color);
-	ST7789_DrawPixel(XPos - Radius, YPos, Color);
-	ST7789_DrawLine(XPos - Radius, YPos, XPos + Radius, YPos, Color);
+	hlcd->Staging.Enabled = 0;
+	hlcd->Staging.Active  = 0;
+	hlcd->Staging.Shown   = 0;
+	hlcd->Scroll.Enabled  = 0;
+	hlcd->Scroll.Start    = 0;
 	
-	while (x < y)
+	/* ------------- Write Init Table --------------- */
+	while (initTable[1] != ST7789_INIT_END)
 	{
+		
+		cmd        = initTable[0];
+		paramCount = initTable[1] & ~ST7789_INIT_DELAY;
 		
-		if (f >= 0)
+		ST7789_TransmitCommandData(hlcd, (ST7789_CMDTypeDef)cmd, &initTable[2], paramCount);
+		
+		if (initTable[1] & ST7789_INIT_DELAY)
 		{
-			y--;
-			ddF_y += 2;
-			f += ddF_y;
+			ST7789_Delay(initTable[2 + paramCount]);
+			initTable++;
 		}
 		
-		x++;
-		ddF_x += 2;
-		f += ddF_x;
+		initTable += 2 + paramCount;
 		
-		ST7789_DrawLine(XPos - x, YPos + y, XPos + x, YPos + y, Color);
-		ST7789_DrawLine(XPos + x, YPos - y, XPos - x, YPos - y, Color);
+	}
+	
+	ST7789_WriteRegister(hlcd, ST7789_REG_COLMOD, ST7789_CMD_COLMOD, &colorMode, 1); // Set Color Mode
+	ST7789_Disp_SetRotation(hlcd, hlcd->Rotation); // Set Display Rotation
+	ST7789_Disp_InvertColors(hlcd, ST7789_INVERT_ON); // Inversion ON
+	
+	/* ------ First Frame (Before Display ON) ------- */
+	if (Draw != NULL)
+	{
+		Draw();
+	}
+	else
+	{
 		
-		ST7789_DrawLine(XPos + y, YPos + x, XPos - y, YPos + x, Color);
-		ST7789_DrawLine(XPos + y, YPos - x, XPos - y, YPos - x, Color);
+		#ifdef ST7789_INIT_CLEAR_COLOR
+		ST7789_Disp_FillScreen(hlcd, ST7789_INIT_CLEAR_COLOR);
+		#endif
 		
 	}
 	
-}
-
-void ST7789_DrawTriangle(uint16_t X1, uint16_t Y1, uint16_t X2, uint16_t Y2, uint16_t X3, uint16_t Y3, ST7789_ColorTypeDef Color)
-{
+	ST7789_TransmitCommand(hlcd, ST7789_CMD_DISPON); // Main screen turned on
 	
-	/* ----------------- Draw Lines ----------------- */
-	ST7789_DrawLine(X1, Y1, X2, Y2, Color);
-	ST7789_DrawLine(X2, Y2, X3, Y3, Color);
-	ST7789_DrawLine(X3, Y3, X1, Y1, Color);
+	ST7789_OS_UNLOCK(hlcd);
 	
 }
-
-void ST7789_DrawFilledTriangle(uint16_t X1, uint16_t Y1, uint16_t X2, uint16_t Y2, uint16_t X3, uint16_t Y3, ST7789_ColorTypeDef Color)
+
+/* .......................... Control .......................... */
+void ST7789_Disp_SetRotation(ST7789_HandleTypeDef *hlcd, uint8_t Rotation)
 {
 	
-	int16_t deltaX    = abs(X2 - X1);
-	int16_t deltaY    = abs(Y2 - Y1);
-	int16_t xUpdate1  = 0, xUpdate2 = 0;
-	int16_t yUpdate1  = 0, yUpdate2 = 0;
-	int16_t deltaNum  = 0, num = 0, numToAdd = 0;
-	int16_t numPixels = 0, pixelCounter = 0;
+	uint8_t madctl;
 	
-	/* ----------------- Draw Lines ----------------- */
-	if (X2 >= X1)
-	{
-		xUpdate1 = 1;
-		xUpdate2 = 1;
-	}
-	else
-	{
-		xUpdate1 = -1;
-		xUpdate2 = -1;
-	}
-
-	if (Y2 >= Y1)
-	{
-		yUpdate1 = 1;
-		yUpdate2 = 1;
-	}
-	else
+	switch (Rotation)
 	{
-		yUpdate1 = -1;
-		yUpdate2 = -1;
+		case 0:
+		madctl = ST7789_REG_DEF_MADCTL_MX | ST7789_REG_DEF_MADCTL_MY | ST7789_REG_DEF_MADCTL_RGB;
+		break;
+		case 1:
+		madctl = ST7789_REG_DEF_MADCTL_MY | ST7789_REG_DEF_MADCTL_MV | ST7789_REG_DEF_MADCTL_RGB;
+		break;
+		case 2:
+		madctl = ST7789_REG_DEF_MADCTL_RGB;
+		break;
+		case 3:
+		madctl = ST7789_REG_DEF_MADCTL_MX | ST7789_REG_DEF_MADCTL_MV | ST7789_REG_DEF_MADCTL_RGB;
+		break;
+		default:
+		return;
 	}
-
-	if (deltaX >= deltaY)
+	
+	ST7789_OS_LOCK(hlcd);
+	
+	/* Staging rows and scrolled columns depend on the rotation */
+	ST7789_Disp_Staging_Disable(hlcd);
+	ST7789_Disp_Scroll_Disable(hlcd);
+	
+	/* ---------- Frame Memory Position ------------- */
+	hlcd->Rotation = Rotation;
+	
+	if ((Rotation == 0) || (Rotation == 2))
 	{
-		xUpdate1  = 0;
-		yUpdate2  = 0;
-		deltaNum  = deltaX;
-		num       = deltaX / 2;
-		numToAdd  = deltaY;
-		numPixels = deltaX;
+		
+		hlcd->Width   = hlcd->PanelWidth;
+		hlcd->Height  = hlcd->PanelHeight;
+		
+		hlcd->XOffset = (ST7789_WIDTH_MAX - hlcd->Width) / 2;
+		hlcd->YOffset = (ST7789_HEIGHT_MAX - hlcd->Height) / 2;
+		
 	}
 	else
 	{
-		xUpdate2  = 0;
-		yUpdate1  = 0;
-		deltaNum  = deltaY;
-		num       = deltaY / 2;
-		numToAdd  = deltaX;
-		numPixels = deltaY;
+		
+		hlcd->Width   = hlcd->PanelHeight;
+		hlcd->Height  = hlcd->PanelWidth;
+		
+		hlcd->XOffset = (ST7789_HEIGHT_MAX - hlcd->Width) / 2;
+		hlcd->YOffset = (ST7789_WIDTH_MAX - hlcd->Height) / 2;
+		
 	}
+	
+	ST7789_WriteRegister(hlcd, ST7789_REG_MADCTL, ST7789_CMD_MADCTL, &madctl, 1);
+	
+	ST7789_OS_UNLOCK(hlcd);
+	
+}
 
-	for (pixelCounter = 0; pixelCounter <= numPixels; pixelCounter++)
+static void ST7789_SetAddress(ST7789_HandleTypeDef *hlcd, uint16_t XStart, uint16_t YStart, uint16_t XEnd, uint16_t YEnd)
+{
+	
+	/* ------ Redirect Strip to the Shown/Hidden Rows ------ */
+	if (hlcd->Staging.Enabled && (YStart >= hlcd->Staging.YStart) && (YEnd < (hlcd->Staging.YStart + hlcd->Staging.Height)))
 	{
 		
-		ST7789_DrawLine(X1, Y1, X3, Y3, Color);
-
-		num += numToAdd;
-		
-		if (num >= deltaNum)
+		if (hlcd->Staging.Shown ^ hlcd->Staging.Active)
 		{
-			num -= deltaNum;
-			X1  += xUpdate1;
-			Y1  += yUpdate1;
+			YStart = YStart + hlcd->Staging.Offset;
+			YEnd   = YEnd + hlcd->Staging.Offset;
 		}
 		
-		X1 += xUpdate2;
-		Y1 += yUpdate2;
-		
 	}
 	
-}
-
-/* ........................... Image ........................... */
-void ST7789_PutImage(uint16_t XPos, uint16_t YPos, uint16_t Width, uint16_t Height, const uint16_t *Image)
+	XStart = XStart + hlcd->XOffset;
+	XEnd   = XEnd + hlcd->XOffset;
+	
+	uint8_t ColumnAddress[4] = {XStart >> 8, XStart & 0xFF, XEnd >> 8, XEnd & 0xFF};
+	
+	YStart = YStart + hlcd->YOffset;
+	YEnd   = YEnd + hlcd->YOffset;
+	
+	uint8_t RowAddress[4] = {YStart >> 8, YStart & 0xFF, YEnd >> 8, YEnd & 0xFF};
+	
+	/* ------------- Set Column Address ------------- */
+	ST7789_WriteRegister(hlcd, ST7789_REG_CASET, ST7789_CMD_CASET, ColumnAddress, sizeof(ColumnAddress));
+	
+	/* -------------- Set Row Address --------------- */
+	ST7789_WriteRegister(hlcd, ST7789_REG_RASET, ST7789_CMD_RASET, RowAddress, sizeof(RowAddress));
+	
+}
+
+void ST7789_Disp_SetWindowAddress(ST7789_HandleTypeDef *hlcd, uint16_t XStart, uint16_t YStart, uint16_t XEnd, uint16_t YEnd)
 {
 	
-	if ((XPos >= ST7789_WIDTH_MODIFIED) || (YPos >= ST7789_HEIGHT_MODIFIED))
-	return;
+	ST7789_OS_LOCK(hlcd);
 	
-	if ((XPos + Width - 1) >= ST7789_WIDTH_MODIFIED)
-	return;
+	ST7789_SetAddress(hlcd, XStart, YStart, XEnd, YEnd);
 	
-	if ((YPos + Height - 1) >= ST7789_HEIGHT_MODIFIED)
-	return;
+	/* ------------- Write Param to RAM ------------- */
+	ST7789_TransmitCommand(hlcd, ST7789_CMD_RAMWR);
 	
-	/* -------------- Write Image Data -------------- */
-	ST7789_SetWindowAddress(XPos, YPos, XPos + Width - 1, YPos + Height - 1);
-	ST7789_TransmitData((uint8_t *)Image, sizeof(uint16_t) * Width * Height);
+	ST7789_OS_UNLOCK(hlcd);
 	
 }
 
-/* ........................... Text ............................ */
-void ST7789_PutChar(uint16_t XPos, uint16_t YPos, char Ch, ST7789_FontTypeDef Font, ST7789_ColorTypeDef Color, ST7789_ColorTypeDef BackgroundColor)
+void ST7789_Disp_InvertColors(ST7789_HandleTypeDef *hlcd, ST7789_InvTypeDef Invert)
 {
 	
-	uint32_t heightCounter;
-	uint32_t widthCounter;
-	uint32_t fontByte;
+	ST7789_OS_LOCK(hlcd);
 	
-	uint8_t colorBuff[2]   = {Color >> 8, Color & 0xFF};
-	uint8_t bgColorBuff[2] = {BackgroundColor >> 8, BackgroundColor & 0xFF};
+	/* -------------- Transmit Command -------------- */
+	ST7789_WriteRegister(hlcd, ST7789_REG_INV, (Invert == ST7789_INVERT_OFF) ? ST7789_CMD_INVOFF : ST7789_CMD_INVON, NULL, 0);
 	
-	/* --------------- Transmit Data ---------------- */
-	ST7789_SetWindowAddress(XPos, YPos, XPos + Font.Width - 1, YPos + Font.Height - 1);
+	ST7789_OS_UNLOCK(hlcd);
+	
+}
+
+void ST7789_Disp_TearEffect(ST7789_HandleTypeDef *hlcd, ST7789_TearTypeDef Tear)
+{
+	
+	/* TEON has one parameter, TEM = 0: V-Blanking information only */
+	uint8_t tem = 0x00;
+	
+	ST7789_OS_LOCK(hlcd);
+	
+	/* -------------- Transmit Command -------------- */
+	ST7789_TransmitCommandData(hlcd, (ST7789_CMDTypeDef)Tear, &tem, (Tear == ST7789_TEAR_ON) ? 1 : 0);
+	
+	ST7789_OS_UNLOCK(hlcd);
+	
+}
 
-	for (heightCounter = 0; heightCounter < Font.Height; heightCounter++)
+void ST7789_Disp_RegCache_Invalidate(ST7789_HandleTypeDef *hlcd)
+{
+	
+	ST7789_OS_LOCK(hlcd);
+	hlcd->RegCache.Valid = 0;
+	ST7789_OS_UNLOCK(hlcd);
+	
+}
+
+void ST7789_Disp_RegCache_GetStats(ST7789_HandleTypeDef *hlcd, ST7789_RegCacheStatsTypeDef *Stats)
+{
+	
+	ST7789_OS_LOCK(hlcd);
+	*Stats = hlcd->RegCache.Stats;
+	ST7789_OS_UNLOCK(hlcd);
+	
+}
+
+/* ............................ Clip ........................... */
+static ST7789_AreaTypeDef ST7789_ClipArea(ST7789_HandleTypeDef *hlcd)
+{
+	
+	ST7789_AreaTypeDef area = {0, 0, hlcd->Width - 1, hlcd->Height - 1};
+	
+	/* --------- Top of the Stack, Inside the Display -------- */
+	if (hlcd->Clip.Depth > 0)
 	{
 		
-		fontByte = Font.Data[(Ch - 32) * Font.Height + heightCounter];
+		area = hlcd->Clip.Area[hlcd->Clip.Depth - 1];
 		
-		for (widthCounter = 0; widthCounter < Font.Width; widthCounter++)
-		{
-			
-			if ((fontByte << widthCounter) & 0x8000)
-			{
-				ST7789_TransmitData(colorBuff, sizeof(colorBuff));
-			}
-			else
-			{
-				ST7789_TransmitData(bgColorBuff, sizeof(bgColorBuff));
-			}
-			
-		}
+		area.XEnd = (area.XEnd >= hlcd->Width) ? (hlcd->Width - 1) : area.XEnd;
+		area.YEnd = (area.YEnd >= hlcd->Height) ? (hlcd->Height - 1) : area.YEnd;
 		
 	}
 	
+	return area; // Empty: XStart > XEnd or YStart > YEnd
+	
+}
+
+ST7789_StatusTypeDef ST7789_Disp_Clip_Push(ST7789_HandleTypeDef *hlcd, int16_t XStart, int16_t YStart, int16_t XEnd, int16_t YEnd)
+{
+	
+	ST7789_AreaTypeDef current;
+	ST7789_AreaTypeDef *area;
+	
+	ST7789_OS_LOCK(hlcd);
+	
+	if (hlcd->Clip.Depth >= ST7789_CLIP_DEPTH)
+	{
+		
+		ST7789_OS_UNLOCK(hlcd);
+		return ST7789_ERROR;
+		
+	}
+	
+	current = ST7789_ClipArea(hlcd);
+	area    = &hlcd->Clip.Area[hlcd->Clip.Depth++];
+	
+	/* ------------- Intersect with the Current Area ------------ */
+	area->XStart = (XStart > (int16_t)current.XStart) ? (uint16_t)XStart : current.XStart;
+	area->YStart = (YStart > (int16_t)current.YStart) ? (uint16_t)YStart : current.YStart;
+	area->XEnd   = (XEnd < (int16_t)current.XEnd) ? ((XEnd < 0) ? 0 : (uint16_t)XEnd) : current.XEnd;
+	area->YEnd   = (YEnd < (int16_t)current.YEnd) ? ((YEnd < 0) ? 0 : (uint16_t)YEnd) : current.YEnd;
+	
+	/* Nothing is drawn until the area is popped */
+	if ((XEnd < 0) || (YEnd < 0) || (area->XStart > area->XEnd) || (area->YStart > area->YEnd))
+	{
+		
+		area->XStart = 1;
+		area->XEnd   = 0;
+		
+	}
+	
+	ST7789_OS_UNLOCK(hlcd);
+	
+	return ST7789_OK;
+	
+}
+
+void ST7789_Disp_Clip_Pop(ST7789_HandleTypeDef *hlcd)
+{
+	
+	ST7789_OS_LOCK(hlcd);
+	
+	if (hlcd->Clip.Depth > 0)
+	{
+		hlcd->Clip.Depth--;
+	}
+	
+	ST7789_OS_UNLOCK(hlcd);
+	
+}
+
+/* ...................... Color Converting ..................... */
+ST7789_ColorTypeDef ST7789_Color_GetFromRGB(uint8_t R, uint8_t G, uint8_t B)
+{
+	
+	/* -------------- Convert to RGB565 ------------- */
+	/*
+		RGB888 bit Format: RRRRRRRRGGGGGGGGBBBBBBBB
+		RGB565 bit Format: RRRRRGGGGGGBBBBB
+	*/
+	uint16_t rgb565 = (((uint16_t)R & 0xF8) << 8)|(((uint16_t)G & 0xFC) << 3)|((uint16_t)B >> 3);
+	
+	return rgb565;
+	
 }
 
-void ST7789_PutString(uint16_t XPos, uint16_t YPos, const char *Str, ST7789_FontTypeDef Font, ST7789_ColorTypeDef Color, ST7789_ColorTypeDef BackgroundColor)
+ST7789_ColorTypeDef ST7789_Color_GetFromHex(uint32_t HexCode)
+{
+	
+	/* -------------- Convert to RGB565 ------------- */
+	/*
+		RGB888 bit Format: RRRRRRRRGGGGGGGGBBBBBBBB
+		RGB565 bit Format: RRRRRGGGGGGBBBBB
+	*/
+	uint16_t rgb565 = (((HexCode & 0xF80000) >> 8) + ((HexCode & 0xFC00) >> 5) + ((HexCode & 0xF8) >> 3));
+	
+	return rgb565;
+	
+}
+
+ST7789_ColorTypeDef ST7789_Color_Blend(ST7789_ColorTypeDef Color, ST7789_ColorTypeDef BackgroundColor, uint8_t Alpha)
 {
 	
-	/* --------------- Put Characters --------------- */
-	while (*Str)
+	/*
+		RGB565 is spread to GGGGGG-----RRRRR------BBBBB (0x07E0F81F),
+		so the three channels are blended with one multiplication.
+	*/
+	uint32_t alpha = ((uint32_t)Alpha + 4) >> 3; // 0 ... 32
+	uint32_t fg    = ((uint32_t)Color | ((uint32_t)Color << 16)) & 0x07E0F81F;
+	uint32_t bg    = ((uint32_t)BackgroundColor | ((uint32_t)BackgroundColor << 16)) & 0x07E0F81F;
+	uint32_t rgb   = (((fg * alpha) + (bg * (32 - alpha))) >> 5) & 0x07E0F81F;
+	
+	return (ST7789_ColorTypeDef)((rgb | (rgb >> 16)) & 0xFFFF);
+	
+}
+
+/* ........................... Fill ............................ */
+void ST7789_Disp_Fill(ST7789_HandleTypeDef *hlcd, uint16_t XStart, uint16_t YStart, uint16_t XEnd, uint16_t YEnd, ST7789_ColorTypeDef Color)
+{
+	
+	uint16_t fillBuff[ST7789_PATTERN_CHUNK];
+	uint16_t fillColor = (Color >> 8) | ((Color & 0xFF) << 8); // Big-endian for the LCD
+	
+	uint32_t pixels;
+	uint32_t packetSize;
+	uint32_t pixelCounter;
+	
+	ST7789_AreaTypeDef clip;
+	
+	/* ---------------- Size Control ---------------- */
+	if ((XStart > XEnd) || (YStart > YEnd))
+	{
+		return;
+	}
+	
+	ST7789_OS_LOCK(hlcd);
+	
+	/* ------------- Clip to the Top Area ----------- */
+	clip   = ST7789_ClipArea(hlcd);
+	XStart = (XStart < clip.XStart) ? clip.XStart : XStart;
+	YStart = (YStart < clip.YStart) ? clip.YStart : YStart;
+	XEnd   = (XEnd > clip.XEnd) ? clip.XEnd : XEnd;
+	YEnd   = (YEnd > clip.YEnd) ? clip.YEnd : YEnd;
+	
+	if ((XStart > XEnd) || (YStart > YEnd))
+	{
+		
+		ST7789_OS_UNLOCK(hlcd);
+		return;
+		
+	}
+	
+	ST7789_Disp_SetWindowAddress(hlcd, XStart, YStart, XEnd, YEnd);
+	
+	pixels = (uint32_t)(XEnd - XStart + 1) * (YEnd - YStart + 1);
+	
+	/* ------------- Repeat without Buffer ---------- */
+	if (ST7789_TransmitRepeat(hlcd, Color, pixels) == ST7789_OK)
+	{
+		
+		ST7789_OS_UNLOCK(hlcd);
+		return;
+		
+	}
+	
+	/* ------- Send the Same Chunk for every Packet ------- */
+	packetSize = (pixels < ST7789_PATTERN_CHUNK) ? pixels : ST7789_PATTERN_CHUNK;
+	
+	for (pixelCounter = 0; pixelCounter < packetSize; pixelCounter++)
+	{
+		fillBuff[pixelCounter] = fillColor;
+	}
+	
+	while (pixels > 0)
+	{
+		
+		packetSize = (pixels < ST7789_PATTERN_CHUNK) ? pixels : ST7789_PATTERN_CHUNK;
+		
+		ST7789_TransmitData(hlcd, (uint8_t *)fillBuff, packetSize * sizeof(uint16_t));
+		
+		pixels -= packetSize;
+		
+	}
+	
+	/* The stack chunk must not be sent after the return */
+	ST7789_Disp_WaitForTransfer(hlcd);
+	
+	ST7789_OS_UNLOCK(hlcd);
+	
+}
+
+void ST7789_Disp_FillScreen(ST7789_HandleTypeDef *hlcd, ST7789_ColorTypeDef Color)
+{
+	
+	uint16_t widthCounter;
+	uint16_t heightCounter;
+	
+	uint32_t colorCounter;
+	uint32_t pixels    = (uint32_t)hlcd->Width * hlcd->Height;
+	uint32_t packetSize;
+	uint16_t newColor  = (Color & 0xFF) << 8|(Color >> 8);
+	
+	uint8_t colorBuff[2] = {Color >> 8, Color & 0xFF};
+	
+	ST7789_OS_LOCK(hlcd);
+	
+	/* ------------- Clipped: Fill the Area --------- */
+	if (hlcd->Clip.Depth > 0)
+	{
+		
+		ST7789_Disp_Fill(hlcd, 0, 0, hlcd->Width - 1, hlcd->Height - 1, Color);
+		
+		ST7789_OS_UNLOCK(hlcd);
+		return;
+		
+	}
+	
+	ST7789_Disp_SetWindowAddress(hlcd, 0, 0, hlcd->Width - 1, hlcd->Height - 1);
+	
+	/* ------------- Repeat without Buffer ---------- */
+	if (ST7789_TransmitRepeat(hlcd, Color, pixels) == ST7789_OK)
+	{
+		
+		ST7789_OS_UNLOCK(hlcd);
+		return;
+		
+	}
+	
+	/* ------------- Transmit LCD Buffer ------------ */
+	if (hlcd->Buffer != NULL)
+	{
+		
+		/* The buffer may still be sent by the last transfer */
+		ST7789_Disp_WaitForTransfer(hlcd);
+		
+		for (colorCounter = 0; colorCounter < hlcd->BufferLength; colorCounter++)
+		{
+			hlcd->Buffer[colorCounter] = newColor;
+		}
+		
+		while (pixels > 0)
+		{
+			
+			packetSize = (pixels > hlcd->BufferLength) ? hlcd->BufferLength : pixels;
+			
+			ST7789_TransmitData(hlcd, (uint8_t *)hlcd->Buffer, packetSize * sizeof(uint16_t));
+			
+			pixels -= packetSize;
+			
+		}
+		
+	}
+	else
+	{
+		
+		for (widthCounter = 0; widthCounter < hlcd->Width; widthCounter++)
+		{
+			for (heightCounter = 0; heightCounter < hlcd->Height; heightCounter++)
+			{
+				ST7789_TransmitData(hlcd, colorBuff, sizeof(colorBuff));
+			}
+		}
+		
+	}
+	
+	ST7789_OS_UNLOCK(hlcd);
+	
+}
+
+static void ST7789_FillClipped(ST7789_HandleTypeDef *hlcd, int32_t XStart, int32_t YStart, int32_t XEnd, int32_t YEnd, ST7789_ColorTypeDef Color)
+{
+	
+	/* -------------- Clip to the Display ----------- */
+	XStart = (XStart < 0) ? 0 : XStart;
+	YStart = (YStart < 0) ? 0 : YStart;
+	XEnd   = (XEnd >= hlcd->Width) ? (hlcd->Width - 1) : XEnd;
+	YEnd   = (YEnd >= hlcd->Height) ? (hlcd->Height - 1) : YEnd;
+	
+	if ((XStart > XEnd) || (YStart > YEnd))
+	{
+		return;
+	}
+	
+	ST7789_Disp_Fill(hlcd, (uint16_t)XStart, (uint16_t)YStart, (uint16_t)XEnd, (uint16_t)YEnd, Color);
+	
+}
+
+static void ST7789_ExpandTileRow(uint16_t *Buffer, uint16_t Pixels, const ST7789_TileTypeDef *Tile, uint16_t TileRow, uint16_t TileColumn)
+{
+	
+	const uint16_t *tileRow = &Tile->Data[(uint32_t)TileRow * Tile->Width];
+	
+	/* ---------------- Repeat the Row -------------- */
+	while (Pixels--)
+	{
+		
+		*Buffer++ = tileRow[TileColumn];
+		
+		if (++TileColumn == Tile->Width)
+		{
+			TileColumn = 0;
+		}
+		
+	}
+	
+}
+
+void ST7789_Disp_FillPattern(ST7789_HandleTypeDef *hlcd, uint16_t XStart, uint16_t YStart, uint16_t XEnd, uint16_t YEnd, const ST7789_TileTypeDef *Tile, uint16_t XPhase, uint16_t YPhase)
+{
+	
+	uint16_t  chunkBuff[ST7789_PATTERN_CHUNK];
+	uint16_t *lineBuff   = (hlcd->Buffer != NULL) ? hlcd->Buffer : chunkBuff;
+	uint32_t  buffLength = (hlcd->Buffer != NULL) ? hlcd->BufferLength : ST7789_PATTERN_CHUNK;
+	
+	uint32_t width;
+	uint32_t rows;
+	uint16_t tileRow;
+	uint16_t rowCounter;
+	uint32_t xCounter;
+	uint32_t columns;
+	uint32_t periodPixels;
+	uint32_t blockRows;
+	uint32_t pixelCounter;
+	
+	ST7789_AreaTypeDef clip;
+	
+	/* ---------------- Size Control ---------------- */
+	if ((XStart > XEnd) || (YStart > YEnd) || (Tile->Width == 0) || (Tile->Height == 0))
+	{
+		return;
+	}
+	
+	ST7789_OS_LOCK(hlcd);
+	
+	/* ----- Clip to the Top Area, the Tiles Keep their Place ----- */
+	clip = ST7789_ClipArea(hlcd);
+	
+	if (XStart < clip.XStart)
+	{
+		XPhase = (uint16_t)(((uint32_t)XPhase % Tile->Width + (clip.XStart - XStart)) % Tile->Width);
+		XStart = clip.XStart;
+	}
+	
+	if (YStart < clip.YStart)
+	{
+		YPhase = (uint16_t)(((uint32_t)YPhase % Tile->Height + (clip.YStart - YStart)) % Tile->Height);
+		YStart = clip.YStart;
+	}
+	
+	XEnd = (XEnd > clip.XEnd) ? clip.XEnd : XEnd;
+	YEnd = (YEnd > clip.YEnd) ? clip.YEnd : YEnd;
+	
+	if ((XStart > XEnd) || (YStart > YEnd))
+	{
+		
+		ST7789_OS_UNLOCK(hlcd);
+		return;
+		
+	}
+	
+	width        = (uint32_t)(XEnd - XStart + 1);
+	rows         = (uint32_t)(YEnd - YStart + 1);
+	tileRow      = YPhase % Tile->Height;
+	XPhase      %= Tile->Width;
+	periodPixels = (uint32_t)width * Tile->Height;
+	
+	ST7789_Disp_SetWindowAddress(hlcd, XStart, YStart, XEnd, YEnd);
+	
+	/* The buffer may still be sent by the last transfer */
+	ST7789_Disp_WaitForTransfer(hlcd);
+	
+	/* ------- Whole periods fit: Expand once, send them again for every block ------- */
+	if (periodPixels <= buffLength)
 	{
 		
-		if (XPos + Font.Width >= ST7789_WIDTH_MODIFIED)
+		for (rowCounter = 0; rowCounter < Tile->Height; rowCounter++)
+		{
+			ST7789_ExpandTileRow(&lineBuff[(uint32_t)rowCounter * width], (uint16_t)width, Tile, (tileRow + rowCounter) % Tile->Height, XPhase);
+		}
+		
+		/* ~~~~~~~~~~~~~~~ Copy the period to fill the buffer ~~~~~~~~~~~~~~~ */
+		blockRows = (buffLength / periodPixels) * Tile->Height;
+		blockRows = (blockRows < rows) ? blockRows : rows;
+		
+		for (pixelCounter = periodPixels; pixelCounter < (blockRows * width); pixelCounter++)
+		{
+			lineBuff[pixelCounter] = lineBuff[pixelCounter - periodPixels];
+		}
+		
+		/* Every block starts at the same tile row */
+		while (rows > 0)
 		{
 			
-			XPos  = 0;
-			YPos += Font.Height;
+			blockRows = (rows < blockRows) ? rows : blockRows;
+			
+			ST7789_TransmitData(hlcd, (uint8_t *)lineBuff, blockRows * width * sizeof(uint16_t));
+			
+			rows -= blockRows;
+			
+		}
+		
+	}
+	else
+	{
+		
+		/* -------------- Row by row, part of a row per pass ---------------- */
+		while (rows--)
+		{
 			
-			if (YPos + Font.Height >= ST7789_HEIGHT_MODIFIED)
+			for (xCounter = 0; xCounter < width; xCounter += columns)
 			{
-				break;
+				
+				columns = ((width - xCounter) < buffLength) ? (width - xCounter) : buffLength;
+				
+				ST7789_Disp_WaitForTransfer(hlcd);
+				ST7789_ExpandTileRow(lineBuff, (uint16_t)columns, Tile, tileRow, (uint16_t)((XPhase + xCounter) % Tile->Width));
+				
+				ST7789_TransmitData(hlcd, (uint8_t *)lineBuff, columns * sizeof(uint16_t));
+				
 			}
 			
-			/* Skip space in the beginning of the new line */
-			if (*Str == ' ')
+			if (++tileRow == Tile->Height)
 			{
-				Str++;
-				continue;
+				tileRow = 0;
 			}
 			
 		}
 		
-		ST7789_PutChar(XPos, YPos, *Str, Font, Color, BackgroundColor);
-		
-		XPos += Font.Width;
-		Str++;
-		
 	}
 	
-}
-
+	/* The stack chunk must not be sent after the return */
+	if (lineBuff == chunkBuff)
+	{
+		ST7789_Disp_WaitForTransfer(hlcd);
+	}
+	
+	ST7789_OS_UNLOCK(hlcd);
+	
+}
+
+static int64_t ST7789_FloorDiv(int64_t Numerator, int64_t Denominator)
+{
+	
+	int64_t quotient = Numerator / Denominator;
+	
+	/* C division rounds to zero */
+	if (((Numerator % Denominator) != 0) && ((Numerator < 0) != (Denominator < 0)))
+	{
+		quotient--;
+	}
+	
+	return quotient;
+	
+}
+
+static uint32_t ST7789_Sqrt(uint32_t Value)
+{
+	
+	uint32_t root = 0;
+	uint32_t bit  = 1UL << 30;
+	
+	while (bit > Value)
+	{
+		bit >>= 2;
+	}
+	
+	/* ------------ Integer Square Root ------------- */
+	while (bit != 0)
+	{
+		
+		if (Value >= (root + bit))
+		{
+			Value -= root + bit;
+			root   = (root >> 1) + bit;
+		}
+		else
+		{
+			root >>= 1;
+		}
+		
+		bit >>= 2;
+		
+	}
+	
+	return root;
+	
+}
+
+static uint32_t ST7789_Sqrt64(uint64_t Value)
+{
+	
+	uint8_t shift = 0;
+	
+	/* sqrt(Value) = sqrt(Value / 4^n) * 2^n */
+	while (Value > UINT32_MAX)
+	{
+		Value >>= 2;
+		shift++;
+	}
+	
+	return ST7789_Sqrt((uint32_t)Value) << shift;
+	
+}
+
+static void ST7789_Gradient_Setup(ST7789_GradientSetupTypeDef *Setup, const ST7789_GradientTypeDef *Gradient, uint16_t XStart, uint16_t YStart, uint16_t XEnd, uint16_t YEnd)
+{
+	
+	uint8_t channel1[3] = {(Gradient->Color1 >> 8) & 0xF8, (Gradient->Color1 >> 3) & 0xFC, (Gradient->Color1 << 3) & 0xF8};
+	uint8_t channel2[3] = {(Gradient->Color2 >> 8) & 0xF8, (Gradient->Color2 >> 3) & 0xFC, (Gradient->Color2 << 3) & 0xF8};
+	uint8_t channelCounter;
+	
+	/* ---------- Colors in 8.8 Fixed Point --------- */
+	for (channelCounter = 0; channelCounter < 3; channelCounter++)
+	{
+		Setup->Channel[channelCounter] = (int32_t)channel1[channelCounter] << 8;
+		Setup->Delta[channelCounter]   = (int32_t)channel2[channelCounter] - channel1[channelCounter];
+	}
+	
+	Setup->Mode   = Gradient->Mode;
+	Setup->Dither = Gradient->Dither;
+	
+	/* ---------- Direction of the Gradient --------- */
+	switch (Gradient->Mode)
+	{
+		
+		case ST7789_GRADIENT_HORIZONTAL:
+		
+		Setup->X1 = XStart;
+		Setup->Y1 = YStart;
+		Setup->DX = XEnd - XStart;
+		Setup->DY = 0;
+		
+		break;
+		
+		case ST7789_GRADIENT_VERTICAL:
+		
+		Setup->X1 = XStart;
+		Setup->Y1 = YStart;
+		Setup->DX = 0;
+		Setup->DY = YEnd - YStart;
+		
+		break;
+		
+		default: /* Linear and radial */
+		
+		Setup->X1 = Gradient->X1;
+		Setup->Y1 = Gradient->Y1;
+		Setup->DX = (int32_t)Gradient->X2 - Gradient->X1;
+		Setup->DY = (int32_t)Gradient->Y2 - Gradient->Y1;
+		
+		break;
+		
+	}
+	
+	Setup->Length2 = Setup->DX * Setup->DX + Setup->DY * Setup->DY;
+	Setup->Radius  = (Gradient->Radius > 0) ? Gradient->Radius : 1;
+	
+}
+
+static uint16_t ST7789_Gradient_Pixel(const ST7789_GradientSetupTypeDef *Setup, int32_t Position, uint8_t Threshold)
+{
+	
+	int32_t  red;
+	int32_t  green;
+	int32_t  blue;
+	uint16_t color;
+	
+	/* Position: 0 at Color1, 65536 at Color2 */
+	Position = (Position < 0) ? 0 : ((Position > 65536) ? 65536 : Position);
+	
+	red   = Setup->Channel[0] + ((Setup->Delta[0] * Position) >> 8);
+	green = Setup->Channel[1] + ((Setup->Delta[1] * Position) >> 8);
+	blue  = Setup->Channel[2] + ((Setup->Delta[2] * Position) >> 8);
+	
+	/* ------- Quantize to RGB565 at the Threshold ------- */
+	color = (uint16_t)((((red + Threshold * 64) >> 11) << 11) | (((green + Threshold * 32) >> 10) << 5) | ((blue + Threshold * 64) >> 11));
+	
+	return (color >> 8) | (color << 8); // Big-endian for the LCD
+	
+}
+
+static void ST7789_Gradient_Span(const ST7789_GradientSetupTypeDef *Setup, uint16_t *Dest, uint16_t XPos, uint16_t YPos, uint16_t Pixels)
+{
+	
+	static const uint8_t bayer[4][4] = {{0, 8, 2, 10}, {12, 4, 14, 6}, {3, 11, 1, 9}, {15, 7, 13, 5}};
+	
+	const uint8_t *threshold = bayer[YPos & 3];
+	
+	int32_t  position;
+	int32_t  step;
+	int32_t  dx;
+	int32_t  dy;
+	uint32_t distance2;
+	uint32_t distance;
+	
+	/* ~~~~~~~~~~~~~~~~~~~~~~~ Radial ~~~~~~~~~~~~~~~~~~~~~~~ */
+	if (Setup->Mode == ST7789_GRADIENT_RADIAL)
+	{
+		
+		dx        = (int32_t)XPos - Setup->X1;
+		dy        = (int32_t)YPos - Setup->Y1;
+		distance2 = (uint32_t)(dx * dx + dy * dy) << 8;
+		distance  = ST7789_Sqrt(distance2); // Distance in 1/16 pixel
+		
+		while (Pixels--)
+		{
+			
+			*Dest++ = ST7789_Gradient_Pixel(Setup, (int32_t)((distance * 4096U) / Setup->Radius), Setup->Dither ? (2 * threshold[XPos & 3] + 1) : 16);
+			
+			/* ---- Next Distance (Changes by 16 at Most) ---- */
+			distance2 += (uint32_t)(2 * dx + 1) << 8;
+			dx++;
+			XPos++;
+			
+			while (((distance + 1) * (distance + 1)) <= distance2)
+			{
+				distance++;
+			}
+			
+			while ((distance * distance) > distance2)
+			{
+				distance--;
+			}
+			
+		}
+		
+		return;
+		
+	}
+	
+	/* ~~~~~~~~~~~~~~~~~~~~~~~ Linear ~~~~~~~~~~~~~~~~~~~~~~~ */
+	if (Setup->Length2 == 0)
+	{
+		position = 0;
+		step     = 0;
+	}
+	else
+	{
+		position = (int32_t)((((int64_t)((int32_t)XPos - Setup->X1) * Setup->DX + (int64_t)((int32_t)YPos - Setup->Y1) * Setup->DY) << 16) / Setup->Length2);
+		step     = (int32_t)(((int64_t)Setup->DX << 16) / Setup->Length2);
+	}
+	
+	while (Pixels--)
+	{
+		
+		*Dest++ = ST7789_Gradient_Pixel(Setup, position, Setup->Dither ? (2 * threshold[XPos & 3] + 1) : 16);
+		
+		position += step;
+		XPos++;
+		
+	}
+	
+}
+
+void ST7789_Disp_FillGradient(ST7789_HandleTypeDef *hlcd, uint16_t XStart, uint16_t YStart, uint16_t XEnd, uint16_t YEnd, const ST7789_GradientTypeDef *Gradient)
+{
+	
+	ST7789_GradientSetupTypeDef setup;
+	
+	uint16_t  chunkBuff[ST7789_PATTERN_CHUNK];
+	uint16_t *band[2];
+	uint32_t  bandLength;
+	uint8_t   bandIndex = 0;
+	
+	uint16_t width;
+	uint16_t rows;
+	uint16_t rowCounter;
+	uint16_t period;
+	uint16_t xPos;
+	uint16_t yPos;
+	uint16_t runEnd;
+	uint16_t color;
+	uint16_t nextColor;
+	uint32_t periodPixels;
+	uint32_t blockRows;
+	uint32_t pixelCounter;
+	uint32_t filled;
+	uint32_t count;
+	
+	ST7789_AreaTypeDef clip;
+	
+	/* ---------------- Size Control ---------------- */
+	if ((XStart > XEnd) || (YStart > YEnd))
+	{
+		return;
+	}
+	
+	ST7789_OS_LOCK(hlcd);
+	
+	/* The colors follow the whole area, only the visible part is sent */
+	ST7789_Gradient_Setup(&setup, Gradient, XStart, YStart, XEnd, YEnd);
+	
+	/* ------------- Clip to the Top Area ----------- */
+	clip   = ST7789_ClipArea(hlcd);
+	XStart = (XStart < clip.XStart) ? clip.XStart : XStart;
+	YStart = (YStart < clip.YStart) ? clip.YStart : YStart;
+	XEnd   = (XEnd > clip.XEnd) ? clip.XEnd : XEnd;
+	YEnd   = (YEnd > clip.YEnd) ? clip.YEnd : YEnd;
+	
+	if ((XStart > XEnd) || (YStart > YEnd))
+	{
+		
+		ST7789_OS_UNLOCK(hlcd);
+		return;
+		
+	}
+	
+	width        = XEnd - XStart + 1;
+	rows         = YEnd - YStart + 1;
+	period       = Gradient->Dither ? 4 : 1; // Rows of the dither matrix
+	periodPixels = (uint32_t)width * period;
+	
+	/* ------- Color Changes along X Only: Expand the rows once, send them again for every block ------- */
+	if ((setup.Mode != ST7789_GRADIENT_RADIAL) && (setup.DY == 0) && (hlcd->Buffer != NULL) && (periodPixels <= hlcd->BufferLength))
+	{
+		
+		/* The buffer may still be sent by the last transfer */
+		ST7789_Disp_WaitForTransfer(hlcd);
+		
+		for (rowCounter = 0; rowCounter < period; rowCounter++)
+		{
+			ST7789_Gradient_Span(&setup, &hlcd->Buffer[(uint32_t)rowCounter * width], XStart, YStart + rowCounter, width);
+		}
+		
+		blockRows = (hlcd->BufferLength / periodPixels) * period;
+		blockRows = (blockRows < rows) ? blockRows : rows;
+		
+		for (pixelCounter = periodPixels; pixelCounter < (blockRows * width); pixelCounter++)
+		{
+			hlcd->Buffer[pixelCounter] = hlcd->Buffer[pixelCounter - periodPixels];
+		}
+		
+		ST7789_Disp_SetWindowAddress(hlcd, XStart, YStart, XEnd, YEnd);
+		
+		/* Every block starts at the same dither row */
+		while (rows > 0)
+		{
+			
+			blockRows = (rows < blockRows) ? rows : blockRows;
+			
+			ST7789_TransmitData(hlcd, (uint8_t *)hlcd->Buffer, blockRows * width * sizeof(uint16_t));
+			
+			rows -= blockRows;
+			
+		}
+		
+		ST7789_OS_UNLOCK(hlcd);
+		return;
+		
+	}
+	
+	/* ------- Color Changes along Y Only: Rows of the same color are one repeat fill ------- */
+	if ((setup.Mode != ST7789_GRADIENT_RADIAL) && (setup.DX == 0) && !setup.Dither && (hlcd->Bus->WriteRepeat != NULL))
+	{
+		
+		ST7789_Gradient_Span(&setup, &color, XStart, YStart, 1);
+		
+		for (yPos = YStart; yPos <= YEnd; yPos = runEnd + 1)
+		{
+			
+			for (runEnd = yPos; runEnd < YEnd; runEnd++)
+			{
+				
+				ST7789_Gradient_Span(&setup, &nextColor, XStart, runEnd + 1, 1);
+				
+				if (nextColor != color)
+				{
+					break;
+				}
+				
+			}
+			
+			ST7789_Disp_Fill(hlcd, XStart, yPos, XEnd, runEnd, (ST7789_ColorTypeDef)((color >> 8) | (color << 8)));
+			
+			color = nextColor;
+			
+		}
+		
+		ST7789_OS_UNLOCK(hlcd);
+		return;
+		
+	}
+	
+	/* ------ Two Bands in the LCD Buffer, or One on the Stack ------ */
+	bandLength = (hlcd->Buffer != NULL) ? (hlcd->BufferLength / 2) : 0;
+	
+	if (bandLength > 0)
+	{
+		band[0] = hlcd->Buffer;
+		band[1] = hlcd->Buffer + bandLength;
+	}
+	else
+	{
+		band[0]    = chunkBuff;
+		band[1]    = chunkBuff;
+		bandLength = ST7789_PATTERN_CHUNK;
+	}
+	
+	ST7789_Disp_SetWindowAddress(hlcd, XStart, YStart, XEnd, YEnd);
+	ST7789_Disp_WaitForTransfer(hlcd);
+	
+	xPos = XStart;
+	yPos = YStart;
+	
+	/* ----- Generate a Band while the Other is Sent ----- */
+	while (yPos <= YEnd)
+	{
+		
+		for (filled = 0; (filled < bandLength) && (yPos <= YEnd); filled += count)
+		{
+			
+			count = (uint32_t)(XEnd - xPos + 1);
+			count = (count < (bandLength - filled)) ? count : (bandLength - filled);
+			
+			ST7789_Gradient_Span(&setup, &band[bandIndex][filled], xPos, yPos, (uint16_t)count);
+			
+			xPos += (uint16_t)count;
+			
+			if (xPos > XEnd)
+			{
+				xPos = XStart;
+				yPos++;
+			}
+			
+		}
+		
+		ST7789_TransmitData(hlcd, (uint8_t *)band[bandIndex], filled * sizeof(uint16_t));
+		
+		/* One band: The next pass writes the same memory */
+		if (band[0] == band[1])
+		{
+			ST7789_Disp_WaitForTransfer(hlcd);
+		}
+		
+		bandIndex ^= 1;
+		
+	}
+	
+	ST7789_OS_UNLOCK(hlcd);
+	
+}
+
+/* .......................... Drawing .......................... */
+void ST7789_Disp_DrawPixel(ST7789_HandleTypeDef *hlcd, uint16_t XPos, uint16_t YPos, ST7789_ColorTypeDef Color)
+{
+	
+	uint8_t colorBuff[2] = {Color >> 8, Color & 0xFF};
+	
+	ST7789_AreaTypeDef clip;
+	
+	ST7789_OS_LOCK(hlcd);
+	
+	/* ---------------- Size Control ---------------- */
+	clip = ST7789_ClipArea(hlcd);
+	
+	if ((XPos < clip.XStart) || (XPos > clip.XEnd) || (YPos < clip.YStart) || (YPos > clip.YEnd))
+	{
+		
+		ST7789_OS_UNLOCK(hlcd);
+		return;
+		
+	}
+	
+	ST7789_Disp_SetWindowAddress(hlcd, XPos, YPos, XPos, YPos);
+	
+	/* ---------------- Write Pixel ----------------- */
+	ST7789_TransmitData(hlcd, colorBuff, sizeof(colorBuff));
+	
+	ST7789_OS_UNLOCK(hlcd);
+	
+}
+
+void ST7789_Disp_DrawPixel_4px(ST7789_HandleTypeDef *hlcd, uint16_t XPos, uint16_t YPos, ST7789_ColorTypeDef Color)
+{
+	
+	/* ---------------- Size Control ---------------- */
+	if ((XPos <= 0) || (XPos > hlcd->Width) || (YPos <= 0) || (YPos > hlcd->Height))
+	{
+		return;
+	}
+	
+	/* ---------------- Write Pixel ----------------- */
+	ST7789_Disp_Fill(hlcd, XPos - 1, YPos - 1, XPos + 1, YPos + 1, Color);
+	
+}
+
+static uint8_t ST7789_PointBefore(const ST7789_PointTypeDef *Points, uint16_t A, uint16_t B)
+{
+	
+	/* Row, then column, then the order of the caller (a later point wins) */
+	if (Points[A].Y != Points[B].Y)
+	{
+		return Points[A].Y < Points[B].Y;
+	}
+	
+	if (Points[A].X != Points[B].X)
+	{
+		return Points[A].X < Points[B].X;
+	}
+	
+	return A < B;
+	
+}
+
+static void ST7789_SiftPoint(const ST7789_PointTypeDef *Points, uint16_t *Order, uint16_t Parent, uint16_t End)
+{
+	
+	uint16_t child;
+	uint16_t swap;
+	
+	/* ---------- Move the Point Down the Heap ---------- */
+	for (; (child = (2 * Parent) + 1) < End; Parent = child)
+	{
+		
+		if (((child + 1) < End) && ST7789_PointBefore(Points, Order[child], Order[child + 1]))
+		{
+			child++;
+		}
+		
+		if (!ST7789_PointBefore(Points, Order[Parent], Order[child]))
+		{
+			break;
+		}
+		
+		swap          = Order[Parent];
+		Order[Parent] = Order[child];
+		Order[child]  = swap;
+		
+	}
+	
+}
+
+static void ST7789_SortPoints(const ST7789_PointTypeDef *Points, uint16_t *Order, uint16_t Count)
+{
+	
+	uint16_t counter;
+	uint16_t swap;
+	
+	for (counter = 0; counter < Count; counter++)
+	{
+		Order[counter] = counter;
+	}
+	
+	/* ------- Heap Sort: No Memory and No Recursion ------- */
+	for (counter = Count / 2; counter > 0; counter--)
+	{
+		ST7789_SiftPoint(Points, Order, counter - 1, Count);
+	}
+	
+	for (counter = Count - 1; counter > 0; counter--)
+	{
+		
+		swap           = Order[0];
+		Order[0]       = Order[counter];
+		Order[counter] = swap;
+		
+		ST7789_SiftPoint(Points, Order, 0, counter);
+		
+	}
+	
+}
+
+uint32_t ST7789_Disp_DrawPoints(ST7789_HandleTypeDef *hlcd, const ST7789_PointTypeDef *Points, const ST7789_ColorTypeDef *Colors, uint16_t Count, ST7789_ColorTypeDef Color, uint16_t *Order)
+{
+	
+	uint16_t  chunkBuff[ST7789_LINE_CHUNK];
+	uint16_t *band[2];
+	uint16_t *pixel;
+	uint32_t  bandLength;
+	uint8_t   bandIndex = 0;
+	
+	ST7789_PointTypeDef point;
+	ST7789_AreaTypeDef  clip;
+	
+	uint16_t counter = 0;
+	uint16_t index;
+	uint16_t color;
+	uint16_t filled;
+	uint8_t  uniform;
+	int32_t  xEnd;
+	uint32_t points  = 0;
+	uint32_t windows = 0;
+	
+	if ((Points == NULL) || (Count == 0))
+	{
+		return 0;
+	}
+	
+	/* ------- Sort by Row: Neighbours Follow Each Other ------- */
+	if (Order != NULL)
+	{
+		ST7789_SortPoints(Points, Order, Count);
+	}
+	
+	ST7789_OS_LOCK(hlcd);
+	
+	clip = ST7789_ClipArea(hlcd);
+	
+	/* ------ Two Bands in the LCD Buffer, or One on the Stack ------ */
+	bandLength = (hlcd->Buffer != NULL) ? (hlcd->BufferLength / 2) : 0;
+	
+	if (bandLength > 0)
+	{
+		band[0] = hlcd->Buffer;
+		band[1] = hlcd->Buffer + bandLength;
+	}
+	else
+	{
+		band[0]    = chunkBuff;
+		band[1]    = chunkBuff;
+		bandLength = ST7789_LINE_CHUNK;
+	}
+	
+	ST7789_Disp_WaitForTransfer(hlcd);
+	
+	/* ------- One Window for Every Run of Adjacent Points ------- */
+	while (counter < Count)
+	{
+		
+		index = (Order != NULL) ? Order[counter] : counter;
+		point = Points[index];
+		counter++;
+		
+		if ((point.X < (int32_t)clip.XStart) || (point.X > (int32_t)clip.XEnd) || (point.Y < (int32_t)clip.YStart) || (point.Y > (int32_t)clip.YEnd))
+		{
+			continue;
+		}
+		
+		pixel    = band[bandIndex];
+		color    = (Colors != NULL) ? Colors[index] : Color;
+		pixel[0] = (color >> 8) | ((color & 0xFF) << 8); // Big-endian for the LCD
+		filled   = 1;
+		uniform  = 1;
+		xEnd     = point.X;
+		points++;
+		
+		/* ~~~~~~~~~~~~~~~~ The Right Neighbour Continues the Run ~~~~~~~~~~~~~~~~ */
+		while (counter < Count)
+		{
+			
+			index = (Order != NULL) ? Order[counter] : counter;
+			
+			if (Points[index].Y != point.Y)
+			{
+				break;
+			}
+			
+			/* The same pixel again: The later color is drawn */
+			if (Points[index].X == xEnd)
+			{
+				filled--;
+			}
+			else if ((Points[index].X != (xEnd + 1)) || (Points[index].X > (int32_t)clip.XEnd) || (filled == bandLength))
+			{
+				break;
+			}
+			
+			color          = (Colors != NULL) ? Colors[index] : Color;
+			pixel[filled]  = (color >> 8) | ((color & 0xFF) << 8);
+			uniform       &= (pixel[filled] == pixel[0]);
+			xEnd           = Points[index].X;
+			filled++;
+			points++;
+			counter++;
+			
+		}
+		
+		windows++;
+		
+		/* ~~~~~~~~~~~~~~~~~~ One Color: Repeat, Otherwise Send the Run ~~~~~~~~~~~~~~~~~~ */
+		if (uniform && (filled > 1) && (hlcd->Bus->WriteRepeat != NULL))
+		{
+			ST7789_Disp_Fill(hlcd, (uint16_t)point.X, (uint16_t)point.Y, (uint16_t)xEnd, (uint16_t)point.Y, color);
+			continue;
+		}
+		
+		ST7789_Disp_SetWindowAddress(hlcd, (uint16_t)point.X, (uint16_t)point.Y, (uint16_t)xEnd, (uint16_t)point.Y);
+		ST7789_TransmitData(hlcd, (uint8_t *)pixel, (uint32_t)filled * sizeof(uint16_t));
+		
+		/* One band: The next run writes the same memory */
+		if (band[0] == band[1])
+		{
+			ST7789_Disp_WaitForTransfer(hlcd);
+		}
+		
+		bandIndex ^= 1;
+		
+	}
+	
+	ST7789_OS_UNLOCK(hlcd);
+	
+	return points - windows; // Windows saved against one ST7789_DrawPixel per point
+	
+}
+
+void ST7789_Disp_DrawLine(ST7789_HandleTypeDef *hlcd, uint16_t XStart, uint16_t YStart, uint16_t XEnd, uint16_t YEnd, ST7789_ColorTypeDef Color)
+{
+	
+	ST7789_AreaTypeDef clip;
+	
+	uint16_t Swap;
+	uint8_t  Steep = abs(YEnd - YStart) > abs(XEnd - XStart);
+	
+	int32_t xDif;
+	int32_t yDif;
+	int32_t err;
+	int32_t yStep;
+	int32_t first;
+	int32_t last;
+	int32_t minorFirst;
+	int32_t minorLast;
+	int32_t minorSteps;
+	int32_t xPos;
+	int32_t yPos;
+	int32_t runStart;
+	
+	/* ------------------ Swap XY ------------------- */
+	if (Steep)
+	{
+		
+		Swap   = XStart;
+		XStart = YStart;
+		YStart = Swap;
+		
+		Swap   = XEnd;
+		XEnd   = YEnd;
+		YEnd   = Swap;
+		
+	}
+	
+	/* -------------- Swap XStart/XEnd -------------- */
+	if (XStart > XEnd)
+	{
+		
+		Swap   = XStart;
+		XStart = XEnd;
+		XEnd   = Swap;
+		
+		Swap   = YStart;
+		YStart = YEnd;
+		YEnd   = Swap;
+		
+	}
+	
+	/* ------------ Calculate Line Length ----------- */
+	xDif  = (int32_t)XEnd - XStart;
+	yDif  = abs((int32_t)YEnd - YStart);
+	yStep = (YStart < YEnd) ? 1 : -1;
+	
+	ST7789_OS_LOCK(hlcd);
+	
+	/* --------------- Clip the Steps --------------- */
+	/*
+		Step k (0 ... xDif) draws X = XStart + k and Y = YStart + yStep * m(k), with
+		m(k) = ceil((k * yDif - xDif / 2) / xDif). The steps inside the clip area are
+		found from the bounds, the pixels outside are never stepped through.
+	*/
+	clip       = ST7789_ClipArea(hlcd);
+	first      = (int32_t)(Steep ? clip.YStart : clip.XStart) - XStart;
+	last       = (int32_t)(Steep ? clip.YEnd : clip.XEnd) - XStart;
+	minorFirst = (yStep > 0) ? ((int32_t)(Steep ? clip.XStart : clip.YStart) - YStart) : ((int32_t)YStart - (Steep ? clip.XEnd : clip.YEnd));
+	minorLast  = (yStep > 0) ? ((int32_t)(Steep ? clip.XEnd : clip.YEnd) - YStart) : ((int32_t)YStart - (Steep ? clip.XStart : clip.YStart));
+	
+	first = (first < 0) ? 0 : first;
+	last  = (last > xDif) ? xDif : last;
+	
+	if ((clip.XStart > clip.XEnd) || (clip.YStart > clip.YEnd) || (minorLast < 0) || (minorFirst > yDif))
+	{
+		
+		ST7789_OS_UNLOCK(hlcd);
+		return;
+		
+	}
+	
+	if ((yDif > 0) && (minorFirst > 0))
+	{
+		minorSteps = (int32_t)ST7789_FloorDiv((int64_t)(minorFirst - 1) * xDif + (xDif / 2), yDif) + 1;
+		first      = (minorSteps > first) ? minorSteps : first;
+	}
+	
+	if ((yDif > 0) && (minorLast < yDif))
+	{
+		minorSteps = (int32_t)ST7789_FloorDiv((int64_t)minorLast * xDif + (xDif / 2), yDif);
+		last       = (minorSteps < last) ? minorSteps : last;
+	}
+	
+	if (first > last)
+	{
+		
+		ST7789_OS_UNLOCK(hlcd);
+		return;
+		
+	}
+	
+	/* State of the first step */
+	minorSteps = (xDif > 0) ? (int32_t)-ST7789_FloorDiv((int64_t)(xDif / 2) - ((int64_t)first * yDif), xDif) : 0;
+	err        = (int32_t)((int64_t)(xDif / 2) - ((int64_t)first * yDif) + ((int64_t)minorSteps * xDif));
+	xPos       = XStart + first;
+	yPos       = YStart + (yStep * minorSteps);
+	
+	/* ----------------- Draw Line ------------------ */
+	for (runStart = xPos; xPos <= (XStart + last); xPos++)
+	{
+		
+		err -= yDif;
+		
+		/* The run ends where Y steps, one window per run */
+		if ((err < 0) || (xPos == (XStart + last)))
+		{
+			
+			if (Steep)
+			{
+				ST7789_FillClipped(hlcd, yPos, runStart, yPos, xPos, Color);
+			}
+			else
+			{
+				ST7789_FillClipped(hlcd, runStart, yPos, xPos, yPos, Color);
+			}
+			
+			runStart = xPos + 1;
+			
+		}
+		
+		if (err < 0)
+		{
+			yPos += yStep;
+			err  += xDif;
+		}
+		
+	}
+	
+	ST7789_OS_UNLOCK(hlcd);
+	
+}
+
+void ST7789_Disp_DrawLine_AA(ST7789_HandleTypeDef *hlcd, int16_t XStart, int16_t YStart, int16_t XEnd, int16_t YEnd, ST7789_ColorTypeDef Color, ST7789_ColorTypeDef BackgroundColor)
+{
+	
+	uint16_t  chunkBuff[ST7789_LINE_CHUNK];
+	uint16_t *band[2];
+	uint16_t *pixel;
+	uint32_t  bandLength;
+	uint8_t   bandIndex = 0;
+	
+	uint16_t ramp[33];
+	uint8_t  steep = abs(YEnd - YStart) > abs(XEnd - XStart);
+	uint8_t  level;
+	uint8_t  topVisible;
+	uint8_t  bottomVisible;
+	
+	int32_t  swap;
+	int64_t  gradient; // 16.16 fixed point, int64: The steps of a long line overflow 32 bits
+	int64_t  intery;
+	int32_t  major;
+	int32_t  majorEnd;
+	int32_t  runStart;
+	int32_t  minor;
+	int32_t  majorMin;
+	int32_t  majorMax;
+	int32_t  minorMin;
+	int32_t  minorMax;
+	uint16_t count;
+	uint16_t counter;
+	uint16_t color;
+	
+	ST7789_AreaTypeDef clip;
+	
+	/* ----------- Colors of the 32 Coverage Levels --------- */
+	for (level = 0; level <= 32; level++)
+	{
+		color       = ST7789_Color_Blend(Color, BackgroundColor, (uint8_t)(((uint16_t)level * 255) / 32));
+		ramp[level] = (color >> 8) | ((color & 0xFF) << 8); // Big-endian for the LCD
+	}
+	
+	/* ------------------ Swap XY ------------------- */
+	if (steep)
+	{
+		
+		swap   = XStart;
+		XStart = YStart;
+		YStart = (int16_t)swap;
+		
+		swap   = XEnd;
+		XEnd   = YEnd;
+		YEnd   = (int16_t)swap;
+		
+	}
+	
+	/* -------------- Swap XStart/XEnd -------------- */
+	if (XStart > XEnd)
+	{
+		
+		swap   = XStart;
+		XStart = XEnd;
+		XEnd   = (int16_t)swap;
+		
+		swap   = YStart;
+		YStart = YEnd;
+		YEnd   = (int16_t)swap;
+		
+	}
+	
+	ST7789_OS_LOCK(hlcd);
+	
+	/* ------------- Clip to the Top Area ----------- */
+	clip     = ST7789_ClipArea(hlcd);
+	majorMin = steep ? clip.YStart : clip.XStart;
+	majorMax = steep ? clip.YEnd : clip.XEnd;
+	minorMin = steep ? clip.XStart : clip.YStart;
+	minorMax = steep ? clip.XEnd : clip.YEnd;
+	
+	/* --------- Minor Position in 16.16 Fixed Point -------- */
+	gradient = (XEnd != XStart) ? (((int64_t)(YEnd - YStart) * 65536) / (XEnd - XStart)) : 0;
+	major    = (XStart < majorMin) ? majorMin : XStart;
+	majorEnd = (XEnd > majorMax) ? majorMax : XEnd;
+	intery   = ((int64_t)YStart * 65536) + (gradient * (major - XStart));
+	
+	if ((major > majorEnd) || (minorMin > minorMax))
+	{
+		
+		ST7789_OS_UNLOCK(hlcd);
+		return;
+		
+	}
+	
+	/* ------ Two Bands in the LCD Buffer, or One on the Stack ------ */
+	bandLength = (hlcd->Buffer != NULL) ? (hlcd->BufferLength / 2) : 0;
+	
+	if (bandLength >= 2)
+	{
+		band[0] = hlcd->Buffer;
+		band[1] = hlcd->Buffer + bandLength;
+	}
+	else
+	{
+		band[0]    = chunkBuff;
+		band[1]    = chunkBuff;
+		bandLength = ST7789_LINE_CHUNK;
+	}
+	
+	ST7789_Disp_WaitForTransfer(hlcd);
+	
+	/* ------- One Window for Every Run of the Same Pixel Pair ------- */
+	while (major <= majorEnd)
+	{
+		
+		pixel    = band[bandIndex];
+		minor    = (int32_t)(intery >> 16);
+		runStart = major;
+		
+		/* Pair of pixels: Coverage of the first is 1 - Fraction, of the second Fraction */
+		for (count = 0; (major <= majorEnd) && ((intery >> 16) == minor) && (count < (bandLength / 2)); count++)
+		{
+			
+			level = (uint8_t)((intery >> 11) & 0x1F);
+			
+			if (steep)
+			{
+				pixel[2 * count]       = ramp[32 - level];
+				pixel[(2 * count) + 1] = ramp[level];
+			}
+			else
+			{
+				pixel[count]                    = ramp[32 - level];
+				pixel[(bandLength / 2) + count] = ramp[level];
+			}
+			
+			intery += gradient;
+			major++;
+			
+		}
+		
+		topVisible    = (minor >= minorMin) && (minor <= minorMax);
+		bottomVisible = ((minor + 1) >= minorMin) && ((minor + 1) <= minorMax);
+		
+		if (!topVisible && !bottomVisible)
+		{
+			continue;
+		}
+		
+		/* ~~~~~~~~~~~~~~~~~~~~~~~~~ Pack the Visible Pixels ~~~~~~~~~~~~~~~~~~~~~~~~~ */
+		if (steep)
+		{
+			
+			/* Rows of two pixels, keep one pixel per row at the clip edge */
+			if (!topVisible || !bottomVisible)
+			{
+				for (counter = 0; counter < count; counter++)
+				{
+					pixel[counter] = pixel[(2 * counter) + (topVisible ? 0 : 1)];
+				}
+			}
+			
+			ST7789_Disp_SetWindowAddress(hlcd, (uint16_t)(topVisible ? minor : (minor + 1)), (uint16_t)runStart, (uint16_t)(bottomVisible ? (minor + 1) : minor), (uint16_t)(major - 1));
+			
+		}
+		else
+		{
+			
+			/* Two rows, the second follows the first */
+			if (topVisible && bottomVisible)
+			{
+				for (counter = 0; counter < count; counter++)
+				{
+					pixel[count + counter] = pixel[(bandLength / 2) + counter];
+				}
+			}
+			else if (!topVisible)
+			{
+				pixel += bandLength / 2;
+			}
+			
+			ST7789_Disp_SetWindowAddress(hlcd, (uint16_t)runStart, (uint16_t)(topVisible ? minor : (minor + 1)), (uint16_t)(major - 1), (uint16_t)(bottomVisible ? (minor + 1) : minor));
+			
+		}
+		
+		ST7789_TransmitData(hlcd, (uint8_t *)pixel, (uint32_t)count * (topVisible + bottomVisible) * sizeof(uint16_t));
+		
+		/* One band: The next run writes the same memory */
+		if (band[0] == band[1])
+		{
+			ST7789_Disp_WaitForTransfer(hlcd);
+		}
+		
+		bandIndex ^= 1;
+		
+	}
+	
+	ST7789_OS_UNLOCK(hlcd);
+	
+}
+
+void ST7789_Disp_DrawThickLine(ST7789_HandleTypeDef *hlcd, int16_t XStart, int16_t YStart, int16_t XEnd, int16_t YEnd, uint8_t Width, ST7789_LineCapTypeDef Cap, ST7789_ColorTypeDef Color)
+{
+	
+	int32_t  dx        = (int32_t)XEnd - XStart;
+	int32_t  dy        = (int32_t)YEnd - YStart;
+	int32_t  halfWidth = (int32_t)Width * 128; // 8.8 fixed point
+	int32_t  length;
+	int32_t  normalX;
+	int32_t  normalY;
+	int32_t  extendX   = 0;
+	int32_t  extendY   = 0;
+	int32_t  cornerX[4];
+	int32_t  cornerY[4];
+	int32_t  yMin;
+	int32_t  yMax;
+	int32_t  yCenter;
+	int32_t  left;
+	int32_t  right;
+	int32_t  half;
+	int32_t  row;
+	int32_t  rowEnd;
+	int32_t  xStart8   = ((int32_t)XStart * 256) + 128; // Center of the pixel
+	int32_t  yStart8   = ((int32_t)YStart * 256) + 128;
+	int32_t  xEnd8     = ((int32_t)XEnd * 256) + 128;
+	int32_t  yEnd8     = ((int32_t)YEnd * 256) + 128;
+	uint8_t  edge;
+	uint8_t  next;
+	
+	ST7789_AreaTypeDef clip;
+	
+	if (Width == 0)
+	{
+		return;
+	}
+	
+	/* -------- Normal and Cap Extension (8.8 Fixed Point) ------- */
+	length = (int32_t)ST7789_Sqrt64((((uint64_t)((int64_t)dx * dx) + (uint64_t)((int64_t)dy * dy)) << 8)); // Length in 1/16 pixel
+	
+	if (length == 0)
+	{
+		
+		/* A point: Square or round dot */
+		normalX = 0;
+		normalY = halfWidth;
+		extendX = (Cap == ST7789_CAP_ROUND) ? 0 : halfWidth;
+		
+	}
+	else
+	{
+		
+		normalX = (int32_t)(((int64_t)-dy * 16 * halfWidth) / length);
+		normalY = (int32_t)(((int64_t)dx * 16 * halfWidth) / length);
+		
+		if (Cap == ST7789_CAP_SQUARE)
+		{
+			extendX = normalY;
+			extendY = -normalX;
+		}
+		
+	}
+	
+	/* ------------ Corners of the Line Body -------------- */
+	cornerX[0] = xStart8 + normalX - extendX;
+	cornerY[0] = yStart8 + normalY - extendY;
+	cornerX[1] = xEnd8 + normalX + extendX;
+	cornerY[1] = yEnd8 + normalY + extendY;
+	cornerX[2] = xEnd8 - normalX + extendX;
+	cornerY[2] = yEnd8 - normalY + extendY;
+	cornerX[3] = xStart8 - normalX - extendX;
+	cornerY[3] = yStart8 - normalY - extendY;
+	
+	yMin = cornerY[0];
+	yMax = cornerY[0];
+	
+	for (edge = 1; edge < 4; edge++)
+	{
+		yMin = (cornerY[edge] < yMin) ? cornerY[edge] : yMin;
+		yMax = (cornerY[edge] > yMax) ? cornerY[edge] : yMax;
+	}
+	
+	if (Cap == ST7789_CAP_ROUND)
+	{
+		yMin = (((yStart8 < yEnd8) ? yStart8 : yEnd8) - halfWidth < yMin) ? (((yStart8 < yEnd8) ? yStart8 : yEnd8) - halfWidth) : yMin;
+		yMax = (((yStart8 > yEnd8) ? yStart8 : yEnd8) + halfWidth > yMax) ? (((yStart8 > yEnd8) ? yStart8 : yEnd8) + halfWidth) : yMax;
+	}
+	
+	ST7789_OS_LOCK(hlcd);
+	
+	/* Rows with the pixel center inside, the rows outside of the clip area are not walked */
+	clip   = ST7789_ClipArea(hlcd);
+	row    = (yMin + 127) >> 8;
+	rowEnd = (yMax - 128) >> 8;
+	row    = (row < clip.YStart) ? clip.YStart : row;
+	rowEnd = (rowEnd > clip.YEnd) ? clip.YEnd : rowEnd;
+	
+	/* ------- One Span per Row: The Line is Convex ------- */
+	for (; row <= rowEnd; row++)
+	{
+		
+		yCenter = (row * 256) + 128;
+		left    = INT32_MAX;
+		right   = INT32_MIN;
+		
+		/* ~~~~~~~~~~~~~~~~~~~~~~~~~ Body ~~~~~~~~~~~~~~~~~~~~~~~~~ */
+		for (edge = 0; edge < 4; edge++)
+		{
+			
+			next = (edge + 1) & 3;
+			
+			/* Edges are half open, a horizontal edge adds nothing */
+			if (((cornerY[edge] <= yCenter) && (cornerY[next] > yCenter)) || ((cornerY[next] <= yCenter) && (cornerY[edge] > yCenter)))
+			{
+				
+				half  = cornerX[edge] + (int32_t)(((int64_t)(yCenter - cornerY[edge]) * (cornerX[next] - cornerX[edge])) / (cornerY[next] - cornerY[edge]));
+				left  = (half < left) ? half : left;
+				right = (half > right) ? half : right;
+				
+			}
+			
+		}
+		
+		/* ~~~~~~~~~~~~~~~~~~~~~~~ Round Caps ~~~~~~~~~~~~~~~~~~~~~~ */
+		if (Cap == ST7789_CAP_ROUND)
+		{
+			
+			for (edge = 0; edge < 2; edge++)
+			{
+				
+				dy = yCenter - (edge ? yEnd8 : yStart8);
+				
+				if (abs(dy) < halfWidth)
+				{
+					
+					half  = (int32_t)ST7789_Sqrt((uint32_t)(halfWidth * halfWidth - dy * dy));
+					dx    = edge ? xEnd8 : xStart8;
+					left  = ((dx - half) < left) ? (dx - half) : left;
+					right = ((dx + half) > right) ? (dx + half) : right;
+					
+				}
+				
+			}
+			
+		}
+		
+		/* Pixels with the center inside */
+		if (left <= right)
+		{
+			ST7789_FillClipped(hlcd, (left + 127) >> 8, row, (right - 128) >> 8, row, Color);
+		}
+		
+	}
+	
+	ST7789_OS_UNLOCK(hlcd);
+	
+}
+
+void ST7789_Disp_DrawRectangle(ST7789_HandleTypeDef *hlcd, uint16_t XStart, uint16_t YStart, uint16_t XEnd, uint16_t YEnd, ST7789_ColorTypeDef Color)
+{
+	
+	ST7789_OS_LOCK(hlcd);
+	
+	/* ------------ Write Rectangle Lines ----------- */
+	ST7789_Disp_DrawLine(hlcd, XStart, YStart, XEnd, YStart, Color);
+	ST7789_Disp_DrawLine(hlcd, XStart, YStart, XStart, YEnd, Color);
+	ST7789_Disp_DrawLine(hlcd, XStart, YEnd, XEnd, YEnd, Color);
+	ST7789_Disp_DrawLine(hlcd, XEnd, YStart, XEnd, YEnd, Color);
+	
+	ST7789_OS_UNLOCK(hlcd);
+	
+}
+
+void ST7789_Disp_DrawFilledRectangle(ST7789_HandleTypeDef *hlcd, uint16_t XPos, uint16_t YPos, uint16_t Width, uint16_t Height, ST7789_ColorTypeDef Color)
+{
+	
+	uint8_t heightCounter;
+	
+	/* -------------- Position Control -------------- */
+	if (XPos >= hlcd->Width || YPos >= hlcd->Height)
+	{
+		return;
+	}
+	
+	ST7789_OS_LOCK(hlcd);
+	
+	/* ---------------- Size Control ---------------- */
+	if ((XPos + Width) >= hlcd->Width)
+	{
+		Width = hlcd->Width - XPos;
+	}
+	
+	if ((YPos + Height) >= hlcd->Height)
+	{
+		Height = hlcd->Height - YPos;
+	}
+	
+	/* ----------------- Draw Lines ----------------- */
+	for (heightCounter = 0; heightCounter <= Height; heightCounter++)
+	{
+		ST7789_Disp_DrawLine(hlcd, XPos, YPos + heightCounter, XPos + Width, YPos + heightCounter, Color);
+	}
+	
+	ST7789_OS_UNLOCK(hlcd);
+	
+}
+
+void ST7789_Disp_DrawCircle(ST7789_HandleTypeDef *hlcd, uint16_t XPos, uint16_t YPos, uint8_t Radius, ST7789_ColorTypeDef Color)
+{
+	
+	int16_t f = 1 - Radius;
+	int16_t ddF_x = 1;
+	int16_t ddF_y = -2 * Radius;
+	int16_t x = 0;
+	int16_t y = Radius;
+	
+	ST7789_OS_LOCK(hlcd);
+	
+	/* ------------ Write Circle Pixels ------------- */
+	ST7789_Disp_DrawPixel(hlcd, XPos, YPos + Radius, Color);
+	ST7789_Disp_DrawPixel(hlcd, XPos, YPos - Radius, Color);
+	ST7789_Disp_DrawPixel(hlcd, XPos + Radius, YPos, Color);
+	ST7789_Disp_DrawPixel(hlcd, XPos - Radius, YPos, Color);
+	
+	while (x < y)
+	{
+		
+		if (f >= 0)
+		{
+			y--;
+			ddF_y += 2;
+			f += ddF_y;
+		}
+		
+		x++;
+		ddF_x += 2;
+		f += ddF_x;
+
+		ST7789_Disp_DrawPixel(hlcd, XPos + x, YPos + y, Color);
+		ST7789_Disp_DrawPixel(hlcd, XPos - x, YPos + y, Color);
+		ST7789_Disp_DrawPixel(hlcd, XPos + x, YPos - y, Color);
+		ST7789_Disp_DrawPixel(hlcd, XPos - x, YPos - y, Color);
+
+		ST7789_Disp_DrawPixel(hlcd, XPos + y, YPos + x, Color);
+		ST7789_Disp_DrawPixel(hlcd, XPos - y, YPos + x, Color);
+		ST7789_Disp_DrawPixel(hlcd, XPos + y, YPos - x, Color);
+		ST7789_Disp_DrawPixel(hlcd, XPos - y, YPos - x, Color);
+		
+	}
+	
+	ST7789_OS_UNLOCK(hlcd);
+	
+}
+
+void ST7789_Disp_DrawFilledCircle(ST7789_HandleTypeDef *hlcd, int16_t XPos, int16_t YPos, int16_t Radius, ST7789_ColorTypeDef Color)
+{
+	
+	int16_t f = 1 - Radius;
+	int16_t ddF_x = 1;
+	int16_t ddF_y = -2 * Radius;
+	int16_t x = 0;
+	int16_t y = Radius;
+	
+	ST7789_OS_LOCK(hlcd);
+	
+	/* ------------ Write Circle Pixels ------------- */
+	ST7789_Disp_DrawPixel(hlcd, XPos, YPos + Radius, Color);
+	ST7789_Disp_DrawPixel(hlcd, XPos, YPos - Radius, Color);
+	ST7789_Disp_DrawPixel(hlcd, XPos + Radius, YPos, Color);
+	ST7789_Disp_DrawPixel(hlcd, XPos - Radius, YPos, Color);
+	ST7789_Disp_DrawLine(hlcd, XPos - Radius, YPos, XPos + Radius, YPos, Color);
+	
+	while (x < y)
+	{
+		
+		if (f >= 0)
+		{
+			y--;
+			ddF_y += 2;
+			f += ddF_y;
+		}
+		
+		x++;
+		ddF_x += 2;
+		f += ddF_x;
+		
+		ST7789_Disp_DrawLine(hlcd, XPos - x, YPos + y, XPos + x, YPos + y, Color);
+		ST7789_Disp_DrawLine(hlcd, XPos + x, YPos - y, XPos - x, YPos - y, Color);
+		
+		ST7789_Disp_DrawLine(hlcd, XPos + y, YPos + x, XPos - y, YPos + x, Color);
+		ST7789_Disp_DrawLine(hlcd, XPos + y, YPos - x, XPos - y, YPos - x, Color);
+		
+	}
+	
+	ST7789_OS_UNLOCK(hlcd);
+	
+}
+
+void ST7789_Disp_DrawTriangle(ST7789_HandleTypeDef *hlcd, uint16_t X1, uint16_t Y1, uint16_t X2, uint16_t Y2, uint16_t X3, uint16_t Y3, ST7789_ColorTypeDef Color)
+{
+	
+	ST7789_OS_LOCK(hlcd);
+	
+	/* ----------------- Draw Lines ----------------- */
+	ST7789_Disp_DrawLine(hlcd, X1, Y1, X2, Y2, Color);
+	ST7789_Disp_DrawLine(hlcd, X2, Y2, X3, Y3, Color);
+	ST7789_Disp_DrawLine(hlcd, X3, Y3, X1, Y1, Color);
+	
+	ST7789_OS_UNLOCK(hlcd);
+	
+}
+
+void ST7789_Disp_DrawFilledTriangle(ST7789_HandleTypeDef *hlcd, uint16_t X1, uint16_t Y1, uint16_t X2, uint16_t Y2, uint16_t X3, uint16_t Y3, ST7789_ColorTypeDef Color)
+{
+	
+	int16_t deltaX    = abs(X2 - X1);
+	int16_t deltaY    = abs(Y2 - Y1);
+	int16_t xUpdate1  = 0, xUpdate2 = 0;
+	int16_t yUpdate1  = 0, yUpdate2 = 0;
+	int16_t deltaNum  = 0, num = 0, numToAdd = 0;
+	int16_t numPixels = 0, pixelCounter = 0;
+	
+	ST7789_OS_LOCK(hlcd);
+	
+	/* ----------------- Draw Lines ----------------- */
+	if (X2 >= X1)
+	{
+		xUpdate1 = 1;
+		xUpdate2 = 1;
+	}
+	else
+	{
+		xUpdate1 = -1;
+		xUpdate2 = -1;
+	}
+
+	if (Y2 >= Y1)
+	{
+		yUpdate1 = 1;
+		yUpdate2 = 1;
+	}
+	else
+	{
+		yUpdate1 = -1;
+		yUpdate2 = -1;
+	}
+
+	if (deltaX >= deltaY)
+	{
+		xUpdate1  = 0;
+		yUpdate2  = 0;
+		deltaNum  = deltaX;
+		num       = deltaX / 2;
+		numToAdd  = deltaY;
+		numPixels = deltaX;
+	}
+	else
+	{
+		xUpdate2  = 0;
+		yUpdate1  = 0;
+		deltaNum  = deltaY;
+		num       = deltaY / 2;
+		numToAdd  = deltaX;
+		numPixels = deltaY;
+	}
+
+	for (pixelCounter = 0; pixelCounter <= numPixels; pixelCounter++)
+	{
+		
+		ST7789_Disp_DrawLine(hlcd, X1, Y1, X3, Y3, Color);
+
+		num += numToAdd;
+		
+		if (num >= deltaNum)
+		{
+			num -= deltaNum;
+			X1  += xUpdate1;
+			Y1  += yUpdate1;
+		}
+		
+		X1 += xUpdate2;
+		Y1 += yUpdate2;
+		
+	}
+	
+	ST7789_OS_UNLOCK(hlcd);
+	
+}
+
+/* ........................... Image ........................... */
+static void ST7789_PutRun(ST7789_HandleTypeDef *hlcd, uint16_t XPos, uint16_t YPos, uint16_t Width, uint16_t Rows, uint16_t Stride, const uint16_t *Pixels)
+{
+	
+	ST7789_AreaTypeDef clip = ST7789_ClipArea(hlcd);
+	
+	uint32_t xEnd = (uint32_t)XPos + Width - 1;
+	uint32_t yEnd = (uint32_t)YPos + Rows - 1;
+	
+	/* ------------- Clip to the Top Area ----------- */
+	if ((Width == 0) || (Rows == 0) || (clip.XStart > clip.XEnd) || (clip.YStart > clip.YEnd) ||
+	    (XPos > clip.XEnd) || (YPos > clip.YEnd) || (xEnd < clip.XStart) || (yEnd < clip.YStart))
+	{
+		return;
+	}
+	
+	if (YPos < clip.YStart)
+	{
+		Pixels += (uint32_t)(clip.YStart - YPos) * Stride;
+		YPos    = clip.YStart;
+	}
+	
+	if (XPos < clip.XStart)
+	{
+		Pixels += clip.XStart - XPos;
+		XPos    = clip.XStart;
+	}
+	
+	xEnd  = (xEnd > clip.XEnd) ? clip.XEnd : xEnd;
+	yEnd  = (yEnd > clip.YEnd) ? clip.YEnd : yEnd;
+	Width = (uint16_t)(xEnd - XPos + 1);
+	Rows  = (uint16_t)(yEnd - YPos + 1);
+	
+	/* --------- Narrow Window from the Image ------- */
+	ST7789_Disp_SetWindowAddress(hlcd, XPos, YPos, (uint16_t)xEnd, (uint16_t)yEnd);
+	
+	/* Whole rows follow each other in the image */
+	if (Width == Stride)
+	{
+		
+		ST7789_TransmitData(hlcd, (uint8_t *)Pixels, sizeof(uint16_t) * Width * Rows);
+		return;
+		
+	}
+	
+	/* Cut rows: The memory write continues with the next row of the image */
+	for (; Rows > 0; Rows--)
+	{
+		
+		ST7789_TransmitData(hlcd, (uint8_t *)Pixels, sizeof(uint16_t) * Width);
+		Pixels += Stride;
+		
+	}
+	
+}
+
+void ST7789_Disp_PutImage(ST7789_HandleTypeDef *hlcd, uint16_t XPos, uint16_t YPos, uint16_t Width, uint16_t Height, const uint16_t *Image)
+{
+	
+	ST7789_OS_LOCK(hlcd);
+	
+	/* ---------- Write the Visible Image Data ------- */
+	ST7789_PutRun(hlcd, XPos, YPos, Width, Height, Width, Image);
+	
+	ST7789_OS_UNLOCK(hlcd);
+	
+}
+
+ST7789_StatusTypeDef ST7789_Disp_FillPolygon(ST7789_HandleTypeDef *hlcd, const ST7789_PointTypeDef *Points, uint16_t Count, ST7789_FillRuleTypeDef Rule, ST7789_ColorTypeDef Color, ST7789_EdgeTypeDef *Edges, uint16_t EdgeCount)
+{
+	
+	ST7789_EdgeTypeDef  edge;
+	const ST7789_PointTypeDef *top;
+	const ST7789_PointTypeDef *bottom;
+	
+	int32_t  height;
+	int64_t  delta;
+	uint16_t edges = 0;
+	uint16_t active;
+	uint16_t pending;
+	uint16_t counter;
+	uint16_t sortCounter;
+	int32_t  row;
+	int32_t  rowEnd = INT32_MIN;
+	int64_t  spanStart;
+	int16_t  winding;
+	
+	ST7789_AreaTypeDef clip;
+	
+	if ((Points == NULL) || (Count < 3) || (Edges == NULL))
+	{
+		return ST7789_ERROR;
+	}
+	
+	/* -------------------- Edge Table -------------------- */
+	for (counter = 0; counter < Count; counter++)
+	{
+		
+		top    = &Points[counter];
+		bottom = &Points[(counter + 1) % Count];
+		
+		/* A horizontal edge crosses no row center */
+		if (top->Y == bottom->Y)
+		{
+			continue;
+		}
+		
+		if (edges == EdgeCount)
+		{
+			return ST7789_ERROR;
+		}
+		
+		edge.Winding = 1;
+		
+		if (top->Y > bottom->Y)
+		{
+			
+			top          = bottom;
+			bottom       = &Points[counter];
+			edge.Winding = -1;
+			
+		}
+		
+		/* ~~~~~~~~ Exact Steps: X and Step are Rounded Down, the Rest is in the Error ~~~~~~~~ */
+		height         = (int32_t)bottom->Y - top->Y;
+		delta          = ((int64_t)bottom->X - top->X) * 65536;
+		edge.Step      = delta / height;
+		edge.Remainder = (int32_t)(delta % height);
+		
+		if (edge.Remainder < 0)
+		{
+			edge.Step--;
+			edge.Remainder += height;
+		}
+		
+		/* X at the center of the first row, the vertices are the corners of the pixels */
+		delta      = delta / 2;
+		edge.X     = delta / height;
+		edge.Error = (int32_t)(delta % height);
+		
+		if (edge.Error < 0)
+		{
+			edge.X--;
+			edge.Error += height;
+		}
+		
+		edge.X     += (int64_t)top->X * 65536;
+		edge.YStart = top->Y;
+		edge.YEnd   = bottom->Y;
+		
+		rowEnd = (edge.YEnd > rowEnd) ? edge.YEnd : rowEnd;
+		
+		/* ~~~~~~~~~~~~~~~~ Sorted by the First Row ~~~~~~~~~~~~~~~~ */
+		for (sortCounter = edges; (sortCounter > 0) && (Edges[sortCounter - 1].YStart > edge.YStart); sortCounter--)
+		{
+			Edges[sortCounter] = Edges[sortCounter - 1];
+		}
+		
+		Edges[sortCounter] = edge;
+		edges++;
+		
+	}
+	
+	if (edges == 0)
+	{
+		return ST7789_OK;
+	}
+	
+	ST7789_OS_LOCK(hlcd);
+	
+	/* The rows below the clip area are not walked */
+	clip   = ST7789_ClipArea(hlcd);
+	rowEnd = (rowEnd > (clip.YEnd + 1)) ? (clip.YEnd + 1) : rowEnd;
+	
+	/*
+		Edges[0 ... active - 1]      : Active edges, sorted by X on every row
+		Edges[active ... pending - 1] : Finished edges
+		Edges[pending ... edges - 1]  : Edges below the current row
+	*/
+	active  = 0;
+	pending = 0;
+	
+	for (row = Edges[0].YStart; row < rowEnd; row++)
+	{
+		
+		/* ------------- Add and Remove Edges ------------- */
+		while ((pending < edges) && (Edges[pending].YStart <= row))
+		{
+			Edges[active++] = Edges[pending++];
+		}
+		
+		for (counter = 0; counter < active;)
+		{
+			
+			if (Edges[counter].YEnd <= row)
+			{
+				Edges[counter] = Edges[--active];
+			}
+			else
+			{
+				counter++;
+			}
+			
+		}
+		
+		/* -------- Sort by X (Nearly Sorted from the Last Row) -------- */
+		for (counter = 1; counter < active; counter++)
+		{
+			
+			edge = Edges[counter];
+			
+			for (sortCounter = counter; (sortCounter > 0) && (Edges[sortCounter - 1].X > edge.X); sortCounter--)
+			{
+				Edges[sortCounter] = Edges[sortCounter - 1];
+			}
+			
+			Edges[sortCounter] = edge;
+			
+		}
+		
+		/* ------ Spans Between the Crossings (Pixel Centers Inside) ------ */
+		if (row >= clip.YStart)
+		{
+			
+			winding   = 0;
+			spanStart = 0;
+			
+			for (counter = 0; counter < active; counter++)
+			{
+				
+				if (winding == 0)
+				{
+					spanStart = Edges[counter].X;
+				}
+				
+				if (Rule == ST7789_FILL_EVEN_ODD)
+				{
+					winding ^= 1;
+				}
+				else
+				{
+					winding += Edges[counter].Winding;
+				}
+				
+				if (winding == 0)
+				{
+					ST7789_FillClipped(hlcd, (int32_t)((spanStart + 32767) >> 16), row, (int32_t)((Edges[counter].X + 32767) >> 16) - 1, row, Color);
+				}
+				
+			}
+			
+		}
+		
+		/* ------------------- Next Row ------------------- */
+		for (counter = 0; counter < active; counter++)
+		{
+			
+			Edges[counter].X     += Edges[counter].Step;
+			Edges[counter].Error += Edges[counter].Remainder;
+			
+			if (Edges[counter].Error >= (Edges[counter].YEnd - Edges[counter].YStart))
+			{
+				Edges[counter].X++;
+				Edges[counter].Error -= Edges[counter].YEnd - Edges[counter].YStart;
+			}
+			
+		}
+		
+	}
+	
+	ST7789_OS_UNLOCK(hlcd);
+	
+	return ST7789_OK;
+	
+}
+
+void ST7789_Disp_DrawPolyline(ST7789_HandleTypeDef *hlcd, const ST7789_PointTypeDef *Points, uint16_t Count, uint8_t Width, ST7789_ColorTypeDef Color)
+{
+	
+	uint16_t counter;
+	
+	ST7789_OS_LOCK(hlcd);
+	
+	/* ------------- Round Caps Join the Segments ------------- */
+	for (counter = 1; counter < Count; counter++)
+	{
+		
+		if (Width <= 1)
+		{
+			ST7789_Disp_DrawLine(hlcd, Points[counter - 1].X, Points[counter - 1].Y, Points[counter].X, Points[counter].Y, Color);
+		}
+		else
+		{
+			ST7789_Disp_DrawThickLine(hlcd, Points[counter - 1].X, Points[counter - 1].Y, Points[counter].X, Points[counter].Y, Width, ST7789_CAP_ROUND, Color);
+		}
+		
+	}
+	
+	ST7789_OS_UNLOCK(hlcd);
+	
+}
+
+static void ST7789_Sine(int16_t Angle, int32_t *Cos, int32_t *Sin)
+{
+	
+	int32_t angle = Angle % 360;
+	int32_t quadrant;
+	
+	angle    = (angle < 0) ? (angle + 360) : angle;
+	quadrant = angle / 90;
+	angle    = angle % 90;
+	
+	/* -------------- Quarter Wave Table ------------- */
+	switch (quadrant)
+	{
+		
+		case 0:  *Cos =  ST7789_SineTable[90 - angle]; *Sin =  ST7789_SineTable[angle];      break;
+		case 1:  *Cos = -ST7789_SineTable[angle];      *Sin =  ST7789_SineTable[90 - angle]; break;
+		case 2:  *Cos = -ST7789_SineTable[90 - angle]; *Sin = -ST7789_SineTable[angle];      break;
+		default: *Cos =  ST7789_SineTable[angle];      *Sin = -ST7789_SineTable[90 - angle]; break;
+		
+	}
+	
+}
+
+static int32_t ST7789_EllipseExtent(int32_t Extent, int32_t Dy, int32_t XRadius, int32_t YRadius)
+{
+	
+	/*
+		Last pixel of the row inside the ellipse with the radii + 0.5:
+		(2x)^2 * (2RY + 1)^2 + (2Dy)^2 * (2RX + 1)^2 <= (2RX + 1)^2 * (2RY + 1)^2
+		The extent only grows while Dy goes to the center.
+	*/
+	int64_t xAxis2 = (int64_t)((2 * XRadius) + 1) * ((2 * XRadius) + 1);
+	int64_t yAxis2 = (int64_t)((2 * YRadius) + 1) * ((2 * YRadius) + 1);
+	int64_t rowPart = ((int64_t)4 * Dy * Dy) * xAxis2;
+	
+	while (((((int64_t)4 * (Extent + 1) * (Extent + 1)) * yAxis2) + rowPart) <= (xAxis2 * yAxis2))
+	{
+		Extent++;
+	}
+	
+	return Extent;
+	
+}
+
+static void ST7789_DrawRoundBox(ST7789_HandleTypeDef *hlcd, int32_t XLeft, int32_t YTop, int32_t XRight, int32_t YBottom, int32_t XRadius, int32_t YRadius, uint8_t Filled, ST7789_ColorTypeDef Color)
+{
+	
+	/*
+		A box with a quarter ellipse at every corner, the corner centers are
+		(XLeft, YTop) ... (XRight, YBottom). Rounded rectangle: RX = RY,
+		ellipse: One center.
+	*/
+	int32_t dy;
+	int32_t extent     = 0;
+	int32_t lastExtent = 0;
+	int32_t start;
+	uint8_t rowCounter;
+	
+	/* Far outside of any panel, the extent test stays in 64 bits */
+	XRadius = (XRadius > 16383) ? 16383 : XRadius;
+	YRadius = (YRadius > 16383) ? 16383 : YRadius;
+	
+	ST7789_OS_LOCK(hlcd);
+	
+	/* ---------------- Corner Rows (Top and Bottom) --------------- */
+	for (dy = YRadius; dy >= (Filled ? 1 : 0); dy--)
+	{
+		
+		extent = ST7789_EllipseExtent(extent, dy, XRadius, YRadius);
+		
+		for (rowCounter = 0; rowCounter < 2; rowCounter++)
+		{
+			
+			/* The middle row of an ellipse is drawn once */
+			if (rowCounter && ((YBottom + dy) == (YTop - dy)))
+			{
+				break;
+			}
+			
+			if (Filled || (dy == YRadius))
+			{
+				ST7789_FillClipped(hlcd, XLeft - extent, rowCounter ? (YBottom + dy) : (YTop - dy), XRight + extent, rowCounter ? (YBottom + dy) : (YTop - dy), Color);
+			}
+			else
+			{
+				
+				/* ~~~~~~~~~~~~ Outline: From the Extent of the Last Row to this Extent ~~~~~~~~~~~~ */
+				start = ((lastExtent + 1) < extent) ? (lastExtent + 1) : extent;
+				
+				ST7789_FillClipped(hlcd, XLeft - extent, rowCounter ? (YBottom + dy) : (YTop - dy), XLeft - start, rowCounter ? (YBottom + dy) : (YTop - dy), Color);
+				ST7789_FillClipped(hlcd, XRight + start, rowCounter ? (YBottom + dy) : (YTop - dy), XRight + extent, rowCounter ? (YBottom + dy) : (YTop - dy), Color);
+				
+			}
+			
+		}
+		
+		lastExtent = extent;
+		
+	}
+	
+	/* ------------------- Middle Rows ------------------ */
+	if (Filled)
+	{
+		ST7789_FillClipped(hlcd, XLeft - XRadius, YTop, XRight + XRadius, YBottom, Color);
+	}
+	else if ((YBottom - YTop) >= 2)
+	{
+		ST7789_FillClipped(hlcd, XLeft - XRadius, YTop + 1, XLeft - XRadius, YBottom - 1, Color);
+		ST7789_FillClipped(hlcd, XRight + XRadius, YTop + 1, XRight + XRadius, YBottom - 1, Color);
+	}
+	
+	ST7789_OS_UNLOCK(hlcd);
+	
+}
+
+static void ST7789_ArcSpan(ST7789_HandleTypeDef *hlcd, const ST7789_ArcSetupTypeDef *Setup, int32_t XPos, int32_t YPos, int32_t Dy, int32_t XFrom, int32_t XTo, ST7789_ColorTypeDef Color)
+{
+	
+	int32_t split[2];
+	int32_t pieceStart;
+	int32_t pieceEnd;
+	int32_t spanStart = 0;
+	uint8_t spanOpen  = 0;
+	uint8_t inside;
+	uint8_t afterStart;
+	uint8_t beforeEnd;
+	uint8_t splitCounter;
+	
+	if (Setup->Full)
+	{
+		
+		ST7789_FillClipped(hlcd, XPos + XFrom, YPos + Dy, XPos + XTo, YPos + Dy, Color);
+		return;
+		
+	}
+	
+	/*
+		Inside the sector: cross(Start, P) >= 0 and/or cross(End, P) <= 0 (And for a sweep
+		up to 180 degrees). Along the row each term changes once, at the crossing of its ray.
+	*/
+	split[0] = XTo + 1;
+	split[1] = XTo + 1;
+	
+	if (Setup->StartSin > 0)
+	{
+		split[0] = (int32_t)ST7789_FloorDiv(Setup->StartCos * Dy, Setup->StartSin) + 1;
+	}
+	else if (Setup->StartSin < 0)
+	{
+		split[0] = (int32_t)-ST7789_FloorDiv(-Setup->StartCos * Dy, Setup->StartSin);
+	}
+	
+	if (Setup->EndSin > 0)
+	{
+		split[1] = (int32_t)-ST7789_FloorDiv(-Setup->EndCos * Dy, Setup->EndSin);
+	}
+	else if (Setup->EndSin < 0)
+	{
+		split[1] = (int32_t)ST7789_FloorDiv(Setup->EndCos * Dy, Setup->EndSin) + 1;
+	}
+	
+	if (split[1] < split[0])
+	{
+		pieceEnd = split[0];
+		split[0] = split[1];
+		split[1] = pieceEnd;
+	}
+	
+	/* ---------- Test the First Pixel of Every Piece ---------- */
+	for (pieceStart = XFrom, splitCounter = 0; pieceStart <= XTo; pieceStart = pieceEnd + 1)
+	{
+		
+		while ((splitCounter < 2) && (split[splitCounter] <= pieceStart))
+		{
+			splitCounter++;
+		}
+		
+		pieceEnd = (splitCounter < 2) ? (split[splitCounter] - 1) : XTo;
+		pieceEnd = (pieceEnd > XTo) ? XTo : pieceEnd;
+		
+		afterStart = ((Setup->StartCos * Dy) - (Setup->StartSin * pieceStart)) >= 0;
+		beforeEnd  = ((Setup->EndCos * Dy) - (Setup->EndSin * pieceStart)) <= 0;
+		inside     = Setup->Wide ? (afterStart || beforeEnd) : (afterStart && beforeEnd);
+		
+		/* ~~~~~~~~~~~~ Neighbor Pieces Inside are One Span ~~~~~~~~~~~~ */
+		if (inside && !spanOpen)
+		{
+			spanStart = pieceStart;
+			spanOpen  = 1;
+		}
+		else if (!inside && spanOpen)
+		{
+			ST7789_FillClipped(hlcd, XPos + spanStart, YPos + Dy, XPos + pieceStart - 1, YPos + Dy, Color);
+			spanOpen = 0;
+		}
+		
+	}
+	
+	if (spanOpen)
+	{
+		ST7789_FillClipped(hlcd, XPos + spanStart, YPos + Dy, XPos + XTo, YPos + Dy, Color);
+	}
+	
+}
+
+void ST7789_Disp_DrawRoundRect(ST7789_HandleTypeDef *hlcd, int16_t XStart, int16_t YStart, int16_t XEnd, int16_t YEnd, uint16_t Radius, ST7789_ColorTypeDef Color)
+{
+	
+	/* ---------------- Size Control ---------------- */
+	if ((XStart > XEnd) || (YStart > YEnd))
+	{
+		return;
+	}
+	
+	Radius = (Radius > ((XEnd - XStart) / 2)) ? ((XEnd - XStart) / 2) : Radius;
+	Radius = (Radius > ((YEnd - YStart) / 2)) ? ((YEnd - YStart) / 2) : Radius;
+	
+	ST7789_DrawRoundBox(hlcd, XStart + Radius, YStart + Radius, XEnd - Radius, YEnd - Radius, Radius, Radius, 0, Color);
+	
+}
+
+void ST7789_Disp_FillRoundRect(ST7789_HandleTypeDef *hlcd, int16_t XStart, int16_t YStart, int16_t XEnd, int16_t YEnd, uint16_t Radius, ST7789_ColorTypeDef Color)
+{
+	
+	/* ---------------- Size Control ---------------- */
+	if ((XStart > XEnd) || (YStart > YEnd))
+	{
+		return;
+	}
+	
+	Radius = (Radius > ((XEnd - XStart) / 2)) ? ((XEnd - XStart) / 2) : Radius;
+	Radius = (Radius > ((YEnd - YStart) / 2)) ? ((YEnd - YStart) / 2) : Radius;
+	
+	ST7789_DrawRoundBox(hlcd, XStart + Radius, YStart + Radius, XEnd - Radius, YEnd - Radius, Radius, Radius, 1, Color);
+	
+}
+
+void ST7789_Disp_DrawEllipse(ST7789_HandleTypeDef *hlcd, int16_t XPos, int16_t YPos, uint16_t XRadius, uint16_t YRadius, ST7789_ColorTypeDef Color)
+{
+	ST7789_DrawRoundBox(hlcd, XPos, YPos, XPos, YPos, XRadius, YRadius, 0, Color);
+}
+
+void ST7789_Disp_FillEllipse(ST7789_HandleTypeDef *hlcd, int16_t XPos, int16_t YPos, uint16_t XRadius, uint16_t YRadius, ST7789_ColorTypeDef Color)
+{
+	ST7789_DrawRoundBox(hlcd, XPos, YPos, XPos, YPos, XRadius, YRadius, 1, Color);
+}
+
+void ST7789_Disp_DrawArc(ST7789_HandleTypeDef *hlcd, int16_t XPos, int16_t YPos, uint16_t Radius, uint16_t Width, int16_t StartAngle, int16_t EndAngle, ST7789_ColorTypeDef Color)
+{
+	
+	ST7789_ArcSetupTypeDef setup;
+	
+	int32_t sweep       = (int32_t)EndAngle - StartAngle;
+	int32_t radius      = (Radius > 16383) ? 16383 : Radius; // Far outside of any panel, the extent test stays in 64 bits
+	int32_t innerRadius = radius - Width;
+	int32_t outer       = 0;
+	int32_t inner       = 0;
+	int32_t dy;
+	int32_t rowDy;
+	uint8_t rowCounter;
+	
+	if ((Width == 0) || (sweep == 0))
+	{
+		return;
+	}
+	
+	/* ----------------- Sector of the Arc ----------------- */
+	setup.Full = (sweep >= 360) || (sweep <= -360);
+	sweep      = ((sweep % 360) + 360) % 360;
+	setup.Full = setup.Full || (sweep == 0);
+	setup.Wide = (sweep > 180);
+	
+	ST7789_Sine(StartAngle, &setup.StartCos, &setup.StartSin);
+	ST7789_Sine(EndAngle, &setup.EndCos, &setup.EndSin);
+	
+	ST7789_OS_LOCK(hlcd);
+	
+	/* ---------- Ring Rows from the Top and the Bottom to the Center ---------- */
+	for (dy = radius; dy >= 0; dy--)
+	{
+		
+		outer = ST7789_EllipseExtent(outer, dy, radius, radius);
+		
+		if (dy <= innerRadius)
+		{
+			inner = ST7789_EllipseExtent(inner, dy, innerRadius, innerRadius);
+		}
+		
+		for (rowCounter = 0; rowCounter < ((dy == 0) ? 1 : 2); rowCounter++)
+		{
+			
+			rowDy = rowCounter ? dy : -dy;
+			
+			if (dy > innerRadius)
+			{
+				ST7789_ArcSpan(hlcd, &setup, XPos, YPos, rowDy, -outer, outer, Color);
+			}
+			else
+			{
+				ST7789_ArcSpan(hlcd, &setup, XPos, YPos, rowDy, -outer, -inner - 1, Color);
+				ST7789_ArcSpan(hlcd, &setup, XPos, YPos, rowDy, inner + 1, outer, Color);
+			}
+			
+		}
+		
+	}
+	
+	ST7789_OS_UNLOCK(hlcd);
+	
+}
+
+void ST7789_Disp_WritePixels(ST7789_HandleTypeDef *hlcd, const uint16_t *Pixels, uint32_t Count)
+{
+	
+	if (Count == 0)
+	return;
+	
+	ST7789_OS_LOCK(hlcd);
+	
+	/* ----------- Continue the Memory Write -------- */
+	ST7789_TransmitData(hlcd, (uint8_t *)Pixels, sizeof(uint16_t) * Count);
+	
+	ST7789_OS_UNLOCK(hlcd);
+	
+}
+
+void ST7789_Disp_PutImage_Keyed(ST7789_HandleTypeDef *hlcd, uint16_t XPos, uint16_t YPos, const ST7789_KeyedImageTypeDef *Image)
+{
+	
+	const uint16_t *runs   = Image->Runs;
+	const uint16_t *pixels;
+	uint16_t        key    = (Image->Key >> 8) | ((Image->Key & 0xFF) << 8); // Big-endian like the image
+	
+	uint16_t row;
+	uint16_t rows;
+	uint16_t runCount;
+	uint16_t start;
+	uint16_t end;
+	
+	if ((Image->Width == 0) || (Image->Height == 0))
+	return;
+	
+	ST7789_OS_LOCK(hlcd);
+	
+	for (row = 0; row < Image->Height; row += rows)
+	{
+		
+		pixels = &Image->Data[(uint32_t)row * Image->Width];
+		rows   = 1;
+		
+		/* ~~~~~~~~~~~~~~~~~~~~ Run Table ~~~~~~~~~~~~~~~~~~~ */
+		if (runs != NULL)
+		{
+			
+			runCount = *runs++;
+			
+			/* Opaque rows follow each other in the image, one window sends them */
+			if ((runCount == 1) && (runs[0] == 0) && (runs[1] == Image->Width))
+			{
+				
+				while (((row + rows) < Image->Height) && (runs[2] == 1) && (runs[3] == 0) && (runs[4] == Image->Width))
+				{
+					runs += 3;
+					rows++;
+				}
+				
+				runs += 2;
+				
+				ST7789_PutRun(hlcd, XPos, YPos + row, Image->Width, rows, Image->Width, pixels);
+				continue;
+				
+			}
+			
+			while (runCount--)
+			{
+				
+				ST7789_PutRun(hlcd, XPos + runs[0], YPos + row, runs[1], 1, Image->Width, &pixels[runs[0]]);
+				runs += 2;
+				
+			}
+			
+		}
+		
+		/* ~~~~~~~~~~~~~~~~ Search the Key ~~~~~~~~~~~~~~~~~~ */
+		else
+		{
+			
+			for (start = 0; start < Image->Width; start = end)
+			{
+				
+				while ((start < Image->Width) && (pixels[start] == key))
+				{
+					start++;
+				}
+				
+				for (end = start; (end < Image->Width) && (pixels[end] != key); end++) { }
+				
+				if (end > start)
+				{
+					ST7789_PutRun(hlcd, XPos + start, YPos + row, end - start, 1, Image->Width, &pixels[start]);
+				}
+				
+			}
+			
+		}
+		
+	}
+	
+	ST7789_OS_UNLOCK(hlcd);
+	
+}
+
+uint32_t ST7789_KeyedImage_Build(ST7789_KeyedImageTypeDef *Image, uint16_t *Runs, uint32_t Length)
+{
+	
+	const uint16_t *pixels;
+	uint16_t        key  = (Image->Key >> 8) | ((Image->Key & 0xFF) << 8);
+	uint32_t        used = 0;
+	uint32_t        countIndex;
+	
+	uint16_t row;
+	uint16_t start;
+	uint16_t end;
+	
+	for (row = 0; row < Image->Height; row++)
+	{
+		
+		pixels = &Image->Data[(uint32_t)row * Image->Width];
+		
+		if (used >= Length)
+		{
+			return 0;
+		}
+		
+		countIndex       = used++;
+		Runs[countIndex] = 0;
+		
+		/* ------------- Opaque Runs of the Row --------- */
+		for (start = 0; start < Image->Width; start = end)
+		{
+			
+			while ((start < Image->Width) && (pixels[start] == key))
+			{
+				start++;
+			}
+			
+			for (end = start; (end < Image->Width) && (pixels[end] != key); end++) { }
+			
+			if (end == start)
+			{
+				continue;
+			}
+			
+			if ((used + 2) > Length)
+			{
+				return 0;
+			}
+			
+			Runs[used++] = start;
+			Runs[used++] = end - start;
+			Runs[countIndex]++;
+			
+		}
+		
+	}
+	
+	Image->Runs = Runs;
+	
+	return used;
+	
+}
+
+void ST7789_BlitKeyed(uint16_t *Dest, uint16_t DestWidth, uint16_t DestHeight, int16_t XPos, int16_t YPos, const ST7789_KeyedImageTypeDef *Image)
+{
+	
+	const uint16_t *src;
+	uint16_t       *dest;
+	uint16_t        key = (Image->Key >> 8) | ((Image->Key & 0xFF) << 8);
+	
+	int32_t  xStart = (XPos < 0) ? 0 : XPos;
+	int32_t  yStart = (YPos < 0) ? 0 : YPos;
+	int32_t  xEnd   = (int32_t)XPos + Image->Width - 1;
+	int32_t  yEnd   = (int32_t)YPos + Image->Height - 1;
+	int32_t  y;
+	uint32_t count;
+	
+	/* ---------------- Clip to the Buffer ---------- */
+	xEnd = (xEnd >= DestWidth) ? (DestWidth - 1) : xEnd;
+	yEnd = (yEnd >= DestHeight) ? (DestHeight - 1) : yEnd;
+	
+	if ((xStart > xEnd) || (yStart > yEnd))
+	{
+		return;
+	}
+	
+	/* --------------- Skip the Keyed Pixels -------- */
+	for (y = yStart; y <= yEnd; y++)
+	{
+		
+		src   = &Image->Data[(uint32_t)(y - YPos) * Image->Width + (uint32_t)(xStart - XPos)];
+		dest  = &Dest[(uint32_t)y * DestWidth + (uint32_t)xStart];
+		count = (uint32_t)(xEnd - xStart + 1);
+		
+		while (count--)
+		{
+			
+			if (*src != key)
+			{
+				*dest = *src;
+			}
+			
+			src++;
+			dest++;
+			
+		}
+		
+	}
+	
+}
+
+void ST7789_DrawLine_AA_Buffer(uint16_t *Dest, uint16_t DestWidth, uint16_t DestHeight, int16_t XStart, int16_t YStart, int16_t XEnd, int16_t YEnd, ST7789_ColorTypeDef Color)
+{
+	
+	uint8_t  steep = abs(YEnd - YStart) > abs(XEnd - XStart);
+	uint8_t  level;
+	uint8_t  pairCounter;
+	
+	int32_t  swap;
+	int64_t  gradient; // 16.16 fixed point, int64: The steps of a long line overflow 32 bits
+	int64_t  intery;
+	int32_t  major;
+	int32_t  majorEnd;
+	int32_t  minor;
+	int32_t  pixelX;
+	int32_t  pixelY;
+	uint16_t *pixel;
+	uint16_t color;
+	
+	/* ------------------ Swap XY ------------------- */
+	if (steep)
+	{
+		
+		swap   = XStart;
+		XStart = YStart;
+		YStart = (int16_t)swap;
+		
+		swap   = XEnd;
+		XEnd   = YEnd;
+		YEnd   = (int16_t)swap;
+		
+	}
+	
+	/* -------------- Swap XStart/XEnd -------------- */
+	if (XStart > XEnd)
+	{
+		
+		swap   = XStart;
+		XStart = XEnd;
+		XEnd   = (int16_t)swap;
+		
+		swap   = YStart;
+		YStart = YEnd;
+		YEnd   = (int16_t)swap;
+		
+	}
+	
+	gradient = (XEnd != XStart) ? (((int64_t)(YEnd - YStart) * 65536) / (XEnd - XStart)) : 0;
+	
+	/* The steps before the buffer are skipped */
+	major    = (XStart < 0) ? 0 : XStart;
+	majorEnd = steep ? DestHeight : DestWidth;
+	majorEnd = (XEnd < majorEnd) ? XEnd : (majorEnd - 1);
+	intery   = ((int64_t)YStart * 65536) + (gradient * (major - XStart));
+	
+	/* ------------- Blend the Pixel Pairs ------------ */
+	for (; major <= majorEnd; major++, intery += gradient)
+	{
+		
+		minor = (int32_t)(intery >> 16);
+		level = (uint8_t)((intery >> 11) & 0x1F);
+		
+		for (pairCounter = 0; pairCounter < 2; pairCounter++)
+		{
+			
+			pixelX = steep ? (minor + pairCounter) : major;
+			pixelY = steep ? major : (minor + pairCounter);
+			
+			if ((pixelX < 0) || (pixelX >= DestWidth) || (pixelY < 0) || (pixelY >= DestHeight))
+			{
+				continue;
+			}
+			
+			/* ~~~~~~~~~~~~~~~ Big-endian RGB565 in the buffer ~~~~~~~~~~~~~~~ */
+			pixel  = &Dest[(uint32_t)pixelY * DestWidth + pixelX];
+			color  = (*pixel >> 8) | ((*pixel & 0xFF) << 8);
+			color  = ST7789_Color_Blend(Color, color, (uint8_t)(((uint16_t)(pairCounter ? level : (32 - level)) * 255) / 32));
+			*pixel = (color >> 8) | ((color & 0xFF) << 8);
+			
+		}
+		
+	}
+	
+}
+
+/* ........................... Text ............................ */
+void ST7789_Disp_PutChar(ST7789_HandleTypeDef *hlcd, uint16_t XPos, uint16_t YPos, char Ch, ST7789_FontTypeDef Font, ST7789_ColorTypeDef Color, ST7789_ColorTypeDef BackgroundColor)
+{
+	
+	uint32_t heightCounter;
+	uint32_t widthCounter;
+	uint32_t fontByte;
+	
+	uint8_t colorBuff[2]   = {Color >> 8, Color & 0xFF};
+	uint8_t bgColorBuff[2] = {BackgroundColor >> 8, BackgroundColor & 0xFF};
+	
+	uint16_t *glyphPixel;
+	uint16_t  glyphColor   = (Color >> 8) | ((Color & 0xFF) << 8); // Big-endian for the LCD
+	uint16_t  glyphBgColor = (BackgroundColor >> 8) | ((BackgroundColor & 0xFF) << 8);
+	uint32_t  glyphRows;
+	uint32_t  rows;
+	uint32_t  rowCounter;
+	uint32_t  columnFirst;
+	uint32_t  columnEnd;
+	uint32_t  rowFirst;
+	uint32_t  rowEnd;
+	
+	ST7789_AreaTypeDef clip;
+	
+	ST7789_OS_LOCK(hlcd);
+	
+	/* ------- Visible Rows and Columns of the Glyph ------- */
+	clip = ST7789_ClipArea(hlcd);
+	
+	if ((clip.XStart > clip.XEnd) || (clip.YStart > clip.YEnd) || (XPos > clip.XEnd) || (YPos > clip.YEnd))
+	{
+		
+		ST7789_OS_UNLOCK(hlcd);
+		return;
+		
+	}
+	
+	columnFirst = (XPos < clip.XStart) ? (uint32_t)(clip.XStart - XPos) : 0;
+	rowFirst    = (YPos < clip.YStart) ? (uint32_t)(clip.YStart - YPos) : 0;
+	columnEnd   = (((uint32_t)XPos + Font.Width) > ((uint32_t)clip.XEnd + 1)) ? ((uint32_t)clip.XEnd + 1 - XPos) : Font.Width;
+	rowEnd      = (((uint32_t)YPos + Font.Height) > ((uint32_t)clip.YEnd + 1)) ? ((uint32_t)clip.YEnd + 1 - YPos) : Font.Height;
+	
+	if ((columnFirst >= columnEnd) || (rowFirst >= rowEnd))
+	{
+		
+		ST7789_OS_UNLOCK(hlcd);
+		return;
+		
+	}
+	
+	glyphRows = (hlcd->Buffer != NULL) ? (hlcd->BufferLength / (columnEnd - columnFirst)) : 0;
+	
+	/* --------------- Transmit Data ---------------- */
+	ST7789_Disp_SetWindowAddress(hlcd, XPos + columnFirst, YPos + rowFirst, XPos + columnEnd - 1, YPos + rowEnd - 1);
+	
+	/* ------- Render the rows in the buffer -------- */
+	if (glyphRows > 0)
+	{
+		
+		for (heightCounter = rowFirst; heightCounter < rowEnd; heightCounter += rows)
+		{
+			
+			rows = ((rowEnd - heightCounter) < glyphRows) ? (rowEnd - heightCounter) : glyphRows;
+			
+			/* The buffer may still be sent by the last transfer */
+			ST7789_Disp_WaitForTransfer(hlcd);
+			
+			glyphPixel = hlcd->Buffer;
+			
+			for (rowCounter = heightCounter; rowCounter < (heightCounter + rows); rowCounter++)
+			{
+				
+				fontByte = Font.Data[(Ch - 32) * Font.Height + rowCounter];
+				
+				for (widthCounter = columnFirst; widthCounter < columnEnd; widthCounter++)
+				{
+					*glyphPixel++ = ((fontByte << widthCounter) & 0x8000) ? glyphColor : glyphBgColor;
+				}
+				
+			}
+			
+			ST7789_TransmitData(hlcd, (uint8_t *)hlcd->Buffer, rows * (columnEnd - columnFirst) * sizeof(uint16_t));
+			
+		}
+		
+		ST7789_OS_UNLOCK(hlcd);
+		return;
+		
+	}
+
+	for (heightCounter = rowFirst; heightCounter < rowEnd; heightCounter++)
+	{
+		
+		fontByte = Font.Data[(Ch - 32) * Font.Height + heightCounter];
+		
+		for (widthCounter = columnFirst; widthCounter < columnEnd; widthCounter++)
+		{
+			
+			if ((fontByte << widthCounter) & 0x8000)
+			{
+				ST7789_TransmitData(hlcd, colorBuff, sizeof(colorBuff));
+			}
+			else
+			{
+				ST7789_TransmitData(hlcd, bgColorBuff, sizeof(bgColorBuff));
+			}
+			
+		}
+		
+	}
+	
+	ST7789_OS_UNLOCK(hlcd);
+	
+}
+
+void ST7789_Disp_PutString(ST7789_HandleTypeDef *hlcd, uint16_t XPos, uint16_t YPos, const char *Str, ST7789_FontTypeDef Font, ST7789_ColorTypeDef Color, ST7789_ColorTypeDef BackgroundColor)
+{
+	
+	ST7789_OS_LOCK(hlcd);
+	
+	/* --------------- Put Characters --------------- */
+	while (*Str)
+	{
+		
+		if (XPos + Font.Width >= hlcd->Width)
+		{
+			
+			XPos  = 0;
+			YPos += Font.Height;
+			
+			if (YPos + Font.Height >= hlcd->Height)
+			{
+				break;
+			}
+			
+			/* Skip space in the beginning of the new line */
+			if (*Str == ' ')
+			{
+				Str++;
+				continue;
+			}
+			
+		}
+		
+		ST7789_Disp_PutChar(hlcd, XPos, YPos, *Str, Font, Color, BackgroundColor);
+		
+		XPos += Font.Width;
+		Str++;
+		
+	}
+	
+	ST7789_OS_UNLOCK(hlcd);
+	
+}
+
+/* ......................... Readback .......................... */
+ST7789_StatusTypeDef ST7789_Disp_ReadRegion(ST7789_HandleTypeDef *hlcd, uint16_t XStart, uint16_t YStart, uint16_t XEnd, uint16_t YEnd, uint16_t *Buffer)
+{
+	
+	uint8_t  cmd = ST7789_CMD_RAMRD;
+	uint8_t  rgbStack[3 * ST7789_READ_CHUNK];
+	uint8_t *rgbBuff  = rgbStack;
+	uint16_t chunkMax = ST7789_READ_CHUNK;
+	uint32_t pixels;
+	uint16_t chunk;
+	uint16_t pixelCounter;
+	
+	/* ------------ Decode in the Scratch ----------- */
+	if (hlcd->ScratchSize > sizeof(rgbStack))
+	{
+		rgbBuff  = hlcd->Scratch;
+		chunkMax = (hlcd->ScratchSize < (3U * (UINT16_MAX / 3))) ? (hlcd->ScratchSize / 3) : (UINT16_MAX / 3);
+	}
+	
+	/* An even chunk ends on a whole word of a 16-bit bus, so the next chunk starts at a pixel */
+	chunkMax = (chunkMax > 1) ? (chunkMax & ~1U) : chunkMax;
+	
+	/* ---------------- Size Control ---------------- */
+	if ((XStart > XEnd) || (YStart > YEnd) || (XEnd >= hlcd->Width) || (YEnd >= hlcd->Height))
+	{
+		return ST7789_ERROR;
+	}
+	
+	pixels = (uint32_t)(XEnd - XStart + 1) * (YEnd - YStart + 1);
+	
+	ST7789_OS_LOCK(hlcd);
+	
+	ST7789_SetAddress(hlcd, XStart, YStart, XEnd, YEnd);
+	ST7789_Disp_WaitForTransfer(hlcd);
+	
+	/* ----------------- Read Pixels ---------------- */
+	while (pixels > 0)
+	{
+		
+		chunk = (pixels > chunkMax) ? chunkMax : pixels;
+		
+		/* The first chunk starts at the window, the next ones continue (RDMEMC) */
+		hlcd->Bus->Read(hlcd, cmd, rgbBuff, 3 * chunk);
+		cmd = ST7789_CMD_RDMEMC;
+		
+		/* ~~~~~~~~~~~~~~~ 18bit (RRRRRR--, GGGGGG--, BBBBBB--) to RGB565 ~~~~~~~~~~~~~~~ */
+		for (pixelCounter = 0; pixelCounter < chunk; pixelCounter++)
+		{
+			*Buffer++ = ST7789_Color_GetFromRGB(rgbBuff[3 * pixelCounter], rgbBuff[(3 * pixelCounter) + 1], rgbBuff[(3 * pixelCounter) + 2]);
+		}
+		
+		pixels -= chunk;
+		
+	}
+	
+	ST7789_OS_UNLOCK(hlcd);
+	
+	return ST7789_OK;
+	
+}
+
+ST7789_ColorTypeDef ST7789_Disp_ReadPixel(ST7789_HandleTypeDef *hlcd, uint16_t XPos, uint16_t YPos)
+{
+	
+	uint16_t color = ST7789_COLOR_BLACK;
+	
+	ST7789_Disp_ReadRegion(hlcd, XPos, YPos, XPos, YPos, &color);
+	
+	return (ST7789_ColorTypeDef)color;
+	
+}
+
+void ST7789_Disp_FillBlend(ST7789_HandleTypeDef *hlcd, uint16_t XStart, uint16_t YStart, uint16_t XEnd, uint16_t YEnd, ST7789_ColorTypeDef Color, uint8_t Alpha)
+{
+	
+	uint16_t  chunkBuff[ST7789_READ_CHUNK];
+	uint16_t *blendBuff  = (hlcd->Buffer != NULL) ? hlcd->Buffer : chunkBuff;
+	uint32_t  buffLength = (hlcd->Buffer != NULL) ? hlcd->BufferLength : ST7789_READ_CHUNK;
+	
+	uint32_t width;
+	uint32_t rows;
+	uint32_t columns;
+	uint32_t segWidth;
+	uint32_t segRows;
+	uint32_t xCounter;
+	uint32_t yCounter;
+	uint32_t pixelCounter;
+	uint32_t pixels;
+	uint16_t color;
+	
+	ST7789_AreaTypeDef clip;
+	
+	/* ---------------- Size Control ---------------- */
+	if ((XStart > XEnd) || (YStart > YEnd))
+	{
+		return;
+	}
+	
+	ST7789_OS_LOCK(hlcd);
+	
+	/* ------------- Clip to the Top Area ----------- */
+	clip   = ST7789_ClipArea(hlcd);
+	XStart = (XStart < clip.XStart) ? clip.XStart : XStart;
+	YStart = (YStart < clip.YStart) ? clip.YStart : YStart;
+	XEnd   = (XEnd > clip.XEnd) ? clip.XEnd : XEnd;
+	YEnd   = (YEnd > clip.YEnd) ? clip.YEnd : YEnd;
+	
+	if ((XStart > XEnd) || (YStart > YEnd))
+	{
+		
+		ST7789_OS_UNLOCK(hlcd);
+		return;
+		
+	}
+	
+	/* ------- Several rows or part of a row per pass ------- */
+	width    = (uint32_t)(XEnd - XStart + 1);
+	segWidth = (width <= buffLength) ? width : buffLength;
+	rows     = (width <= buffLength) ? (buffLength / width) : 1;
+	rows     = (rows < (uint32_t)(YEnd - YStart + 1)) ? rows : (uint32_t)(YEnd - YStart + 1);
+	
+	for (yCounter = YStart; yCounter <= YEnd; yCounter += rows)
+	{
+		
+		segRows = ((YEnd - yCounter + 1) < rows) ? (YEnd - yCounter + 1) : rows;
+		
+		for (xCounter = XStart; xCounter <= XEnd; xCounter += segWidth)
+		{
+			
+			columns = ((XEnd - xCounter + 1) < segWidth) ? (XEnd - xCounter + 1) : segWidth;
+			pixels  = (uint32_t)columns * segRows;
+			
+			/* ~~~~~~~~~~~~~~~~~~~~~~~~~ Read - Blend - Write ~~~~~~~~~~~~~~~~~~~~~~~~~ */
+			ST7789_Disp_WaitForTransfer(hlcd);
+			ST7789_Disp_ReadRegion(hlcd, xCounter, yCounter, xCounter + columns - 1, yCounter + segRows - 1, blendBuff);
+			
+			for (pixelCounter = 0; pixelCounter < pixels; pixelCounter++)
+			{
+				color = ST7789_Color_Blend(Color, (ST7789_ColorTypeDef)blendBuff[pixelCounter], Alpha);
+				blendBuff[pixelCounter] = (color >> 8) | ((color & 0xFF) << 8); // Big-endian for the LCD
+			}
+			
+			ST7789_Disp_SetWindowAddress(hlcd, xCounter, yCounter, xCounter + columns - 1, yCounter + segRows - 1);
+			ST7789_TransmitData(hlcd, (uint8_t *)blendBuff, pixels * sizeof(uint16_t));
+			
+		}
+		
+	}
+	
+	/* The stack chunk must not be sent after the return */
+	if (blendBuff == chunkBuff)
+	{
+		ST7789_Disp_WaitForTransfer(hlcd);
+	}
+	
+	ST7789_OS_UNLOCK(hlcd);
+	
+}
+
+void ST7789_Disp_DrawPixel_Blend(ST7789_HandleTypeDef *hlcd, uint16_t XPos, uint16_t YPos, ST7789_ColorTypeDef Color, uint8_t Alpha)
+{
+	
+	ST7789_AreaTypeDef clip;
+	
+	/* Another task must not draw between the read and the write */
+	ST7789_OS_LOCK(hlcd);
+	
+	/* ---------------- Size Control ---------------- */
+	clip = ST7789_ClipArea(hlcd);
+	
+	if ((XPos < clip.XStart) || (XPos > clip.XEnd) || (YPos < clip.YStart) || (YPos > clip.YEnd))
+	{
+		
+		ST7789_OS_UNLOCK(hlcd);
+		return;
+		
+	}
+	
+	ST7789_Disp_DrawPixel(hlcd, XPos, YPos, ST7789_Color_Blend(Color, ST7789_Disp_ReadPixel(hlcd, XPos, YPos), Alpha));
+	ST7789_OS_UNLOCK(hlcd);
+	
+}
+
+/* .......................... Staging .......................... */
+ST7789_StatusTypeDef ST7789_Disp_Staging_Enable(ST7789_HandleTypeDef *hlcd, uint16_t YStart, uint16_t Height)
+{
+	
+	uint16_t stripRow;
+	uint16_t areaRow;
+	uint16_t topMax    = 0;
+	uint16_t bottomMax = 0;
+	
+	/* ---------------- Size Control ---------------- */
+	if (Height == 0)
+	{
+		return ST7789_ERROR;
+	}
+	
+	ST7789_OS_LOCK(hlcd);
+	
+	/* Hidden rows are in the y-axis only in rotation 0 and 2 */
+	if ((hlcd->Rotation == 0) || (hlcd->Rotation == 2))
+	{
+		topMax    = hlcd->YOffset;
+		bottomMax = ST7789_HEIGHT_MAX - hlcd->Height - hlcd->YOffset;
+	}
+	
+	if ((YStart == 0) && (Height <= topMax))
+	{
+		hlcd->Staging.Offset = -(int16_t)Height; // Hidden rows above the strip
+	}
+	else if (((YStart + Height) == hlcd->Height) && (Height <= bottomMax))
+	{
+		hlcd->Staging.Offset = Height; // Hidden rows below the strip
+	}
+	else
+	{
+		
+		ST7789_OS_UNLOCK(hlcd);
+		return ST7789_ERROR;
+		
+	}
+	
+	/* ------------- Calculate Scroll Area ---------- */
+	/*
+		The scroll area holds the strip rows and the hidden rows (2 x Height), the
+		scroll start address selects which half is shown on the strip.
+	*/
+	stripRow = YStart + hlcd->YOffset;
+	areaRow  = (hlcd->Staging.Offset < 0) ? (stripRow - Height) : stripRow;
+	
+	if (hlcd->Rotation == 0)
+	{
+		areaRow = ST7789_HEIGHT_MAX - (areaRow + (2 * Height)); // MY: Rows are mirrored in the frame memory
+	}
+	
+	hlcd->Staging.YStart  = YStart;
+	hlcd->Staging.Height  = Height;
+	hlcd->Staging.TFA     = areaRow;
+	hlcd->Staging.Active  = 0;
+	hlcd->Staging.Shown   = 0;
+	hlcd->Staging.Enabled = 1;
+	
+	/* ------------- Set Scroll Registers ----------- */
+	ST7789_SetScrollArea(hlcd, areaRow, 2 * Height, ST7789_HEIGHT_MAX - areaRow - (2 * Height));
+	ST7789_SetScrollStart(hlcd, areaRow);
+	
+	ST7789_OS_UNLOCK(hlcd);
+	
+	return ST7789_OK;
+	
+}
+
+void ST7789_Disp_Staging_Begin(ST7789_HandleTypeDef *hlcd)
+{
+	
+	ST7789_OS_LOCK(hlcd);
+	
+	if (hlcd->Staging.Enabled)
+	{
+		hlcd->Staging.Active = 1;
+	}
+	
+	ST7789_OS_UNLOCK(hlcd);
+	
+}
+
+void ST7789_Disp_Staging_Commit(ST7789_HandleTypeDef *hlcd)
+{
+	
+	ST7789_OS_LOCK(hlcd);
+	
+	if (!hlcd->Staging.Enabled || !hlcd->Staging.Active)
+	{
+		
+		ST7789_OS_UNLOCK(hlcd);
+		return;
+		
+	}
+	
+	/* ---------------- Swap the Rows --------------- */
+	hlcd->Staging.Shown ^= 1;
+	hlcd->Staging.Active = 0;
+	
+	ST7789_SetScrollStart(hlcd, hlcd->Staging.TFA + (hlcd->Staging.Shown ? hlcd->Staging.Height : 0));
+	
+	ST7789_OS_UNLOCK(hlcd);
+	
+}
+
+void ST7789_Disp_Staging_Disable(ST7789_HandleTypeDef *hlcd)
+{
+	
+	ST7789_OS_LOCK(hlcd);
+	
+	if (!hlcd->Staging.Enabled)
+	{
+		
+		ST7789_OS_UNLOCK(hlcd);
+		return;
+		
+	}
+	
+	hlcd->Staging.Enabled = 0;
+	hlcd->Staging.Active  = 0;
+	hlcd->Staging.Shown   = 0;
+	
+	/* ------------ Reset Scroll Registers ---------- */
+	ST7789_SetScrollArea(hlcd, 0, ST7789_HEIGHT_MAX, 0);
+	ST7789_SetScrollStart(hlcd, 0);
+	
+	ST7789_OS_UNLOCK(hlcd);
+	
+}
+
+/* .......................... Scroll ........................... */
+ST7789_StatusTypeDef ST7789_Disp_Scroll_Enable(ST7789_HandleTypeDef *hlcd, uint16_t XStart, uint16_t Width)
+{
+	
+	uint16_t areaRow;
+	
+	ST7789_OS_LOCK(hlcd);
+	
+	/* ---------------- Size Control ---------------- */
+	/* The scroll direction (frame memory rows) is the x-axis only in rotation 1 and 3 */
+	if ((hlcd->Rotation == 0) || (hlcd->Rotation == 2) || (Width == 0) || (((uint32_t)XStart + Width) > hlcd->Width))
+	{
+		
+		ST7789_OS_UNLOCK(hlcd);
+		return ST7789_ERROR;
+		
+	}
+	
+	/* ------------- Calculate Scroll Area ---------- */
+	areaRow = XStart + hlcd->XOffset;
+	
+	if (hlcd->Rotation == 1)
+	{
+		areaRow = ST7789_HEIGHT_MAX - (areaRow + Width); // MY: Rows are mirrored in the frame memory
+	}
+	
+	hlcd->Scroll.Mirror  = (hlcd->Rotation == 1);
+	hlcd->Scroll.XStart  = XStart;
+	hlcd->Scroll.Width   = Width;
+	hlcd->Scroll.TFA     = areaRow;
+	hlcd->Scroll.Start   = 0;
+	hlcd->Scroll.Enabled = 1;
+	
+	/* ------------- Set Scroll Registers ----------- */
+	ST7789_SetScrollArea(hlcd, areaRow, Width, ST7789_HEIGHT_MAX - areaRow - Width);
+	ST7789_SetScrollStart(hlcd, areaRow);
+	
+	ST7789_OS_UNLOCK(hlcd);
+	
+	return ST7789_OK;
+	
+}
+
+void ST7789_Disp_Scroll_Left(ST7789_HandleTypeDef *hlcd)
+{
+	
+	ST7789_OS_LOCK(hlcd);
+	
+	if (!hlcd->Scroll.Enabled)
+	{
+		
+		ST7789_OS_UNLOCK(hlcd);
+		return;
+		
+	}
+	
+	/* The area starts at the right edge when the rows are mirrored, it scrolls the other way */
+	if (hlcd->Scroll.Mirror)
+	{
+		hlcd->Scroll.Start = (hlcd->Scroll.Start == 0) ? (hlcd->Scroll.Width - 1) : (hlcd->Scroll.Start - 1);
+	}
+	else
+	{
+		hlcd->Scroll.Start = ((hlcd->Scroll.Start + 1) == hlcd->Scroll.Width) ? 0 : (hlcd->Scroll.Start + 1);
+	}
+	
+	ST7789_SetScrollStart(hlcd, hlcd->Scroll.TFA + hlcd->Scroll.Start);
+	
+	ST7789_OS_UNLOCK(hlcd);
+	
+}
+
+uint16_t ST7789_Disp_Scroll_GetColumn(ST7789_HandleTypeDef *hlcd, uint16_t XPos)
+{
+	
+	uint16_t position;
+	
+	if (!hlcd->Scroll.Enabled || (XPos < hlcd->Scroll.XStart) || ((XPos - hlcd->Scroll.XStart) >= hlcd->Scroll.Width))
+	{
+		return XPos;
+	}
+	
+	/* ------- Shown Position in the Scroll Area ------- */
+	position = XPos - hlcd->Scroll.XStart;
+	
+	if (hlcd->Scroll.Mirror)
+	{
+		position = hlcd->Scroll.Width - 1 - position;
+	}
+	
+	/* ------------- Frame Memory Row --------------- */
+	position = (uint16_t)(((uint32_t)position + hlcd->Scroll.Start) % hlcd->Scroll.Width);
+	
+	if (hlcd->Scroll.Mirror)
+	{
+		position = hlcd->Scroll.Width - 1 - position;
+	}
+	
+	return hlcd->Scroll.XStart + position;
+	
+}
+
+void ST7789_Disp_Scroll_Disable(ST7789_HandleTypeDef *hlcd)
+{
+	
+	ST7789_OS_LOCK(hlcd);
+	
+	if (!hlcd->Scroll.Enabled)
+	{
+		
+		ST7789_OS_UNLOCK(hlcd);
+		return;
+		
+	}
+	
+	hlcd->Scroll.Enabled = 0;
+	hlcd->Scroll.Start   = 0;
+	
+	/* ------------ Reset Scroll Registers ---------- */
+	ST7789_SetScrollArea(hlcd, 0, ST7789_HEIGHT_MAX, 0);
+	ST7789_SetScrollStart(hlcd, 0);
+	
+	ST7789_OS_UNLOCK(hlcd);
+	
+}
+
+/* ...................... Default Display ...................... */
+static void ST7789_Display_Setup(void)
+{
+	
+	/* ------------- From st7789_conf.h ------------- */
+	#if defined(ST7789_HOST)
+	
+	ST7789_Display.Bus          = &ST7789_Bus_Host;
+	ST7789_Display.BusContext   = &ST7789_Host_Bus;
+	
+	#elif defined(ST7789_USE_FMC)
+	
+	static ST7789_FMCBusTypeDef fmcBus = {(volatile uint16_t *)ST7789_FMC_COMMAND_ADDRESS, (volatile uint16_t *)ST7789_FMC_DATA_ADDRESS, ST7789_FMC_WIDTH};
+	
+	ST7789_Display.Bus          = &ST7789_Bus_FMC;
+	ST7789_Display.BusContext   = &fmcBus;
+	
+	#elif defined(ST7789_USE_SPI_LL) && defined(ST7789_SPI_LL_TypeDef)
+	
+	ST7789_Display.Bus          = &ST7789_Bus_SPI_LL;
+	ST7789_Display.BusContext   = NULL;
+	
+	#else
+	
+	ST7789_Display.Bus          = &ST7789_Bus_SPI;
+	ST7789_Display.BusContext   = NULL;
+	
+	#endif
+	
+	ST7789_Display.SPI          = ST7789_DEFAULT_SPI;
+	
+	#ifndef ST7789_HOST /* No pins on the host */
+	
+	ST7789_Display.RSTPort      = ST7789_GPIO_PORT_REF(ST7789_RST_GPIO_PORT);
+	ST7789_Display.RSTPin       = ST7789_RST_GPIO_PIN;
+	ST7789_Display.CSPort       = ST7789_GPIO_PORT_REF(ST7789_CS_GPIO_PORT);
+	ST7789_Display.CSPin        = ST7789_CS_GPIO_PIN;
+	ST7789_Display.DCPort       = ST7789_GPIO_PORT_REF(ST7789_DC_GPIO_PORT);
+	ST7789_Display.DCPin        = ST7789_DC_GPIO_PIN;
+	
+	#endif
+	
+	ST7789_Display.PanelWidth   = ST7789_WIDTH;
+	ST7789_Display.PanelHeight  = ST7789_HEIGHT;
+	ST7789_Display.Rotation     = ST7789_ROTATION;
+	
+	/* The memory of ST7789_AddMemory is kept */
+	#if defined(ST7789_USE_DMA) && (ST7789_HOR_LEN > 0)
+	
+	if (ST7789_Display.Buffer == NULL)
+	{
+		ST7789_Display.Buffer       = LCDBuffer;
+		ST7789_Display.BufferLength = LCD_BUFFER_LENGTH;
+	}
+	
+	#endif
+	
+}
+
+void ST7789_Init(void)
+{
+	ST7789_Init_FirstFrame(NULL);
+}
+
+void ST7789_Init_FirstFrame(ST7789_FirstFrameTypeDef Draw)
+{
+	
+	ST7789_Display_Setup();
+	ST7789_Disp_Init_FirstFrame(&ST7789_Display, Draw);
+	
+}
+
+void ST7789_SetRotation(uint8_t Rotation)
+{
+	ST7789_Disp_SetRotation(&ST7789_Display, Rotation);
+}
+
+void ST7789_SetWindowAddress(uint16_t XStart, uint16_t YStart, uint16_t XEnd, uint16_t YEnd)
+{
+	ST7789_Disp_SetWindowAddress(&ST7789_Display, XStart, YStart, XEnd, YEnd);
+}
+
+void ST7789_InvertColors(ST7789_InvTypeDef Invert)
+{
+	ST7789_Disp_InvertColors(&ST7789_Display, Invert);
+}
+
+void ST7789_TearEffect(ST7789_TearTypeDef Tear)
+{
+	ST7789_Disp_TearEffect(&ST7789_Display, Tear);
+}
+
+void ST7789_RegCache_Invalidate(void)
+{
+	ST7789_Disp_RegCache_Invalidate(&ST7789_Display);
+}
+
+void ST7789_RegCache_GetStats(ST7789_RegCacheStatsTypeDef *Stats)
+{
+	ST7789_Disp_RegCache_GetStats(&ST7789_Display, Stats);
+}
+
+ST7789_StatusTypeDef ST7789_Clip_Push(int16_t XStart, int16_t YStart, int16_t XEnd, int16_t YEnd)
+{
+	return ST7789_Disp_Clip_Push(&ST7789_Display, XStart, YStart, XEnd, YEnd);
+}
+
+void ST7789_Clip_Pop(void)
+{
+	ST7789_Disp_Clip_Pop(&ST7789_Display);
+}
+
+void ST7789_Fill(uint16_t XStart, uint16_t YStart, uint16_t XEnd, uint16_t YEnd, ST7789_ColorTypeDef Color)
+{
+	ST7789_Disp_Fill(&ST7789_Display, XStart, YStart, XEnd, YEnd, Color);
+}
+
+void ST7789_FillScreen(ST7789_ColorTypeDef Color)
+{
+	ST7789_Disp_FillScreen(&ST7789_Display, Color);
+}
+
+void ST7789_FillPattern(uint16_t XStart, uint16_t YStart, uint16_t XEnd, uint16_t YEnd, const ST7789_TileTypeDef *Tile, uint16_t XPhase, uint16_t YPhase)
+{
+	ST7789_Disp_FillPattern(&ST7789_Display, XStart, YStart, XEnd, YEnd, Tile, XPhase, YPhase);
+}
+
+void ST7789_FillGradient(uint16_t XStart, uint16_t YStart, uint16_t XEnd, uint16_t YEnd, const ST7789_GradientTypeDef *Gradient)
+{
+	ST7789_Disp_FillGradient(&ST7789_Display, XStart, YStart, XEnd, YEnd, Gradient);
+}
+
+void ST7789_DrawPixel(uint16_t XPos, uint16_t YPos, ST7789_ColorTypeDef Color)
+{
+	ST7789_Disp_DrawPixel(&ST7789_Display, XPos, YPos, Color);
+}
+
+void ST7789_DrawPixel_4px(uint16_t XPos, uint16_t YPos, ST7789_ColorTypeDef Color)
+{
+	ST7789_Disp_DrawPixel_4px(&ST7789_Display, XPos, YPos, Color);
+}
+
+uint32_t ST7789_DrawPoints(const ST7789_PointTypeDef *Points, const ST7789_ColorTypeDef *Colors, uint16_t Count, ST7789_ColorTypeDef Color, uint16_t *Order)
+{
+	return ST7789_Disp_DrawPoints(&ST7789_Display, Points, Colors, Count, Color, Order);
+}
+
+void ST7789_DrawLine(uint16_t XStart, uint16_t YStart, uint16_t XEnd, uint16_t YEnd, ST7789_ColorTypeDef Color)
+{
+	ST7789_Disp_DrawLine(&ST7789_Display, XStart, YStart, XEnd, YEnd, Color);
+}
+
+void ST7789_DrawLine_AA(int16_t XStart, int16_t YStart, int16_t XEnd, int16_t YEnd, ST7789_ColorTypeDef Color, ST7789_ColorTypeDef BackgroundColor)
+{
+	ST7789_Disp_DrawLine_AA(&ST7789_Display, XStart, YStart, XEnd, YEnd, Color, BackgroundColor);
+}
+
+void ST7789_DrawThickLine(int16_t XStart, int16_t YStart, int16_t XEnd, int16_t YEnd, uint8_t Width, ST7789_LineCapTypeDef Cap, ST7789_ColorTypeDef Color)
+{
+	ST7789_Disp_DrawThickLine(&ST7789_Display, XStart, YStart, XEnd, YEnd, Width, Cap, Color);
+}
+
+void ST7789_DrawRectangle(uint16_t XStart, uint16_t YStart, uint16_t XEnd, uint16_t YEnd, ST7789_ColorTypeDef Color)
+{
+	ST7789_Disp_DrawRectangle(&ST7789_Display, XStart, YStart, XEnd, YEnd, Color);
+}
+
+void ST7789_DrawFilledRectangle(uint16_t XPos, uint16_t YPos, uint16_t Width, uint16_t Height, ST7789_ColorTypeDef Color)
+{
+	ST7789_Disp_DrawFilledRectangle(&ST7789_Display, XPos, YPos, Width, Height, Color);
+}
+
+void ST7789_DrawCircle(uint16_t XPos, uint16_t YPos, uint8_t Radius, ST7789_ColorTypeDef Color)
+{
+	ST7789_Disp_DrawCircle(&ST7789_Display, XPos, YPos, Radius, Color);
+}
+
+void ST7789_DrawFilledCircle(int16_t XPos, int16_t YPos, int16_t Radius, ST7789_ColorTypeDef Color)
+{
+	ST7789_Disp_DrawFilledCircle(&ST7789_Display, XPos, YPos, Radius, Color);
+}
+
+void ST7789_DrawTriangle(uint16_t X1, uint16_t Y1, uint16_t X2, uint16_t Y2, uint16_t X3, uint16_t Y3, ST7789_ColorTypeDef Color)
+{
+	ST7789_Disp_DrawTriangle(&ST7789_Display, X1, Y1, X2, Y2, X3, Y3, Color);
+}
+
+void ST7789_DrawFilledTriangle(uint16_t X1, uint16_t Y1, uint16_t X2, uint16_t Y2, uint16_t X3, uint16_t Y3, ST7789_ColorTypeDef Color)
+{
+	ST7789_Disp_DrawFilledTriangle(&ST7789_Display, X1, Y1, X2, Y2, X3, Y3, Color);
+}
+
+ST7789_StatusTypeDef ST7789_FillPolygon(const ST7789_PointTypeDef *Points, uint16_t Count, ST7789_FillRuleTypeDef Rule, ST7789_ColorTypeDef Color, ST7789_EdgeTypeDef *Edges, uint16_t EdgeCount)
+{
+	return ST7789_Disp_FillPolygon(&ST7789_Display, Points, Count, Rule, Color, Edges, EdgeCount);
+}
+
+void ST7789_DrawPolyline(const ST7789_PointTypeDef *Points, uint16_t Count, uint8_t Width, ST7789_ColorTypeDef Color)
+{
+	ST7789_Disp_DrawPolyline(&ST7789_Display, Points, Count, Width, Color);
+}
+
+void ST7789_DrawRoundRect(int16_t XStart, int16_t YStart, int16_t XEnd, int16_t YEnd, uint16_t Radius, ST7789_ColorTypeDef Color)
+{
+	ST7789_Disp_DrawRoundRect(&ST7789_Display, XStart, YStart, XEnd, YEnd, Radius, Color);
+}
+
+void ST7789_FillRoundRect(int16_t XStart, int16_t YStart, int16_t XEnd, int16_t YEnd, uint16_t Radius, ST7789_ColorTypeDef Color)
+{
+	ST7789_Disp_FillRoundRect(&ST7789_Display, XStart, YStart, XEnd, YEnd, Radius, Color);
+}
+
+void ST7789_DrawEllipse(int16_t XPos, int16_t YPos, uint16_t XRadius, uint16_t YRadius, ST7789_ColorTypeDef Color)
+{
+	ST7789_Disp_DrawEllipse(&ST7789_Display, XPos, YPos, XRadius, YRadius, Color);
+}
+
+void ST7789_FillEllipse(int16_t XPos, int16_t YPos, uint16_t XRadius, uint16_t YRadius, ST7789_ColorTypeDef Color)
+{
+	ST7789_Disp_FillEllipse(&ST7789_Display, XPos, YPos, XRadius, YRadius, Color);
+}
+
+void ST7789_DrawArc(int16_t XPos, int16_t YPos, uint16_t Radius, uint16_t Width, int16_t StartAngle, int16_t EndAngle, ST7789_ColorTypeDef Color)
+{
+	ST7789_Disp_DrawArc(&ST7789_Display, XPos, YPos, Radius, Width, StartAngle, EndAngle, Color);
+}
+
+void ST7789_PutImage(uint16_t XPos, uint16_t YPos, uint16_t Width, uint16_t Height, const uint16_t *Image)
+{
+	ST7789_Disp_PutImage(&ST7789_Display, XPos, YPos, Width, Height, Image);
+}
+
+void ST7789_WritePixels(const uint16_t *Pixels, uint32_t Count)
+{
+	ST7789_Disp_WritePixels(&ST7789_Display, Pixels, Count);
+}
+
+void ST7789_PutImage_Keyed(uint16_t XPos, uint16_t YPos, const ST7789_KeyedImageTypeDef *Image)
+{
+	ST7789_Disp_PutImage_Keyed(&ST7789_Display, XPos, YPos, Image);
+}
+
+void ST7789_PutChar(uint16_t XPos, uint16_t YPos, char Ch, ST7789_FontTypeDef Font, ST7789_ColorTypeDef Color, ST7789_ColorTypeDef BackgroundColor)
+{
+	ST7789_Disp_PutChar(&ST7789_Display, XPos, YPos, Ch, Font, Color, BackgroundColor);
+}
+
+void ST7789_PutString(uint16_t XPos, uint16_t YPos, const char *Str, ST7789_FontTypeDef Font, ST7789_ColorTypeDef Color, ST7789_ColorTypeDef BackgroundColor)
+{
+	ST7789_Disp_PutString(&ST7789_Display, XPos, YPos, Str, Font, Color, BackgroundColor);
+}
+
+ST7789_StatusTypeDef ST7789_ReadRegion(uint16_t XStart, uint16_t YStart, uint16_t XEnd, uint16_t YEnd, uint16_t *Buffer)
+{
+	return ST7789_Disp_ReadRegion(&ST7789_Display, XStart, YStart, XEnd, YEnd, Buffer);
+}
+
+ST7789_ColorTypeDef ST7789_ReadPixel(uint16_t XPos, uint16_t YPos)
+{
+	return ST7789_Disp_ReadPixel(&ST7789_Display, XPos, YPos);
+}
+
+void ST7789_FillBlend(uint16_t XStart, uint16_t YStart, uint16_t XEnd, uint16_t YEnd, ST7789_ColorTypeDef Color, uint8_t Alpha)
+{
+	ST7789_Disp_FillBlend(&ST7789_Display, XStart, YStart, XEnd, YEnd, Color, Alpha);
+}
+
+void ST7789_DrawPixel_Blend(uint16_t XPos, uint16_t YPos, ST7789_ColorTypeDef Color, uint8_t Alpha)
+{
+	ST7789_Disp_DrawPixel_Blend(&ST7789_Display, XPos, YPos, Color, Alpha);
+}
+
+ST7789_StatusTypeDef ST7789_Staging_Enable(uint16_t YStart, uint16_t Height)
+{
+	return ST7789_Disp_Staging_Enable(&ST7789_Display, YStart, Height);
+}
+
+void ST7789_Staging_Begin(void)
+{
+	ST7789_Disp_Staging_Begin(&ST7789_Display);
+}
+
+void ST7789_Staging_Commit(void)
+{
+	ST7789_Disp_Staging_Commit(&ST7789_Display);
+}
+
+void ST7789_Staging_Disable(void)
+{
+	ST7789_Disp_Staging_Disable(&ST7789_Display);
+}
+
+ST7789_StatusTypeDef ST7789_Scroll_Enable(uint16_t XStart, uint16_t Width)
+{
+	return ST7789_Disp_Scroll_Enable(&ST7789_Display, XStart, Width);
+}
+
+void ST7789_Scroll_Left(void)
+{
+	ST7789_Disp_Scroll_Left(&ST7789_Display);
+}
+
+uint16_t ST7789_Scroll_GetColumn(uint16_t XPos)
+{
+	return ST7789_Disp_Scroll_GetColumn(&ST7789_Display, XPos);
+}
+
+void ST7789_Scroll_Disable(void)
+{
+	ST7789_Disp_Scroll_Disable(&ST7789_Display);
+}
+
+ST7789_StatusTypeDef ST7789_AddMemory(void *Memory, uint32_t Size, ST7789_MemTypeDef Type)
+{
+	return ST7789_Disp_AddMemory(&ST7789_Display, Memory, Size, Type);
+}
+
+void ST7789_WaitForTransfer(void)
+{
+	ST7789_Disp_WaitForTransfer(&ST7789_Display);
+}
+
+void ST7789_GetLockStats(ST7789_OSStatsTypeDef *Stats)
+{
+	ST7789_Disp_GetLockStats(&ST7789_Display, Stats);
+}
+
 /* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ End of the program ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
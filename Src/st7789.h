@@ -33,6 +33,7 @@
 
 /* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ Include ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
 #include <math.h>
+#include <stddef.h>
 #include <stdint.h>
 
 #include "st7789_conf.h"
@@ -54,6 +55,11 @@
 	#include "GPIO_UNIT/gpio_unit.h"
 #endif /* __GPIO_UNIT_H_ */
 
+/* ------------------------------------------------------------------ */
+#elif defined(ST7789_HOST)  /* Check host simulation */
+
+#include "st7789_host.h"
+
 /* ------------------------------------------------------------------ */
 #elif defined(__GNUC__) && !defined(USE_HAL_DRIVER)  /* Check compiler */
 
@@ -128,6 +134,8 @@
 
 #endif /* _CodeVISIONAVR__ */
 
+#include "st7789_os.h"
+
 /* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ Defines ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
 /* ----------------------------- ST7789 ---------------------------- */
 #define ST7789_WIDTH_MAX   240
@@ -162,11 +170,127 @@
 	
 #endif
 
+/* Off-screen Staging Rows:
+
+	The GRAM rows above and below the visible area are never shown, the staging mode
+	renders the next content of a strip there and swaps it in with the vertical scroll
+	start address (VSCSAD), so the strip changes in one frame without tearing.
+
+	The strip must be full width and touch the top or the bottom edge of the display,
+	its height is limited by the hidden rows on that side:
+
+		Top strip   : Height <= YOffset
+		Bottom strip: Height <= ST7789_HEIGHT_MAX - Height - YOffset (of the display)
+
+	Examples (Rotation 0 or 2):
+		240x280 -> 20 rows top, 20 rows bottom
+		240x240 -> 40 rows top, 40 rows bottom
+		240x320 -> Not supported (no hidden rows)
+
+	Rotation 1 and 3 are not supported, because the hidden rows are in the x-axis.
+	The limits follow the current rotation of the display (ST7789_SetRotation).
+
+*/
+
 /* .................... Common .................... */
+#define ST7789_INIT_DELAY  0x80 // Init table: A delay follows the parameters
+#define ST7789_INIT_END    0xFF // Init table: End of the table
+
+#ifndef ST7789_INIT_POWER_DELAY
+	#define ST7789_INIT_POWER_DELAY   0
+#endif
+
+#ifndef ST7789_INIT_RESET_DELAY
+	#define ST7789_INIT_RESET_DELAY   1
+#endif
+
+#ifndef ST7789_INIT_READY_DELAY
+	#define ST7789_INIT_READY_DELAY   5
+#endif
+
+#ifndef ST7789_INIT_SLPOUT_DELAY
+	#define ST7789_INIT_SLPOUT_DELAY  5
+#endif
+
+#ifndef ST7789_READ_CHUNK
+	#define ST7789_READ_CHUNK  16 // Pixels converted per SPI read
+#endif
+
+#ifndef ST7789_PATTERN_CHUNK
+	#define ST7789_PATTERN_CHUNK  32 // Pixels expanded per pass without the LCD buffer
+#endif
+
+#ifndef ST7789_LINE_CHUNK
+	#define ST7789_LINE_CHUNK  32 // Pixels of an anti-aliased line run without the LCD buffer
+#endif
+
+#ifndef ST7789_CLIP_DEPTH
+	#define ST7789_CLIP_DEPTH  4 // Nested clip rectangles of ST7789_Clip_Push
+#endif
+
 /* ................... Macro's .................... */
+#define ST7789_KEYED_RUNS_SIZE(Width, Height)                            ((uint32_t)(Height) * (1U + 2U * (((Width) + 1U) / 2U))) // Worst case length of the run table
 
 /* ----------------------- Define by compiler ---------------------- */
-#if (defined(_CodeVISIONAVR__) || defined(__GNUC__)) && !defined(USE_HAL_DRIVER)
+#if defined(ST7789_HOST)
+	
+	#undef ST7789_USE_DMA
+	
+	#ifndef ST7789_GPIO_WritePin
+		#define ST7789_GPIO_WritePin(gpiox , gpio_pin , pin_state)           ((void)0)
+	#endif
+	
+	#ifndef ST7789_GPIO_PIN_SET
+		#define ST7789_GPIO_PIN_SET                                          1
+	#endif
+	
+	#ifndef ST7789_GPIO_PIN_RESET
+		#define ST7789_GPIO_PIN_RESET                                        0
+	#endif
+	
+	#define ST7789_Delay(t)                                                  ST7789_Host_Delay((t))
+	
+	#ifndef ST7789_GetMicros
+		#define ST7789_GetMicros()                                           ST7789_Host_GetMicros()
+	#endif
+	
+	#ifndef ST7789_SPI_TransmitReceive
+		#define ST7789_SPI_TransmitReceive(hspi, pTxData, pRxData, Size, Timeout)  ST7789_Host_SPI_TransmitReceive((uint8_t *)(pTxData), (uint8_t *)(pRxData), (Size))
+		#define ST7789_SPI_Transmit(hspi, pTxData, Size, Timeout)                  ST7789_Host_SPI_Transmit((uint8_t *)(pTxData), (Size))
+		#define ST7789_SPI_Receive(hspi, pRxData, Size, Timeout)                   ST7789_Host_SPI_Receive((uint8_t *)(pRxData), (Size))
+	#endif
+	
+	#ifndef ST7789_SPI_SetReadClock
+		#define ST7789_SPI_SetReadClock(hspi)
+		#define ST7789_SPI_SetWriteClock(hspi)
+	#endif
+	
+	#ifndef ST7789_GPIOTypeDef
+		#define ST7789_GPIOTypeDef                                           uint8_t
+	#endif
+	
+	#define ST7789_SPITypeDef                                                void
+	#define ST7789_DEFAULT_SPI                                               NULL
+	
+	#define ST7789_GPIO_PORT(pPort)                                          (pPort)
+	#define ST7789_GPIO_PORT_REF(Port)                                       NULL
+	
+	/* Emulated register block of ST7789_Bus_SPI_LL */
+	#define ST7789_SPI_LL_TypeDef                                            ST7789_HostSPIRegTypeDef
+	#define ST7789_SPI_LL_Instance(hspi)                                     (&ST7789_Host_SPIReg)
+	#define ST7789_SPI_LL_Enable(reg)                                        ((reg)->CR1 |= ST7789_HOST_SPI_CR1_SPE)
+	#define ST7789_SPI_LL_IsTxEmpty(reg)                                     (ST7789_Host_SPI_LL_GetSR((reg)) & ST7789_HOST_SPI_SR_TXE)
+	#define ST7789_SPI_LL_IsBusy(reg)                                        (ST7789_Host_SPI_LL_GetSR((reg)) & ST7789_HOST_SPI_SR_BSY)
+	#define ST7789_SPI_LL_IsRxNotEmpty(reg)                                  (ST7789_Host_SPI_LL_GetSR((reg)) & ST7789_HOST_SPI_SR_RXNE)
+	#define ST7789_SPI_LL_WriteByte(reg, Byte)                               ST7789_Host_SPI_LL_Write((reg), (Byte))
+	#define ST7789_SPI_LL_ReadByte(reg)                                      ST7789_Host_SPI_LL_Read((reg))
+	
+	#ifndef ST7789_CACHE_CLEAN
+		#define ST7789_CACHE_CLEAN(Addr, Size)                               ST7789_Host_Cache_Clean((Addr), (Size)) // Counts the maintenance operations
+	#endif
+	
+/*----------------------------------------------------------*/
+#elif (defined(_CodeVISIONAVR__) || defined(__GNUC__)) && !defined(USE_HAL_DRIVER)
 	
 	#undef ST7789_USE_DMA
 	
@@ -184,12 +308,31 @@
 	
 	#define ST7789_Delay(t)                                                  _delay_ms((t))
 	
+	#ifndef ST7789_GetMicros
+		#define ST7789_GetMicros()                                           0 // Define a microsecond time base to use the frame scheduler
+	#endif
+	
 	#ifndef ST7789_SPI_TransmitReceive
-		#define ST7789_SPI_TransmitReceive(pTxData, pRxData, Size, Timeout)  SPI_TransmitReceive((pTxData), (pRxData), (Size), (Timeout))
-		#define ST7789_SPI_Transmit(pTxData, Size, Timeout)                  SPI_Transmit((pTxData), (Size), (Timeout))
-		#define ST7789_SPI_Receive(pRxData, Size, Timeout)                   SPI_Receive((pRxData), (Size), (Timeout))
+		#define ST7789_SPI_TransmitReceive(hspi, pTxData, pRxData, Size, Timeout)  SPI_TransmitReceive((pTxData), (pRxData), (Size), (Timeout))
+		#define ST7789_SPI_Transmit(hspi, pTxData, Size, Timeout)                  SPI_Transmit((pTxData), (Size), (Timeout))
+		#define ST7789_SPI_Receive(hspi, pRxData, Size, Timeout)                   SPI_Receive((pRxData), (Size), (Timeout))
+	#endif
+	
+	#ifndef ST7789_SPI_SetReadClock
+		#define ST7789_SPI_SetReadClock(hspi)                                // Define it to use a lower SPI clock to read the GRAM
+		#define ST7789_SPI_SetWriteClock(hspi)
+	#endif
+	
+	#ifndef ST7789_GPIOTypeDef
+		#define ST7789_GPIOTypeDef                                           volatile uint8_t // Port register
 	#endif
 	
+	#define ST7789_SPITypeDef                                                void // One SPI unit
+	#define ST7789_DEFAULT_SPI                                               NULL
+	
+	#define ST7789_GPIO_PORT(pPort)                                          (*(pPort))
+	#define ST7789_GPIO_PORT_REF(Port)                                       (&(Port))
+	
 /*----------------------------------------------------------*/
 #elif defined(USE_HAL_DRIVER)
 	
@@ -215,15 +358,88 @@
 	
 	#define ST7789_Delay(t)                                                  HAL_Delay((t))
 	
+	#ifndef ST7789_GetMicros
+		#define ST7789_GetMicros()                                           (HAL_GetTick() * 1000U) // Override with a timer or DWT->CYCCNT for better resolution
+		#define ST7789_MICROS_TICK                                           1000U // Resolution of ST7789_GetMicros (us)
+	#endif
+	
 	#ifndef ST7789_SPI_TransmitReceive
-		#define ST7789_SPI_TransmitReceive(pTxData, pRxData, Size, Timeout)  HAL_SPI_TransmitReceive(&ST7789_SPI, (pTxData), (pRxData), (Size), (Timeout))
-		#define ST7789_SPI_Transmit(pTxData, Size, Timeout)                  HAL_SPI_Transmit(&ST7789_SPI, (pTxData), (Size), (Timeout))
-		#define ST7789_SPI_Transmit_DMA(pTxData, Size)                       HAL_SPI_Transmit_DMA(&ST7789_SPI, (pTxData), (Size))
-		#define ST7789_SPI_Receive(pRxData, Size, Timeout)                   HAL_SPI_Receive(&ST7789_SPI, (pRxData), (Size), (Timeout))
+		#define ST7789_SPI_TransmitReceive(hspi, pTxData, pRxData, Size, Timeout)  HAL_SPI_TransmitReceive((hspi), (pTxData), (pRxData), (Size), (Timeout))
+		#define ST7789_SPI_Transmit(hspi, pTxData, Size, Timeout)                  HAL_SPI_Transmit((hspi), (pTxData), (Size), (Timeout))
+		#define ST7789_SPI_Transmit_DMA(hspi, pTxData, Size)                       HAL_SPI_Transmit_DMA((hspi), (pTxData), (Size))
+		#define ST7789_SPI_Receive(hspi, pRxData, Size, Timeout)                   HAL_SPI_Receive((hspi), (pRxData), (Size), (Timeout))
+	#endif
+	
+	#ifndef ST7789_SPI_IsBusy
+		#define ST7789_SPI_IsBusy(hspi)                                      ((hspi)->State != ST7789_SPI_STATE_READY)
+	#endif
+	
+	#define ST7789_GPIOTypeDef                                               GPIO_TypeDef
+	#define ST7789_SPITypeDef                                                SPI_HandleTypeDef
+	#define ST7789_DEFAULT_SPI                                               (&ST7789_SPI)
+	
+	#define ST7789_GPIO_PORT(pPort)                                          (pPort)
+	#define ST7789_GPIO_PORT_REF(Port)                                       (Port)
+	
+	#ifndef ST7789_SPI_READ_PRESCALER
+		#define ST7789_SPI_READ_PRESCALER                                    SPI_BAUDRATEPRESCALER_16
+	#endif
+	
+	#ifndef ST7789_SPI_SetReadClock
+		
+		#ifdef STM32H7
+			#define ST7789_SPI_BR_REG                                        CFG1
+			#define ST7789_SPI_BR_MASK                                       SPI_CFG1_MBR
+		#else
+			#define ST7789_SPI_BR_REG                                        CR1
+			#define ST7789_SPI_BR_MASK                                       SPI_CR1_BR
+		#endif
+		
+		#define ST7789_SPI_SetBaudRate(hspi, Prescaler)                      do { __HAL_SPI_DISABLE(hspi); MODIFY_REG((hspi)->Instance->ST7789_SPI_BR_REG, ST7789_SPI_BR_MASK, (Prescaler)); __HAL_SPI_ENABLE(hspi); } while (0)
+		#define ST7789_SPI_SetReadClock(hspi)                                ST7789_SPI_SetBaudRate((hspi), ST7789_SPI_READ_PRESCALER)
+		#define ST7789_SPI_SetWriteClock(hspi)                               ST7789_SPI_SetBaudRate((hspi), (hspi)->Init.BaudRatePrescaler)
+		
+	#endif
+	
+	#if !defined(STM32H7) && !defined(ST7789_SPI_LL_TypeDef) /* Register block of ST7789_Bus_SPI_LL (SPI with SR.TXE/SR.BSY) */
+		
+		#define ST7789_SPI_LL_TypeDef                                        SPI_TypeDef
+		#define ST7789_SPI_LL_Instance(hspi)                                 ((hspi)->Instance)
+		#define ST7789_SPI_LL_Enable(reg)                                    ((reg)->CR1 |= SPI_CR1_SPE)
+		#define ST7789_SPI_LL_IsTxEmpty(reg)                                 ((reg)->SR & SPI_SR_TXE)
+		#define ST7789_SPI_LL_IsBusy(reg)                                    ((reg)->SR & SPI_SR_BSY)
+		#define ST7789_SPI_LL_IsRxNotEmpty(reg)                              ((reg)->SR & SPI_SR_RXNE)
+		#define ST7789_SPI_LL_WriteByte(reg, Byte)                           (*(volatile uint8_t *)&(reg)->DR = (Byte)) // 8-bit access puts one byte in the FIFO
+		#define ST7789_SPI_LL_ReadByte(reg)                                  (*(volatile uint8_t *)&(reg)->DR)
+		
+	#endif
+	
+	#if defined(__DCACHE_PRESENT) && (__DCACHE_PRESENT == 1U) && !defined(ST7789_CACHE_CLEAN) /* Cortex-M7 (STM32F7/H7) */
+		#define ST7789_CACHE_CLEAN(Addr, Size)                               SCB_CleanDCache_by_Addr((uint32_t *)(Addr), (int32_t)(Size))
 	#endif
 
 #endif /* __GNUC__ */
 
+#ifndef ST7789_CACHE_LINE
+	#define ST7789_CACHE_LINE  32 // D-cache line of Cortex-M7 (bytes)
+#endif
+
+#ifndef ST7789_ALIGNED /* Place a buffer on its own cache lines */
+	
+	#if defined(ST7789_CACHE_CLEAN) && (defined(__GNUC__) || defined(__CC_ARM) || defined(__ICCARM__))
+		#define ST7789_ALIGNED  __attribute__((aligned(ST7789_CACHE_LINE)))
+	#else
+		#define ST7789_ALIGNED
+	#endif
+	
+#endif
+
+#ifdef ST7789_CACHE_CLEAN
+	#define ST7789_MEM_ALIGN  ST7789_CACHE_LINE // ST7789_AddMemory regions start on a cache line
+#else
+	#define ST7789_MEM_ALIGN  4
+#endif
+
 /* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ Types ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
 /* ------------------------ ST7789 Commands ------------------------ */
 typedef enum /* LCD Commands */
@@ -250,10 +466,15 @@ typedef enum /* LCD Commands */
 	ST7789_CMD_RAMRD   = 0x2E, // Memory Read
 	
 	ST7789_CMD_PTLAR   = 0x30, // Partial Area
+	ST7789_CMD_VSCRDEF = 0x33, // Vertical Scrolling Definition
+	ST7789_CMD_TEOFF   = 0x34, // Tearing Effect Line Off
+	ST7789_CMD_TEON    = 0x35, // Tearing Effect Line On
 	ST7789_CMD_COLMOD  = 0x3A, // Interface Pixel Format
 	ST7789_CMD_MADCTL  = 0x36, // Memory Data Access Control
+	ST7789_CMD_VSCSAD  = 0x37, // Vertical Scroll Start Address of RAM
 	
 	ST7789_CMD_WRMEMC  = 0x3C, // Write Memory Continue
+	ST7789_CMD_RDMEMC  = 0x3E, // Read Memory Continue
 	
 	ST7789_CMD_RDID1   = 0xDA, // Read ID1
 	ST7789_CMD_RDID2   = 0xDB, // Read ID2
@@ -356,6 +577,55 @@ typedef enum /* Color Mode */
 	
 }ST7789_ColorModeTypeDef;
 
+typedef enum /* Status */
+{
+
+	ST7789_OK    = 0x00,
+	ST7789_ERROR = 0x01,
+
+}ST7789_StatusTypeDef;
+
+typedef enum /* Memory Type */
+{
+	
+	ST7789_MEM_CPU = 0x00, // Only the CPU can access it (e.g. CCM)
+	ST7789_MEM_DMA = 0x01, // DMA can read it (SRAM, SDRAM)
+	
+}ST7789_MemTypeDef;
+
+typedef enum /* Cached Registers */
+{
+	
+	ST7789_REG_CASET  = 0x00,
+	ST7789_REG_RASET  = 0x01,
+	ST7789_REG_MADCTL = 0x02,
+	ST7789_REG_COLMOD = 0x03,
+	ST7789_REG_INV    = 0x04,
+	
+	ST7789_REG_CACHED = 0x05, // Number of the cached registers
+	
+}ST7789_RegTypeDef;
+
+typedef struct /* Register Cache Statistics */
+{
+	
+	uint32_t Written[ST7789_REG_CACHED]; // Commands sent to the LCD
+	uint32_t Skipped[ST7789_REG_CACHED]; // Commands skipped because the LCD already has the value
+	
+}ST7789_RegCacheStatsTypeDef;
+
+typedef void (*ST7789_FirstFrameTypeDef)(void); /* Draws the first frame before the display is turned on */
+
+typedef struct /* Display Area */
+{
+	
+	uint16_t XStart;
+	uint16_t YStart;
+	uint16_t XEnd;
+	uint16_t YEnd;
+	
+}ST7789_AreaTypeDef;
+
 typedef struct /* ST7789 Font */
 {
 	
@@ -366,9 +636,207 @@ typedef struct /* ST7789 Font */
 	
 }ST7789_FontTypeDef;
 
+typedef struct /* Pattern Tile */
+{
+	
+	const uint16_t *Data;   // Pixels in the ST7789_PutImage format (Big-endian RGB565)
+	uint16_t        Width;
+	uint16_t        Height;
+	
+}ST7789_TileTypeDef;
+
+typedef enum /* Gradient Mode */
+{
+	
+	ST7789_GRADIENT_HORIZONTAL = 0x00, // Color1 at XStart, Color2 at XEnd
+	ST7789_GRADIENT_VERTICAL   = 0x01, // Color1 at YStart, Color2 at YEnd
+	ST7789_GRADIENT_LINEAR     = 0x02, // Color1 at (X1, Y1), Color2 at (X2, Y2)
+	ST7789_GRADIENT_RADIAL     = 0x03, // Color1 at the center (X1, Y1), Color2 at the radius
+	
+}ST7789_GradientModeTypeDef;
+
+typedef struct /* Gradient */
+{
+	
+	uint8_t             Mode;   // ST7789_GradientModeTypeDef
+	ST7789_ColorTypeDef Color1;
+	ST7789_ColorTypeDef Color2;
+	
+	int16_t             X1;     // Linear: Start point, Radial: Center (Display position)
+	int16_t             Y1;
+	int16_t             X2;     // Linear: End point
+	int16_t             Y2;
+	uint16_t            Radius; // Radial
+	
+	uint8_t             Dither; // 1: 4x4 ordered dither against RGB565 banding
+	
+}ST7789_GradientTypeDef;
+
+typedef enum /* Line Cap */
+{
+	
+	ST7789_CAP_BUTT   = 0x00, // Ends at the end points
+	ST7789_CAP_SQUARE = 0x01, // Extended by half of the width
+	ST7789_CAP_ROUND  = 0x02, // Half circle, joins the segments of a polyline
+	
+}ST7789_LineCapTypeDef;
+
+typedef enum /* Polygon Fill Rule */
+{
+	
+	ST7789_FILL_EVEN_ODD = 0x00, // Inside where a ray crosses the outline an odd number of times
+	ST7789_FILL_NON_ZERO = 0x01, // Inside where the outline winds around the point (Self-overlaps are filled)
+	
+}ST7789_FillRuleTypeDef;
+
+typedef struct /* Point */
+{
+	
+	int16_t X;
+	int16_t Y;
+	
+}ST7789_PointTypeDef;
+
+typedef struct /* Polygon Edge */
+{
+	
+	int64_t X;         // X at the center of the current row (16.16 fixed point in 64 bits, rounded down)
+	int64_t Step;      // X change per row
+	int32_t Remainder; // Rest of the step, X gets 1 more when the error reaches the edge height
+	int32_t Error;
+	int16_t YStart;    // First row
+	int16_t YEnd;      // Row after the last row
+	int8_t  Winding;   // 1: Downward, -1: Upward
+	
+}ST7789_EdgeTypeDef;
+
+typedef struct /* Color-keyed Image */
+{
+	
+	const uint16_t     *Data;   // Pixels in the ST7789_PutImage format
+	uint16_t            Width;
+	uint16_t            Height;
+	ST7789_ColorTypeDef Key;    // Transparent color
+	const uint16_t     *Runs;   // Opaque runs, per row: Count, then Start and Length of each run (NULL: Found while drawing)
+	
+}ST7789_KeyedImageTypeDef;
+
+typedef struct /* Off-screen Staging */
+{
+	
+	uint8_t  Enabled;
+	uint8_t  Active; // Drawing to the hidden rows
+	uint8_t  Shown;  // 0: Strip rows, 1: Hidden rows
+	
+	uint16_t YStart;
+	uint16_t Height;
+	int16_t  Offset; // Offset of the hidden rows from the strip rows
+	uint16_t TFA;    // First row of the scroll area in the frame memory
+	
+}ST7789_StagingTypeDef;
+
+typedef struct /* Horizontal Hardware Scroll */
+{
+	
+	uint8_t  Enabled;
+	uint8_t  Mirror; // The frame memory rows run from right to left (Rotation 1)
+	
+	uint16_t XStart; // Scrolled columns
+	uint16_t Width;
+	uint16_t TFA;    // First row of the scroll area in the frame memory
+	uint16_t Start;  // Column of the scroll area shown at the start of the area (VSCSAD - TFA)
+	
+}ST7789_ScrollTypeDef;
+
+typedef struct /* Controller State Cache */
+{
+	
+	uint8_t Valid;                          // Bit n: Value of ST7789_RegTypeDef n is known
+	uint8_t Command[ST7789_REG_CACHED];
+	uint8_t Value[ST7789_REG_CACHED][4];
+	
+	ST7789_RegCacheStatsTypeDef Stats;
+	
+}ST7789_RegCacheTypeDef;
+
+typedef struct /* Clip Rectangle Stack */
+{
+	
+	uint8_t            Depth;                    // Pushed areas (0: Whole display)
+	ST7789_AreaTypeDef Area[ST7789_CLIP_DEPTH];  // Intersection with the areas below it
+	
+}ST7789_ClipTypeDef;
+
+struct __ST7789_HandleTypeDef;
+
+typedef struct /* Bus Operations (st7789_bus.h) */
+{
+	
+	void    (*WriteCommand)(struct __ST7789_HandleTypeDef *hlcd, uint8_t Command);                      // Select the LCD and write a command
+	void    (*WriteData)(struct __ST7789_HandleTypeDef *hlcd, const uint8_t *Data, uint16_t Size);      // Write parameters
+	void    (*WriteBulk)(struct __ST7789_HandleTypeDef *hlcd, const uint8_t *Data, uint32_t Size);      // Write pixel data and wait for the end
+	void    (*WriteBulkAsync)(struct __ST7789_HandleTypeDef *hlcd, const uint8_t *Data, uint32_t Size); // Start writing pixel data, the part after the first packet goes to TxData/TxSize (NULL: Not supported)
+	void    (*WriteRepeat)(struct __ST7789_HandleTypeDef *hlcd, const uint16_t *Pixel, uint32_t Count); // Start writing one RGB565 pixel Count times (NULL: Not supported)
+	uint8_t (*IsBusy)(struct __ST7789_HandleTypeDef *hlcd);                                            // The async write is running
+	void    (*Read)(struct __ST7789_HandleTypeDef *hlcd, uint8_t Command, uint8_t *Data, uint16_t Size); // Write a read command, skip the dummy read and read the data
+	void    (*End)(struct __ST7789_HandleTypeDef *hlcd);                                               // Release the LCD
+	
+}ST7789_BusOpsTypeDef;
+
+typedef struct __ST7789_HandleTypeDef /* Display Handle */
+{
+	
+	/* ~~~~~~~~~~~~~~~~~ Bus (Set before ST7789_Disp_Init) ~~~~~~~~~~~~~~~~~ */
+	const ST7789_BusOpsTypeDef *Bus;      // Bus backend (NULL: ST7789_Bus_SPI)
+	void                   *BusContext;   // Data of the backend, e.g. ST7789_FMCBusTypeDef
+	
+	ST7789_SPITypeDef      *SPI;          // SPI of the display (HAL: &hspi1)
+	
+	ST7789_GPIOTypeDef     *RSTPort;      // NULL: Software reset
+	uint16_t                RSTPin;
+	ST7789_GPIOTypeDef     *CSPort;
+	uint16_t                CSPin;
+	ST7789_GPIOTypeDef     *DCPort;
+	uint16_t                DCPin;
+	
+	/* ~~~~~~~~~~~~~~ Geometry (Set before ST7789_Disp_Init) ~~~~~~~~~~~~~~~ */
+	uint16_t                PanelWidth;   // Visible width in rotation 0, e.g. 240
+	uint16_t                PanelHeight;  // Visible height in rotation 0, e.g. 280
+	uint8_t                 Rotation;
+	
+	/* ~~~~~~~~~~~~ Memory (ST7789_Disp_AddMemory or set directly) ~~~~~~~~~~~~ */
+	uint16_t               *Buffer;       // Transmit buffer for fills, glyphs and DMA (NULL: No buffer)
+	uint32_t                BufferLength; // Pixels
+	uint8_t                *Scratch;      // CPU scratch for the GRAM read decode (NULL: Stack)
+	uint32_t                ScratchSize;  // Bytes
+	
+	/* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~ State ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+	uint16_t                Width;        // Width in the current rotation
+	uint16_t                Height;       // Height in the current rotation
+	uint16_t                XOffset;      // Position of the visible area in the frame memory
+	uint16_t                YOffset;
+	
+	volatile uint8_t        TxBusy;       // The last async transfer is running and the LCD is selected
+	const uint8_t          *TxData;       // Rest of the running async transfer, sent packet by packet from ST7789_Disp_TxCpltCallback
+	volatile uint32_t       TxSize;       // Bytes
+	uint16_t                RepeatPixel;  // Source of the running repeat transfer
+	
+	void (*TxCpltHook)(struct __ST7789_HandleTypeDef *hlcd); // Called when an async transfer is completed (NULL: Unused)
+	
+	ST7789_StagingTypeDef   Staging;
+	ST7789_ScrollTypeDef    Scroll;
+	ST7789_RegCacheTypeDef  RegCache;
+	ST7789_ClipTypeDef      Clip;         // Drawing outside of the top area is skipped
+	
+	ST7789_OSTypeDef        OS;           // Mutex and TX complete semaphore (st7789_os.h)
+	
+}ST7789_HandleTypeDef;
+
 /* ---------------------------- Common ----------------------------- */
 
 /* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ Variables ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+extern ST7789_HandleTypeDef ST7789_Display; // Display of the ST7789_xxx functions (st7789_conf.h)
+
 /* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ Enum ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
 /* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ Struct ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
 /* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ Prototype ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
@@ -392,6 +860,30 @@ typedef struct /* ST7789 Font */
  */
 void ST7789_Init(void);
 
+/*
+ * Function: ST7789_Init_FirstFrame
+ * --------------------------------
+ * Initialize ST7789 LCD and draw the first frame before the display is turned on,
+ * so the splash is shown without a clear pass
+ *
+ * Param  : 
+ *         Draw : Draws the first frame (NULL: Fill with ST7789_INIT_CLEAR_COLOR if it is defined)
+ *         
+ * Returns: 
+ *         -
+ *         
+ * Example: 
+ *         void Splash_Draw(void)
+ *         {
+ *             ST7789_PutImage(0, 0, 240, 280, SplashImage);
+ *         }
+ *         
+ *         ST7789_Init_FirstFrame(Splash_Draw);
+ *         ...
+ *         
+ */
+void ST7789_Init_FirstFrame(ST7789_FirstFrameTypeDef Draw);
+
 /* .......................... Control .......................... */
 /*
  * Function: ST7789_SetRotation
@@ -466,97 +958,257 @@ void ST7789_InvertColors(ST7789_InvTypeDef Invert);
  *         ...
  *         
  */
-void ST7789_TearEffect(ST7789_ColorModeTypeDef Tear);
+void ST7789_TearEffect(ST7789_TearTypeDef Tear);
 
-/* ...................... Color Converting ..................... */
 /*
- * Function: ST7789_Color_GetFromRGB
- * ---------------------------------
- * Convert RGB color format to RGB565 format
+ * Function: ST7789_RegCache_Invalidate
+ * ------------------------------------
+ * Forget the cached register values, the next write of each register is sent to the LCD.
+ * Call it after the LCD is reset or its registers are changed outside of the library.
  *
  * Param  : 
- *         R : Red value
- *         G : Green value
- *         B : Blue value
+ *         -
  *         
  * Returns: 
- *         RGB565 Code : Converted RGB value
+ *         -
  *         
  * Example: 
- *         ST7789_ColorTypeDef color = ST7789_Color_GetFromRGB(252, 3, 140);
+ *         ST7789_RegCache_Invalidate();
  *         ...
  *         
  */
-ST7789_ColorTypeDef ST7789_Color_GetFromRGB(uint8_t R, uint8_t G, uint8_t B);
+void ST7789_RegCache_Invalidate(void);
 
 /*
- * Function: ST7789_Color_GetFromHex
- * ---------------------------------
- * Convert Hex color code to RGB565 format
+ * Function: ST7789_RegCache_GetStats
+ * ----------------------------------
+ * Get the number of written and skipped commands of the cached registers
  *
  * Param  : 
- *         HexCode : Hex color code
+ *         Stats : Pointer to the statistics
  *         
  * Returns: 
- *         RGB565 Code : Converted RGB value
+ *         -
  *         
  * Example: 
- *         ST7789_ColorTypeDef color = ST7789_Color_GetFromHex(0xFC038C);
+ *         ST7789_RegCacheStatsTypeDef stats;
+ *         
+ *         ST7789_RegCache_GetStats(&stats);
  *         ...
  *         
  */
-ST7789_ColorTypeDef ST7789_Color_GetFromHex(uint32_t HexCode);
+void ST7789_RegCache_GetStats(ST7789_RegCacheStatsTypeDef *Stats);
 
-/* ........................... Fill ............................ */
+/* ........................... Clip ............................ */
 /*
- * Function: ST7789_Fill
- * ---------------------
- * Fill part of the display with the desired color
+ * Function: ST7789_Clip_Push
+ * --------------------------
+ * Limit the drawing to an area, the area is intersected with the pushed areas before it.
+ * Fills, lines, shapes, text and images are cut at the area edges (Partly visible
+ * images and glyphs are drawn).
  *
  * Param  : 
- *         XStart : Start position in the x-axis
- *         YStart : Start position in the y-axis
- *         XEnd   : The end position in the x-axis
- *         YEnd   : The end position in the y-axis
- *         Color  : Desired color to fill the screen
+ *         XStart, YStart : Top left of the area (May be outside of the display)
+ *         XEnd, YEnd     : Bottom right of the area
  *         
  * Returns: 
- *         -
+ *         ST7789_OK    : The area is used
+ *         ST7789_ERROR : ST7789_CLIP_DEPTH areas are already pushed
  *         
  * Example: 
- *         ST7789_Fill(0, 0, 50, 50, ST7789_COLOR_GREEN); // Fill with predefined color
- *         ST7789_Fill(70, 70, 150, 100, ST7789_Color_GetFromHex(0xFC038C)); // Fill with my custom color
+ *         ST7789_Clip_Push(20, 40, 219, 139);
+ *         ST7789_DrawCircle(120, 90, 80, ST7789_COLOR_RED);
+ *         ST7789_Clip_Pop();
  *         ...
  *         
- */
-void ST7789_Fill(uint16_t XStart, uint16_t YStart, uint16_t XEnd, uint16_t YEnd, ST7789_ColorTypeDef Color);
+ */
+ST7789_StatusTypeDef ST7789_Clip_Push(int16_t XStart, int16_t YStart, int16_t XEnd, int16_t YEnd);
 
 /*
- * Function: ST7789_FillScreen
- * ---------------------------
- * Fill the display with the desired color
+ * Function: ST7789_Clip_Pop
+ * -------------------------
+ * Remove the last pushed area, the area before it is used again
  *
  * Param  : 
- *         Color : Desired color to fill the screen
+ *         -
  *         
  * Returns: 
  *         -
  *         
  * Example: 
- *         ST7789_FillScreen(0, 0, 50, 50, ST7789_COLOR_WHITE);
+ *         ST7789_Clip_Pop();
  *         ...
  *         
  */
-void ST7789_FillScreen(ST7789_ColorTypeDef Color);
+void ST7789_Clip_Pop(void);
 
-/* .......................... Drawing .......................... */
+/* ...................... Color Converting ..................... */
 /*
- * Function: ST7789_DrawPixel
- * --------------------------
- * Fill one pixel of the display with the desired color
+ * Function: ST7789_Color_GetFromRGB
+ * ---------------------------------
+ * Convert RGB color format to RGB565 format
  *
  * Param  : 
- *         XPos  : X position of pixel
+ *         R : Red value
+ *         G : Green value
+ *         B : Blue value
+ *         
+ * Returns: 
+ *         RGB565 Code : Converted RGB value
+ *         
+ * Example: 
+ *         ST7789_ColorTypeDef color = ST7789_Color_GetFromRGB(252, 3, 140);
+ *         ...
+ *         
+ */
+ST7789_ColorTypeDef ST7789_Color_GetFromRGB(uint8_t R, uint8_t G, uint8_t B);
+
+/*
+ * Function: ST7789_Color_GetFromHex
+ * ---------------------------------
+ * Convert Hex color code to RGB565 format
+ *
+ * Param  : 
+ *         HexCode : Hex color code
+ *         
+ * Returns: 
+ *         RGB565 Code : Converted RGB value
+ *         
+ * Example: 
+ *         ST7789_ColorTypeDef color = ST7789_Color_GetFromHex(0xFC038C);
+ *         ...
+ *         
+ */
+ST7789_ColorTypeDef ST7789_Color_GetFromHex(uint32_t HexCode);
+
+/*
+ * Function: ST7789_Color_Blend
+ * ----------------------------
+ * Blend two RGB565 colors
+ *
+ * Param  : 
+ *         Color           : Foreground color
+ *         BackgroundColor : Background color
+ *         Alpha           : Opacity of the foreground color (0: Transparent ... 255: Opaque)
+ *         
+ * Returns: 
+ *         RGB565 Code : Blended color
+ *         
+ * Example: 
+ *         ST7789_ColorTypeDef color = ST7789_Color_Blend(ST7789_COLOR_RED, ST7789_COLOR_WHITE, 128);
+ *         ...
+ *         
+ */
+ST7789_ColorTypeDef ST7789_Color_Blend(ST7789_ColorTypeDef Color, ST7789_ColorTypeDef BackgroundColor, uint8_t Alpha);
+
+/* ........................... Fill ............................ */
+/*
+ * Function: ST7789_Fill
+ * ---------------------
+ * Fill part of the display with the desired color
+ *
+ * Param  : 
+ *         XStart : Start position in the x-axis
+ *         YStart : Start position in the y-axis
+ *         XEnd   : The end position in the x-axis
+ *         YEnd   : The end position in the y-axis
+ *         Color  : Desired color to fill the screen
+ *         
+ * Returns: 
+ *         -
+ *         
+ * Example: 
+ *         ST7789_Fill(0, 0, 50, 50, ST7789_COLOR_GREEN); // Fill with predefined color
+ *         ST7789_Fill(70, 70, 150, 100, ST7789_Color_GetFromHex(0xFC038C)); // Fill with my custom color
+ *         ...
+ *         
+ */
+void ST7789_Fill(uint16_t XStart, uint16_t YStart, uint16_t XEnd, uint16_t YEnd, ST7789_ColorTypeDef Color);
+
+/*
+ * Function: ST7789_FillScreen
+ * ---------------------------
+ * Fill the display with the desired color
+ *
+ * Param  : 
+ *         Color : Desired color to fill the screen
+ *         
+ * Returns: 
+ *         -
+ *         
+ * Example: 
+ *         ST7789_FillScreen(0, 0, 50, 50, ST7789_COLOR_WHITE);
+ *         ...
+ *         
+ */
+void ST7789_FillScreen(ST7789_ColorTypeDef Color);
+
+/*
+ * Function: ST7789_FillPattern
+ * ----------------------------
+ * Fill part of the display with a repeated tile. One tile period of rows is expanded
+ * in the LCD buffer and sent again for every period, so a texture costs nearly
+ * the same as a solid fill
+ *
+ * Param  : 
+ *         XStart : Start position in the x-axis
+ *         YStart : Start position in the y-axis
+ *         XEnd   : The end position in the x-axis
+ *         YEnd   : The end position in the y-axis
+ *         Tile   : Pattern tile
+ *         XPhase : Tile column at XStart (Change it to scroll the pattern)
+ *         YPhase : Tile row at YStart
+ *         
+ * Returns: 
+ *         -
+ *         
+ * Example: 
+ *         const uint16_t checkerData[4] = {0xFFFF, 0x0000, 0x0000, 0xFFFF};
+ *         const ST7789_TileTypeDef checker = {checkerData, 2, 2};
+ *         
+ *         ST7789_FillPattern(0, 0, 239, 99, &checker, 0, 0);
+ *         ST7789_FillPattern(0, 100, 239, 139, &Tile_Brick, scroll, 0); // Scrolling background
+ *         ...
+ *         
+ */
+void ST7789_FillPattern(uint16_t XStart, uint16_t YStart, uint16_t XEnd, uint16_t YEnd, const ST7789_TileTypeDef *Tile, uint16_t XPhase, uint16_t YPhase);
+
+/*
+ * Function: ST7789_FillGradient
+ * -----------------------------
+ * Fill part of the display with a gradient, every row is generated in the LCD buffer with
+ * fixed point steps and sent by DMA while the next one is generated. Equal rows are
+ * generated once (horizontal) or sent as solid fills (vertical without dither).
+ *
+ * Param  : 
+ *         XStart   : Start position in the x-axis
+ *         YStart   : Start position in the y-axis
+ *         XEnd     : The end position in the x-axis
+ *         YEnd     : The end position in the y-axis
+ *         Gradient : Mode, colors and points of the gradient
+ *         
+ * Returns: 
+ *         -
+ *         
+ * Example: 
+ *         const ST7789_GradientTypeDef header = {ST7789_GRADIENT_VERTICAL, 0x2945, 0x0010, 0, 0, 0, 0, 0, 1};
+ *         const ST7789_GradientTypeDef glow   = {ST7789_GRADIENT_RADIAL, ST7789_COLOR_WHITE, ST7789_COLOR_BLUE, 120, 140, 0, 0, 100, 1};
+ *         
+ *         ST7789_FillGradient(0, 0, 239, 39, &header);
+ *         ST7789_FillGradient(20, 40, 219, 239, &glow);
+ *         ...
+ *         
+ */
+void ST7789_FillGradient(uint16_t XStart, uint16_t YStart, uint16_t XEnd, uint16_t YEnd, const ST7789_GradientTypeDef *Gradient);
+
+/* .......................... Drawing .......................... */
+/*
+ * Function: ST7789_DrawPixel
+ * --------------------------
+ * Fill one pixel of the display with the desired color
+ *
+ * Param  : 
+ *         XPos  : X position of pixel
  *         YPos  : Y position of pixel
  *         Color : Desired color to fill the pixel
  *         
@@ -590,10 +1242,38 @@ void ST7789_DrawPixel(uint16_t XPos, uint16_t YPos, ST7789_ColorTypeDef Color);
  */
 void ST7789_DrawPixel_4px(uint16_t XPos, uint16_t YPos, ST7789_ColorTypeDef Color);
 
+/*
+ * Function: ST7789_DrawPoints
+ * ---------------------------
+ * Draw many points (scatter plots, sensor maps). The points are sorted by row, horizontally
+ * adjacent points are merged into runs and every run is one window (a run of one color is
+ * one repeat fill), a point on the same pixel again replaces the earlier one.
+ *
+ * Param  : 
+ *         Points : Point array
+ *         Colors : Color of every point (NULL: All points have Color)
+ *         Count  : Number of points
+ *         Color  : Color of the points without a color array
+ *         Order  : Work buffer of Count entries for the row sort (NULL: Drawn in the given
+ *                  order, only the following neighbours of a point are merged)
+ *         
+ * Returns: 
+ *         Saved : Windows saved against one ST7789_DrawPixel per point
+ *         
+ * Example: 
+ *         ST7789_PointTypeDef samples[2000];
+ *         uint16_t            order[2000];
+ *         
+ *         ST7789_DrawPoints(samples, NULL, 2000, ST7789_COLOR_GREEN, order);
+ *         ...
+ *         
+ */
+uint32_t ST7789_DrawPoints(const ST7789_PointTypeDef *Points, const ST7789_ColorTypeDef *Colors, uint16_t Count, ST7789_ColorTypeDef Color, uint16_t *Order);
+
 /*
  * Function: ST7789_DrawLine
  * -------------------------
- * Draw a line on the display
+ * Draw a line on the display, every horizontal (or vertical) run of pixels is one window
  *
  * Param  : 
  *         XStart : Start position of the line in the x-axis
@@ -611,6 +1291,54 @@ void ST7789_DrawPixel_4px(uint16_t XPos, uint16_t YPos, ST7789_ColorTypeDef Colo
  *         
  */
 void ST7789_DrawLine(uint16_t XStart, uint16_t YStart, uint16_t XEnd, uint16_t YEnd, ST7789_ColorTypeDef Color);
+
+/*
+ * Function: ST7789_DrawLine_AA
+ * ----------------------------
+ * Draw an anti-aliased line (Wu) over a known background color, every run of pixel pairs in
+ * the same rows (or columns) is generated in the LCD buffer and sent as one window
+ *
+ * Param  : 
+ *         XStart          : Start position of the line in the x-axis (Clipped to the display)
+ *         YStart          : Start position of the line in the y-axis
+ *         XEnd            : The end position of the line in the x-axis
+ *         YEnd            : The end position of the line in the y-axis
+ *         Color           : Color of the line
+ *         BackgroundColor : Color under the line
+ *         
+ * Returns: 
+ *         -
+ *         
+ * Example: 
+ *         ST7789_DrawLine_AA(10, 200, 230, 40, ST7789_COLOR_YELLOW, ST7789_COLOR_BLACK);
+ *         ...
+ *         
+ */
+void ST7789_DrawLine_AA(int16_t XStart, int16_t YStart, int16_t XEnd, int16_t YEnd, ST7789_ColorTypeDef Color, ST7789_ColorTypeDef BackgroundColor);
+
+/*
+ * Function: ST7789_DrawThickLine
+ * ------------------------------
+ * Draw a wide line, the line with its caps is filled as one span per row
+ *
+ * Param  : 
+ *         XStart : Start position of the line in the x-axis (Clipped to the display)
+ *         YStart : Start position of the line in the y-axis
+ *         XEnd   : The end position of the line in the x-axis
+ *         YEnd   : The end position of the line in the y-axis
+ *         Width  : Width of the line (Pixels)
+ *         Cap    : ST7789_CAP_BUTT, ST7789_CAP_SQUARE or ST7789_CAP_ROUND
+ *         Color  : Color of the line
+ *         
+ * Returns: 
+ *         -
+ *         
+ * Example: 
+ *         ST7789_DrawThickLine(120, 120, needleX, needleY, 5, ST7789_CAP_ROUND, ST7789_COLOR_RED);
+ *         ...
+ *         
+ */
+void ST7789_DrawThickLine(int16_t XStart, int16_t YStart, int16_t XEnd, int16_t YEnd, uint8_t Width, ST7789_LineCapTypeDef Cap, ST7789_ColorTypeDef Color);
 
 /*
  * Function: ST7789_DrawRectangle
@@ -746,85 +1474,836 @@ void ST7789_DrawTriangle(uint16_t X1, uint16_t Y1, uint16_t X2, uint16_t Y2, uin
  */
 void ST7789_DrawFilledTriangle(uint16_t X1, uint16_t Y1, uint16_t X2, uint16_t Y2, uint16_t X3, uint16_t Y3, ST7789_ColorTypeDef Color);
 
-/* ........................... Image ........................... */
 /*
- * Function: ST7789_PutImage
- * -------------------------
- * Show picture on the display
+ * Function: ST7789_FillPolygon
+ * ----------------------------
+ * Fill a polygon (convex, concave or self-intersecting) with a sorted edge table and an active
+ * edge list, every row is one span fill per inside interval. The vertices are the top-left
+ * corners of the pixels, the pixels with the center inside are filled.
  *
  * Param  : 
- *         XPos   : X position of the picture
- *         YPos   : Y position of the picture
- *         Width  : Width of the picture
- *         Height : Height of the picture
- *         Image  : Data of picture in RGB565 format
+ *         Points    : Vertices of the polygon (Closed from the last to the first)
+ *         Count     : Number of the vertices
+ *         Rule      : ST7789_FILL_EVEN_ODD or ST7789_FILL_NON_ZERO
+ *         Color     : Fill color
+ *         Edges     : Edge buffer of the caller (Used only during the call)
+ *         EdgeCount : Length of the edge buffer (Count is always enough)
  *         
  * Returns: 
- *         -
+ *         ST7789_OK    : The polygon is filled
+ *         ST7789_ERROR : Less than 3 vertices or the edge buffer is too short
  *         
  * Example: 
- *         const uint8_t myLogo[] = {.....};
+ *         const ST7789_PointTypeDef arrow[7] = {{20, 50}, {60, 50}, {60, 30}, {100, 70}, {60, 110}, {60, 90}, {20, 90}};
+ *         ST7789_EdgeTypeDef edges[7];
  *         
- *         ST7789_PutImage(100, 100, 140, 50, myLogo);
+ *         ST7789_FillPolygon(arrow, 7, ST7789_FILL_EVEN_ODD, ST7789_COLOR_BROWN, edges, 7);
  *         ...
  *         
- */
-void ST7789_PutImage(uint16_t XPos, uint16_t YPos, uint16_t Width, uint16_t Height, const uint16_t *Image);
+ */
+ST7789_StatusTypeDef ST7789_FillPolygon(const ST7789_PointTypeDef *Points, uint16_t Count, ST7789_FillRuleTypeDef Rule, ST7789_ColorTypeDef Color, ST7789_EdgeTypeDef *Edges, uint16_t EdgeCount);
 
-/* ........................... Text ............................ */
 /*
- * Function: ST7789_PutChar
- * ------------------------
- * Show character on the display
+ * Function: ST7789_DrawPolyline
+ * -----------------------------
+ * Draw connected lines, wide segments have round caps that join them
  *
  * Param  : 
- *         XPos            : X position of the character
- *         YPos            : Y position of the character
- *         Ch              : Ascii character
- *         Font            : Font of character
- *         Color           : Color of character
- *         BackgroundColor : Background color of character
+ *         Points : Points of the line
+ *         Count  : Number of the points
+ *         Width  : Width of the line (0, 1: ST7789_DrawLine)
+ *         Color  : Color of the line
  *         
  * Returns: 
  *         -
  *         
  * Example: 
- *         const uint16_t Font7x10Data[] = {.....}; // Font data's
+ *         ST7789_DrawPolyline(samples, 64, 3, ST7789_COLOR_CYAN);
+ *         ...
  *         
- *         ST7789_FontTypeDef Font_7x10  = {7 , 10, Font7x10Data}; // Define the font
+ */
+void ST7789_DrawPolyline(const ST7789_PointTypeDef *Points, uint16_t Count, uint8_t Width, ST7789_ColorTypeDef Color);
+
+/*
+ * Function: ST7789_DrawRoundRect
+ * ------------------------------
+ * Draw a rectangle with rounded corners, the straight sides are one window each and every
+ * row of a corner is one span
+ *
+ * Param  : 
+ *         XStart : Start position of the rectangle in the x-axis (Clipped to the display)
+ *         YStart : Start position of the rectangle in the y-axis
+ *         XEnd   : The end position of the rectangle in the x-axis
+ *         YEnd   : The end position of the rectangle in the y-axis
+ *         Radius : Radius of the corners (Limited to half of the size)
+ *         Color  : Color of the outline
  *         
- *         ST7789_PutChar(0, 0, 'A', Font_7x10, ST7789_COLOR_BLACK, ST7789_COLOR_WHITE);
+ * Returns: 
+ *         -
+ *         
+ * Example: 
+ *         ST7789_FillRoundRect(10, 10, 229, 69, 8, ST7789_COLOR_DARKBLUE);
+ *         ST7789_DrawRoundRect(10, 10, 229, 69, 8, ST7789_COLOR_WHITE);
  *         ...
  *         
  */
-void ST7789_PutChar(uint16_t XPos, uint16_t YPos, char Ch, ST7789_FontTypeDef Font, ST7789_ColorTypeDef Color, ST7789_ColorTypeDef BackgroundColor);
+void ST7789_DrawRoundRect(int16_t XStart, int16_t YStart, int16_t XEnd, int16_t YEnd, uint16_t Radius, ST7789_ColorTypeDef Color);
 
 /*
- * Function: ST7789_PutString
- * --------------------------
- * Show text on the display
+ * Function: ST7789_FillRoundRect
+ * ------------------------------
+ * Fill a rectangle with rounded corners, the middle rows are one window and every row of the
+ * corners is one span
  *
  * Param  : 
- *         XPos            : X position of the text
- *         YPos            : Y position of the text
- *         Str             : Text in string format
- *         Font            : Font of text
- *         Color           : Color of text
- *         BackgroundColor : Background color of text
+ *         Same as ST7789_DrawRoundRect
  *         
  * Returns: 
  *         -
  *         
  * Example: 
- *         const uint16_t Font7x10Data[] = {.....}; // Font data's
+ *         See ST7789_DrawRoundRect
  *         
- *         ST7789_FontTypeDef Font_7x10  = {7 , 10, Font7x10Data}; // Define the font
+ */
+void ST7789_FillRoundRect(int16_t XStart, int16_t YStart, int16_t XEnd, int16_t YEnd, uint16_t Radius, ST7789_ColorTypeDef Color);
+
+/*
+ * Function: ST7789_DrawEllipse
+ * ----------------------------
+ * Draw an ellipse, the row extents are found with integer steps and every row is one span
+ * (two for the outline)
+ *
+ * Param  : 
+ *         XPos    : Center of the ellipse in the x-axis (Clipped to the display)
+ *         YPos    : Center of the ellipse in the y-axis
+ *         XRadius : Radius in the x-axis
+ *         YRadius : Radius in the y-axis
+ *         Color   : Color of the ellipse
  *         
- *         ST7789_PutString(0, 0, 'Hello', Font_7x10, ST7789_COLOR_BLACK, ST7789_COLOR_WHITE);
+ * Returns: 
+ *         -
+ *         
+ * Example: 
+ *         ST7789_DrawEllipse(120, 140, 80, 40, ST7789_COLOR_YELLOW);
+ *         ST7789_FillEllipse(120, 140, 20, 20, ST7789_COLOR_RED);
  *         ...
  *         
  */
-void ST7789_PutString(uint16_t XPos, uint16_t YPos, const char *Str, ST7789_FontTypeDef Font, ST7789_ColorTypeDef Color, ST7789_ColorTypeDef BackgroundColor);
+void ST7789_DrawEllipse(int16_t XPos, int16_t YPos, uint16_t XRadius, uint16_t YRadius, ST7789_ColorTypeDef Color);
+void ST7789_FillEllipse(int16_t XPos, int16_t YPos, uint16_t XRadius, uint16_t YRadius, ST7789_ColorTypeDef Color);
+
+/*
+ * Function: ST7789_DrawArc
+ * ------------------------
+ * Draw a thick arc (part of a ring), every row is split at the crossings of the start and end
+ * rays only and the parts inside are one span each. The angles are in degrees, 0 is at the
+ * right and the angle grows clockwise.
+ *
+ * Param  : 
+ *         XPos       : Center of the arc in the x-axis (Clipped to the display)
+ *         YPos       : Center of the arc in the y-axis
+ *         Radius     : Outer radius
+ *         Width      : Width of the ring to the center (Radius + 1: Pie)
+ *         StartAngle : Start of the arc
+ *         EndAngle   : End of the arc, clockwise from the start (StartAngle + 360: Full ring)
+ *         Color      : Color of the arc
+ *         
+ * Returns: 
+ *         -
+ *         
+ * Example: 
+ *         // Gauge from 135 to 405 degrees, only the changed part is drawn
+ *         if (newAngle > oldAngle)
+ *         {
+ *             ST7789_DrawArc(120, 120, 100, 12, oldAngle, newAngle, ST7789_COLOR_GREEN);
+ *         }
+ *         else if (newAngle < oldAngle)
+ *         {
+ *             ST7789_DrawArc(120, 120, 100, 12, newAngle, oldAngle, ST7789_COLOR_GRAY);
+ *         }
+ *         ...
+ *         
+ */
+void ST7789_DrawArc(int16_t XPos, int16_t YPos, uint16_t Radius, uint16_t Width, int16_t StartAngle, int16_t EndAngle, ST7789_ColorTypeDef Color);
+
+/* ........................... Image ........................... */
+/*
+ * Function: ST7789_PutImage
+ * -------------------------
+ * Show picture on the display
+ *
+ * Param  : 
+ *         XPos   : X position of the picture
+ *         YPos   : Y position of the picture
+ *         Width  : Width of the picture
+ *         Height : Height of the picture
+ *         Image  : Data of picture in RGB565 format
+ *         
+ * Returns: 
+ *         -
+ *         
+ * Example: 
+ *         const uint8_t myLogo[] = {.....};
+ *         
+ *         ST7789_PutImage(100, 100, 140, 50, myLogo);
+ *         ...
+ *         
+ */
+void ST7789_PutImage(uint16_t XPos, uint16_t YPos, uint16_t Width, uint16_t Height, const uint16_t *Image);
+
+/*
+ * Function: ST7789_PutImage_Keyed
+ * -------------------------------
+ * Show a picture with a transparent key color, every opaque run of a row is sent as its own
+ * window from the image, fully opaque rows are sent together. Only the opaque pixels and
+ * the window setups are written, the display shows through the keyed pixels.
+ *
+ * Param  : 
+ *         XPos   : X position of the picture
+ *         YPos   : Y position of the picture
+ *         Image  : Picture, key color and run table (ST7789_KeyedImage_Build)
+ *         
+ * Returns: 
+ *         -
+ *         
+ * Example: 
+ *         ST7789_KeyedImageTypeDef icon = {iconData, 24, 24, ST7789_COLOR_MAGENTA, iconRuns};
+ *         
+ *         ST7789_PutImage_Keyed(100, 100, &icon);
+ *         ...
+ *         
+ */
+void ST7789_PutImage_Keyed(uint16_t XPos, uint16_t YPos, const ST7789_KeyedImageTypeDef *Image);
+
+/*
+ * Function: ST7789_KeyedImage_Build
+ * ---------------------------------
+ * Find the opaque runs of every row and set the run table of the image. Call it when the
+ * image is loaded, or on the PC (ST7789_HOST) and store the table with the image.
+ *
+ * Param  : 
+ *         Image  : Picture and key color, Runs is set to the table
+ *         Runs   : Memory of the table
+ *         Length : Length of the table (ST7789_KEYED_RUNS_SIZE is always enough)
+ *         
+ * Returns: 
+ *         Used length of the table (0: Too short, Runs is not changed)
+ *         
+ * Example: 
+ *         static uint16_t iconRuns[ST7789_KEYED_RUNS_SIZE(24, 24)];
+ *         ST7789_KeyedImageTypeDef icon = {iconData, 24, 24, ST7789_COLOR_MAGENTA, NULL};
+ *         
+ *         ST7789_KeyedImage_Build(&icon, iconRuns, ST7789_KEYED_RUNS_SIZE(24, 24));
+ *         ...
+ *         
+ */
+uint32_t ST7789_KeyedImage_Build(ST7789_KeyedImageTypeDef *Image, uint16_t *Runs, uint32_t Length);
+
+/*
+ * Function: ST7789_BlitKeyed
+ * --------------------------
+ * Copy a picture with a transparent key color to a frame buffer or band in the MCU memory,
+ * the keyed pixels are skipped and the picture is clipped to the buffer
+ *
+ * Param  : 
+ *         Dest       : Buffer in the ST7789_PutImage format
+ *         DestWidth  : Width of the buffer
+ *         DestHeight : Rows of the buffer
+ *         XPos       : X position of the picture in the buffer (May be negative)
+ *         YPos       : Y position of the picture in the buffer, e.g. YIcon - YBand
+ *         Image      : Picture and key color
+ *         
+ * Returns: 
+ *         -
+ *         
+ * Example: 
+ *         ST7789_BlitKeyed(band, 240, 20, 100, iconY - bandY, &icon);
+ *         ST7789_PutImage(0, bandY, 240, 20, band);
+ *         ...
+ *         
+ */
+void ST7789_BlitKeyed(uint16_t *Dest, uint16_t DestWidth, uint16_t DestHeight, int16_t XPos, int16_t YPos, const ST7789_KeyedImageTypeDef *Image);
+
+/*
+ * Function: ST7789_DrawLine_AA_Buffer
+ * -----------------------------------
+ * Draw an anti-aliased line (Wu) in a frame buffer or band in the MCU memory, the line is
+ * blended with the content of the buffer and clipped to it
+ *
+ * Param  : 
+ *         Dest       : Buffer in the ST7789_PutImage format
+ *         DestWidth  : Width of the buffer
+ *         DestHeight : Rows of the buffer
+ *         XStart     : Start position of the line in the buffer
+ *         YStart     : Start position of the line in the buffer, e.g. Y - YBand
+ *         XEnd       : The end position of the line in the buffer
+ *         YEnd       : The end position of the line in the buffer
+ *         Color      : Color of the line
+ *         
+ * Returns: 
+ *         -
+ *         
+ * Example: 
+ *         ST7789_DrawLine_AA_Buffer(band, 240, 20, 0, y1 - bandY, 239, y2 - bandY, ST7789_COLOR_GREEN);
+ *         ST7789_PutImage(0, bandY, 240, 20, band);
+ *         ...
+ *         
+ */
+void ST7789_DrawLine_AA_Buffer(uint16_t *Dest, uint16_t DestWidth, uint16_t DestHeight, int16_t XStart, int16_t YStart, int16_t XEnd, int16_t YEnd, ST7789_ColorTypeDef Color);
+
+/*
+ * Function: ST7789_WritePixels
+ * ----------------------------
+ * Continue the memory write in the window of ST7789_SetWindowAddress, the pixels are written
+ * row by row. The transfer may run in the background, keep the pixels until the next LCD access
+ * or ST7789_WaitForTransfer.
+ *
+ * Param  : 
+ *         Pixels : Pixels in the ST7789_PutImage format
+ *         Count  : Number of pixels
+ *         
+ * Returns: 
+ *         -
+ *         
+ * Example: 
+ *         ST7789_SetWindowAddress(0, 0, 99, 49);
+ *         ST7789_WritePixels(band, 100 * 10); // Rows 0..9
+ *         ST7789_WritePixels(band, 100 * 10); // Rows 10..19
+ *         ...
+ *         
+ */
+void ST7789_WritePixels(const uint16_t *Pixels, uint32_t Count);
+
+/* ........................... Text ............................ */
+/*
+ * Function: ST7789_PutChar
+ * ------------------------
+ * Show character on the display
+ *
+ * Param  : 
+ *         XPos            : X position of the character
+ *         YPos            : Y position of the character
+ *         Ch              : Ascii character
+ *         Font            : Font of character
+ *         Color           : Color of character
+ *         BackgroundColor : Background color of character
+ *         
+ * Returns: 
+ *         -
+ *         
+ * Example: 
+ *         const uint16_t Font7x10Data[] = {.....}; // Font data's
+ *         
+ *         ST7789_FontTypeDef Font_7x10  = {7 , 10, Font7x10Data}; // Define the font
+ *         
+ *         ST7789_PutChar(0, 0, 'A', Font_7x10, ST7789_COLOR_BLACK, ST7789_COLOR_WHITE);
+ *         ...
+ *         
+ */
+void ST7789_PutChar(uint16_t XPos, uint16_t YPos, char Ch, ST7789_FontTypeDef Font, ST7789_ColorTypeDef Color, ST7789_ColorTypeDef BackgroundColor);
+
+/*
+ * Function: ST7789_PutString
+ * --------------------------
+ * Show text on the display
+ *
+ * Param  : 
+ *         XPos            : X position of the text
+ *         YPos            : Y position of the text
+ *         Str             : Text in string format
+ *         Font            : Font of text
+ *         Color           : Color of text
+ *         BackgroundColor : Background color of text
+ *         
+ * Returns: 
+ *         -
+ *         
+ * Example: 
+ *         const uint16_t Font7x10Data[] = {.....}; // Font data's
+ *         
+ *         ST7789_FontTypeDef Font_7x10  = {7 , 10, Font7x10Data}; // Define the font
+ *         
+ *         ST7789_PutString(0, 0, 'Hello', Font_7x10, ST7789_COLOR_BLACK, ST7789_COLOR_WHITE);
+ *         ...
+ *         
+ */
+void ST7789_PutString(uint16_t XPos, uint16_t YPos, const char *Str, ST7789_FontTypeDef Font, ST7789_ColorTypeDef Color, ST7789_ColorTypeDef BackgroundColor);
+
+/* ......................... Readback .......................... */
+/*
+ * Function: ST7789_ReadRegion
+ * ---------------------------
+ * Read a region of the display memory (RAMRD), the SPI clock is lowered by
+ * ST7789_SPI_SetReadClock during the read
+ *
+ * Notice : The SDO (MISO) pin of the LCD must be connected.
+ *
+ * Param  : 
+ *         XStart : Start position of the region in the x-axis
+ *         YStart : Start position of the region in the y-axis
+ *         XEnd   : The end position of the region in the x-axis
+ *         YEnd   : The end position of the region in the y-axis
+ *         Buffer : RGB565 pixels of the region (Width x Height)
+ *         
+ * Returns: 
+ *         ST7789_OK    : Region is read
+ *         ST7789_ERROR : Region is out of the display
+ *         
+ * Example: 
+ *         uint16_t pixels[10 * 10];
+ *         
+ *         ST7789_ReadRegion(0, 0, 9, 9, pixels);
+ *         ...
+ *         
+ */
+ST7789_StatusTypeDef ST7789_ReadRegion(uint16_t XStart, uint16_t YStart, uint16_t XEnd, uint16_t YEnd, uint16_t *Buffer);
+
+/*
+ * Function: ST7789_ReadPixel
+ * --------------------------
+ * Read one pixel of the display memory
+ *
+ * Param  : 
+ *         XPos : X position of pixel
+ *         YPos : Y position of pixel
+ *         
+ * Returns: 
+ *         RGB565 Code : Color of the pixel
+ *         
+ * Example: 
+ *         ST7789_ColorTypeDef color = ST7789_ReadPixel(10, 10);
+ *         ...
+ *         
+ */
+ST7789_ColorTypeDef ST7789_ReadPixel(uint16_t XPos, uint16_t YPos);
+
+/*
+ * Function: ST7789_FillBlend
+ * --------------------------
+ * Fill part of the display with a translucent color over the current content
+ *
+ * Param  : 
+ *         XStart : Start position in the x-axis
+ *         YStart : Start position in the y-axis
+ *         XEnd   : The end position in the x-axis
+ *         YEnd   : The end position in the y-axis
+ *         Color  : Overlay color
+ *         Alpha  : Opacity of the overlay (0: Transparent ... 255: Opaque)
+ *         
+ * Returns: 
+ *         -
+ *         
+ * Example: 
+ *         ST7789_FillBlend(0, 0, 239, 39, ST7789_COLOR_BLACK, 96); // Darken the header
+ *         ...
+ *         
+ */
+void ST7789_FillBlend(uint16_t XStart, uint16_t YStart, uint16_t XEnd, uint16_t YEnd, ST7789_ColorTypeDef Color, uint8_t Alpha);
+
+/*
+ * Function: ST7789_DrawPixel_Blend
+ * --------------------------------
+ * Blend one pixel with the current content, e.g. for anti-aliased edges
+ *
+ * Param  : 
+ *         XPos  : X position of pixel
+ *         YPos  : Y position of pixel
+ *         Color : Color of pixel
+ *         Alpha : Coverage of the pixel (0 ... 255)
+ *         
+ * Returns: 
+ *         -
+ *         
+ * Example: 
+ *         ST7789_DrawPixel_Blend(10, 10, ST7789_COLOR_RED, 64);
+ *         ...
+ *         
+ */
+void ST7789_DrawPixel_Blend(uint16_t XPos, uint16_t YPos, ST7789_ColorTypeDef Color, uint8_t Alpha);
+
+/* .......................... Staging .......................... */
+/*
+ * Function: ST7789_Staging_Enable
+ * -------------------------------
+ * Enable off-screen staging for a full width strip at the top or the bottom edge
+ * of the display (See 'Off-screen Staging Rows' for the supported heights)
+ *
+ * Param  :
+ *         YStart : Start position of the strip in the y-axis
+ *         Height : Height of the strip
+ *
+ * Returns:
+ *         ST7789_OK    : Staging is enabled
+ *         ST7789_ERROR : The strip is not supported by the panel geometry
+ *
+ * Example:
+ *         ST7789_Staging_Enable(ST7789_HEIGHT_MODIFIED - 20, 20); // 20 rows at the bottom
+ *         ...
+ *
+ */
+ST7789_StatusTypeDef ST7789_Staging_Enable(uint16_t YStart, uint16_t Height);
+
+/*
+ * Function: ST7789_Staging_Begin
+ * ------------------------------
+ * Redirect the next drawings inside the strip to the hidden rows
+ *
+ * Param  :
+ *         -
+ *
+ * Returns:
+ *         -
+ *
+ * Example:
+ *         ST7789_Staging_Begin();
+ *         ST7789_PutString(0, 262, "12:45", Font_11x18, ST7789_COLOR_WHITE, ST7789_COLOR_BLACK);
+ *         ST7789_Staging_Commit();
+ *         ...
+ *
+ */
+void ST7789_Staging_Begin(void);
+
+/*
+ * Function: ST7789_Staging_Commit
+ * -------------------------------
+ * Show the staged content of the strip, the swap takes effect in the next frame
+ *
+ * Param  :
+ *         -
+ *
+ * Returns:
+ *         -
+ *
+ * Example:
+ *         ST7789_Staging_Commit();
+ *         ...
+ *
+ */
+void ST7789_Staging_Commit(void);
+
+/*
+ * Function: ST7789_Staging_Disable
+ * --------------------------------
+ * Disable off-screen staging and restore the default scroll area
+ *
+ * Notice : The strip shows its original rows again, redraw it if the last commit
+ *          was on the hidden rows.
+ *
+ * Param  :
+ *         -
+ *
+ * Returns:
+ *         -
+ *
+ * Example:
+ *         ST7789_Staging_Disable();
+ *         ...
+ *
+ */
+void ST7789_Staging_Disable(void);
+
+/* .......................... Scroll ........................... */
+/*
+ * Function: ST7789_Scroll_Enable
+ * ------------------------------
+ * Enable the hardware scroll of a range of columns, every row of these columns
+ * is scrolled (Rotation 1 and 3, the scroll direction of the panel is the x-axis)
+ *
+ * Param  :
+ *         XStart : First scrolled column
+ *         Width  : Scrolled columns
+ *
+ * Returns:
+ *         ST7789_OK    : Scrolling is enabled, the content is not moved yet
+ *         ST7789_ERROR : Rotation 0 or 2 (See ST7789_Staging_Enable), or the columns are outside of the display
+ *
+ * Example:
+ *         ST7789_Scroll_Enable(40, 200);
+ *         ...
+ *
+ */
+ST7789_StatusTypeDef ST7789_Scroll_Enable(uint16_t XStart, uint16_t Width);
+
+/*
+ * Function: ST7789_Scroll_Left
+ * ----------------------------
+ * Move the content of the scrolled columns one column to the left, the left-most
+ * column comes in at the right side, only the scroll start address is written
+ *
+ * Param  :
+ *         -
+ *
+ * Returns:
+ *         -
+ *
+ * Example:
+ *         ST7789_Scroll_Left();
+ *         ST7789_Fill(ST7789_Scroll_GetColumn(239), 0, ST7789_Scroll_GetColumn(239), 239, ST7789_COLOR_BLACK); // New right column
+ *         ...
+ *
+ */
+void ST7789_Scroll_Left(void);
+
+/*
+ * Function: ST7789_Scroll_GetColumn
+ * ---------------------------------
+ * Get the column to draw to for the content shown at a column, the drawings
+ * inside the scrolled columns are shown at their scrolled position
+ *
+ * Param  :
+ *         XPos : Shown column
+ *
+ * Returns:
+ *         Column : Column of the drawing functions (XPos when it is not scrolled)
+ *
+ * Example:
+ *         x = ST7789_Scroll_GetColumn(239);
+ *         ST7789_DrawLine(x, 0, x, 239, ST7789_COLOR_WHITE); // Line at the right edge
+ *         ...
+ *
+ */
+uint16_t ST7789_Scroll_GetColumn(uint16_t XPos);
+
+/*
+ * Function: ST7789_Scroll_Disable
+ * -------------------------------
+ * Disable the hardware scroll and restore the default scroll area
+ *
+ * Notice : The columns show their content without the scroll offset again, redraw them.
+ *
+ * Param  :
+ *         -
+ *
+ * Returns:
+ *         -
+ *
+ * Example:
+ *         ST7789_Scroll_Disable();
+ *         ...
+ *
+ */
+void ST7789_Scroll_Disable(void);
+
+/* ......................... Transfer .......................... */
+/*
+ * Function: ST7789_WaitForTransfer
+ * --------------------------------
+ * Wait for the last DMA transfer and release the LCD. Long transfers (PutImage, FillScreen, ...) run
+ * in the background after the function returns, call it before the source data is changed.
+ * With an OS (st7789_os.h) the task blocks until ST7789_Disp_TxCpltCallback is called.
+ *
+ * Param  : 
+ *         -
+ *         
+ * Returns: 
+ *         -
+ *         
+ * Example: 
+ *         ST7789_PutImage(0, 0, 240, 40, frameBuffer);
+ *         ST7789_WaitForTransfer();
+ *         ...
+ *         
+ */
+void ST7789_WaitForTransfer(void);
+
+/* .......................... Memory ........................... */
+/*
+ * Function: ST7789_AddMemory
+ * --------------------------
+ * Give a memory region to the driver, the chunk sizes follow the received memory at runtime.
+ * The largest DMA region is the transmit buffer (fills, glyphs, patterns), the next region is
+ * the scratch of the GRAM read decode. Call it before ST7789_Init to replace the static LCD
+ * buffer (ST7789_HOR_LEN 0), or later to add memory. The region is trimmed to whole words
+ * (whole cache lines on Cortex-M7, see ST7789_CACHE_CLEAN).
+ *
+ * Param  : 
+ *         Memory : Start of the region
+ *         Size   : Size of the region (Bytes)
+ *         Type   : ST7789_MEM_DMA (SRAM, SDRAM) or ST7789_MEM_CPU (e.g. CCM, not used for DMA transfers)
+ *         
+ * Returns: 
+ *         ST7789_OK    : Region is used
+ *         ST7789_ERROR : Region is too small or smaller than the current buffers
+ *         
+ * Example: 
+ *         ST7789_AddMemory((void *)0xC0000000, 240 * 320 * 2, ST7789_MEM_DMA); // External SDRAM
+ *         ST7789_AddMemory(ccmScratch, sizeof(ccmScratch), ST7789_MEM_CPU);
+ *         ST7789_Init();
+ *         ...
+ *         
+ */
+ST7789_StatusTypeDef ST7789_AddMemory(void *Memory, uint32_t Size, ST7789_MemTypeDef Type);
+
+/* ............................ OS ............................. */
+/*
+ * Function: ST7789_GetLockStats
+ * -----------------------------
+ * Get the lock statistics of the display mutex, the contentions and the wait time show how long
+ * the tasks waited for each other (st7789_os.h, zero without an OS)
+ *
+ * Param  : 
+ *         Stats : Pointer to the statistics
+ *         
+ * Returns: 
+ *         -
+ *         
+ * Example: 
+ *         ST7789_OSStatsTypeDef stats;
+ *         
+ *         ST7789_GetLockStats(&stats);
+ *         printf("%lu of %lu locks waited %lu us\n", stats.Contentions, stats.Locks, stats.WaitTime);
+ *         ...
+ *         
+ */
+void ST7789_GetLockStats(ST7789_OSStatsTypeDef *Stats);
+
+/* ...................... Display Handle ....................... */
+/*
+ * Function: ST7789_Disp_Init
+ * --------------------------
+ * Initialize the display of the handle, the ST7789_xxx functions use the ST7789_Display handle.
+ * Every display has its own bus, pins, buffer and state, so the DMA transfers of several
+ * displays run at the same time.
+ *
+ * Param  : 
+ *         hlcd : Display handle, the bus, geometry and buffer fields must be set
+ *         
+ * Returns: 
+ *         -
+ *         
+ * Example: 
+ *         uint16_t lcd2Buffer[240 * 5];
+ *         ST7789_HandleTypeDef lcd2 = {0};
+ *         
+ *         lcd2.Bus          = &ST7789_Bus_SPI;
+ *         lcd2.BusContext   = NULL;
+ *         lcd2.SPI          = &hspi3;
+ *         lcd2.RSTPort      = LCD2_RST_GPIO_Port;
+ *         lcd2.RSTPin       = LCD2_RST_Pin;
+ *         lcd2.CSPort       = LCD2_CS_GPIO_Port;
+ *         lcd2.CSPin        = LCD2_CS_Pin;
+ *         lcd2.DCPort       = LCD2_DC_GPIO_Port;
+ *         lcd2.DCPin        = LCD2_DC_Pin;
+ *         lcd2.PanelWidth   = 240;
+ *         lcd2.PanelHeight  = 240;
+ *         lcd2.Rotation     = 2;
+ *         lcd2.Buffer       = lcd2Buffer;
+ *         lcd2.BufferLength = 240 * 5;
+ *         
+ *         ST7789_Disp_Init(&lcd2);
+ *         ST7789_Disp_FillScreen(&lcd2, ST7789_COLOR_BLUE);
+ *         ...
+ *         
+ */
+void ST7789_Disp_Init(ST7789_HandleTypeDef *hlcd);
+
+/*
+ * Function: ST7789_Disp_TxCpltCallback
+ * ------------------------------------
+ * Start the next DMA packet of a long transfer (> 64KB on SPI), or release the LCD when the last one is completed.
+ * Without the call the rest is sent by ST7789_Disp_WaitForTransfer, i.e. at the next access to the LCD.
+ * With an OS it wakes the task that waits for the transfer, call it from the SPI interrupt.
+ *
+ * Param  : 
+ *         hlcd : Display handle
+ *         
+ * Returns: 
+ *         -
+ *         
+ * Example: 
+ *         void HAL_SPI_TxCpltCallback(SPI_HandleTypeDef *hspi)
+ *         {
+ *             if (hspi == lcd2.SPI)
+ *             {
+ *                 ST7789_Disp_TxCpltCallback(&lcd2);
+ *             }
+ *         }
+ *         
+ */
+void ST7789_Disp_TxCpltCallback(ST7789_HandleTypeDef *hlcd);
+
+/*
+ * Function: ST7789_Disp_xxx
+ * -------------------------
+ * The functions of the display handle, same as the ST7789_xxx functions
+ */
+/* Initialize */
+void ST7789_Disp_Init_FirstFrame(ST7789_HandleTypeDef *hlcd, ST7789_FirstFrameTypeDef Draw);
+
+/* Control */
+void ST7789_Disp_SetRotation(ST7789_HandleTypeDef *hlcd, uint8_t Rotation);
+void ST7789_Disp_SetWindowAddress(ST7789_HandleTypeDef *hlcd, uint16_t XStart, uint16_t YStart, uint16_t XEnd, uint16_t YEnd);
+void ST7789_Disp_InvertColors(ST7789_HandleTypeDef *hlcd, ST7789_InvTypeDef Invert);
+void ST7789_Disp_TearEffect(ST7789_HandleTypeDef *hlcd, ST7789_TearTypeDef Tear);
+void ST7789_Disp_RegCache_Invalidate(ST7789_HandleTypeDef *hlcd);
+void ST7789_Disp_RegCache_GetStats(ST7789_HandleTypeDef *hlcd, ST7789_RegCacheStatsTypeDef *Stats);
+
+/* Clip */
+ST7789_StatusTypeDef ST7789_Disp_Clip_Push(ST7789_HandleTypeDef *hlcd, int16_t XStart, int16_t YStart, int16_t XEnd, int16_t YEnd);
+void ST7789_Disp_Clip_Pop(ST7789_HandleTypeDef *hlcd);
+
+/* Fill */
+void ST7789_Disp_Fill(ST7789_HandleTypeDef *hlcd, uint16_t XStart, uint16_t YStart, uint16_t XEnd, uint16_t YEnd, ST7789_ColorTypeDef Color);
+void ST7789_Disp_FillScreen(ST7789_HandleTypeDef *hlcd, ST7789_ColorTypeDef Color);
+void ST7789_Disp_FillPattern(ST7789_HandleTypeDef *hlcd, uint16_t XStart, uint16_t YStart, uint16_t XEnd, uint16_t YEnd, const ST7789_TileTypeDef *Tile, uint16_t XPhase, uint16_t YPhase);
+void ST7789_Disp_FillGradient(ST7789_HandleTypeDef *hlcd, uint16_t XStart, uint16_t YStart, uint16_t XEnd, uint16_t YEnd, const ST7789_GradientTypeDef *Gradient);
+
+/* Drawing */
+void ST7789_Disp_DrawPixel(ST7789_HandleTypeDef *hlcd, uint16_t XPos, uint16_t YPos, ST7789_ColorTypeDef Color);
+void ST7789_Disp_DrawPixel_4px(ST7789_HandleTypeDef *hlcd, uint16_t XPos, uint16_t YPos, ST7789_ColorTypeDef Color);
+uint32_t ST7789_Disp_DrawPoints(ST7789_HandleTypeDef *hlcd, const ST7789_PointTypeDef *Points, const ST7789_ColorTypeDef *Colors, uint16_t Count, ST7789_ColorTypeDef Color, uint16_t *Order);
+void ST7789_Disp_DrawLine(ST7789_HandleTypeDef *hlcd, uint16_t XStart, uint16_t YStart, uint16_t XEnd, uint16_t YEnd, ST7789_ColorTypeDef Color);
+void ST7789_Disp_DrawLine_AA(ST7789_HandleTypeDef *hlcd, int16_t XStart, int16_t YStart, int16_t XEnd, int16_t YEnd, ST7789_ColorTypeDef Color, ST7789_ColorTypeDef BackgroundColor);
+void ST7789_Disp_DrawThickLine(ST7789_HandleTypeDef *hlcd, int16_t XStart, int16_t YStart, int16_t XEnd, int16_t YEnd, uint8_t Width, ST7789_LineCapTypeDef Cap, ST7789_ColorTypeDef Color);
+void ST7789_Disp_DrawRectangle(ST7789_HandleTypeDef *hlcd, uint16_t XStart, uint16_t YStart, uint16_t XEnd, uint16_t YEnd, ST7789_ColorTypeDef Color);
+void ST7789_Disp_DrawFilledRectangle(ST7789_HandleTypeDef *hlcd, uint16_t XPos, uint16_t YPos, uint16_t Width, uint16_t Height, ST7789_ColorTypeDef Color);
+void ST7789_Disp_DrawCircle(ST7789_HandleTypeDef *hlcd, uint16_t XPos, uint16_t YPos, uint8_t Radius, ST7789_ColorTypeDef Color);
+void ST7789_Disp_DrawFilledCircle(ST7789_HandleTypeDef *hlcd, int16_t XPos, int16_t YPos, int16_t Radius, ST7789_ColorTypeDef Color);
+void ST7789_Disp_DrawTriangle(ST7789_HandleTypeDef *hlcd, uint16_t X1, uint16_t Y1, uint16_t X2, uint16_t Y2, uint16_t X3, uint16_t Y3, ST7789_ColorTypeDef Color);
+void ST7789_Disp_DrawFilledTriangle(ST7789_HandleTypeDef *hlcd, uint16_t X1, uint16_t Y1, uint16_t X2, uint16_t Y2, uint16_t X3, uint16_t Y3, ST7789_ColorTypeDef Color);
+ST7789_StatusTypeDef ST7789_Disp_FillPolygon(ST7789_HandleTypeDef *hlcd, const ST7789_PointTypeDef *Points, uint16_t Count, ST7789_FillRuleTypeDef Rule, ST7789_ColorTypeDef Color, ST7789_EdgeTypeDef *Edges, uint16_t EdgeCount);
+void ST7789_Disp_DrawPolyline(ST7789_HandleTypeDef *hlcd, const ST7789_PointTypeDef *Points, uint16_t Count, uint8_t Width, ST7789_ColorTypeDef Color);
+void ST7789_Disp_DrawRoundRect(ST7789_HandleTypeDef *hlcd, int16_t XStart, int16_t YStart, int16_t XEnd, int16_t YEnd, uint16_t Radius, ST7789_ColorTypeDef Color);
+void ST7789_Disp_FillRoundRect(ST7789_HandleTypeDef *hlcd, int16_t XStart, int16_t YStart, int16_t XEnd, int16_t YEnd, uint16_t Radius, ST7789_ColorTypeDef Color);
+void ST7789_Disp_DrawEllipse(ST7789_HandleTypeDef *hlcd, int16_t XPos, int16_t YPos, uint16_t XRadius, uint16_t YRadius, ST7789_ColorTypeDef Color);
+void ST7789_Disp_FillEllipse(ST7789_HandleTypeDef *hlcd, int16_t XPos, int16_t YPos, uint16_t XRadius, uint16_t YRadius, ST7789_ColorTypeDef Color);
+void ST7789_Disp_DrawArc(ST7789_HandleTypeDef *hlcd, int16_t XPos, int16_t YPos, uint16_t Radius, uint16_t Width, int16_t StartAngle, int16_t EndAngle, ST7789_ColorTypeDef Color);
+
+/* Image */
+void ST7789_Disp_PutImage(ST7789_HandleTypeDef *hlcd, uint16_t XPos, uint16_t YPos, uint16_t Width, uint16_t Height, const uint16_t *Image);
+void ST7789_Disp_WritePixels(ST7789_HandleTypeDef *hlcd, const uint16_t *Pixels, uint32_t Count);
+void ST7789_Disp_PutImage_Keyed(ST7789_HandleTypeDef *hlcd, uint16_t XPos, uint16_t YPos, const ST7789_KeyedImageTypeDef *Image);
+
+/* Text */
+void ST7789_Disp_PutChar(ST7789_HandleTypeDef *hlcd, uint16_t XPos, uint16_t YPos, char Ch, ST7789_FontTypeDef Font, ST7789_ColorTypeDef Color, ST7789_ColorTypeDef BackgroundColor);
+void ST7789_Disp_PutString(ST7789_HandleTypeDef *hlcd, uint16_t XPos, uint16_t YPos, const char *Str, ST7789_FontTypeDef Font, ST7789_ColorTypeDef Color, ST7789_ColorTypeDef BackgroundColor);
+
+/* Readback */
+ST7789_StatusTypeDef ST7789_Disp_ReadRegion(ST7789_HandleTypeDef *hlcd, uint16_t XStart, uint16_t YStart, uint16_t XEnd, uint16_t YEnd, uint16_t *Buffer);
+ST7789_ColorTypeDef ST7789_Disp_ReadPixel(ST7789_HandleTypeDef *hlcd, uint16_t XPos, uint16_t YPos);
+void ST7789_Disp_FillBlend(ST7789_HandleTypeDef *hlcd, uint16_t XStart, uint16_t YStart, uint16_t XEnd, uint16_t YEnd, ST7789_ColorTypeDef Color, uint8_t Alpha);
+void ST7789_Disp_DrawPixel_Blend(ST7789_HandleTypeDef *hlcd, uint16_t XPos, uint16_t YPos, ST7789_ColorTypeDef Color, uint8_t Alpha);
+
+/* Staging */
+ST7789_StatusTypeDef ST7789_Disp_Staging_Enable(ST7789_HandleTypeDef *hlcd, uint16_t YStart, uint16_t Height);
+void ST7789_Disp_Staging_Begin(ST7789_HandleTypeDef *hlcd);
+void ST7789_Disp_Staging_Commit(ST7789_HandleTypeDef *hlcd);
+void ST7789_Disp_Staging_Disable(ST7789_HandleTypeDef *hlcd);
+
+/* Scroll */
+ST7789_StatusTypeDef ST7789_Disp_Scroll_Enable(ST7789_HandleTypeDef *hlcd, uint16_t XStart, uint16_t Width);
+void ST7789_Disp_Scroll_Left(ST7789_HandleTypeDef *hlcd);
+uint16_t ST7789_Disp_Scroll_GetColumn(ST7789_HandleTypeDef *hlcd, uint16_t XPos);
+void ST7789_Disp_Scroll_Disable(ST7789_HandleTypeDef *hlcd);
+
+/* Transfer */
+void ST7789_Disp_WaitForTransfer(ST7789_HandleTypeDef *hlcd);
+
+/* Memory */
+ST7789_StatusTypeDef ST7789_Disp_AddMemory(ST7789_HandleTypeDef *hlcd, void *Memory, uint32_t Size, ST7789_MemTypeDef Type);
+
+/* OS */
+void ST7789_Disp_GetLockStats(ST7789_HandleTypeDef *hlcd, ST7789_OSStatsTypeDef *Stats);
 
 /* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ End of the program ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
 #endif /* __ST7789_H_ */
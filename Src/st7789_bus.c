@@ -0,0 +1,1097 @@
+/*
+------------------------------------------------------------------------------
+~ File   : st7789_bus.c
+~ Author : Majid Derhambakhsh
+~ Version: V1.0.0
+~ Created: 08/25/2023 18:00:00 PM
+~ Brief  : Bus backends of the ST7789 driver (SPI, 8080 parallel on FMC, host mock)
+~ Support:
+           E-Mail : Majid.Derhambakhsh@gmail.com (subject : Embedded Library Support)
+
+           Github : https://github.com/Majid-Derhambakhsh
+------------------------------------------------------------------------------
+~ Description:
+
+~ Attention  :
+
+~ Changes    :
+------------------------------------------------------------------------------
+*/
+
+/* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ Include ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+#include "st7789_bus.h"
+
+#include <string.h>
+
+/* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ Function ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+/* ............................ SPI ............................ */
+static void ST7789_SPIBus_WriteCommand(ST7789_HandleTypeDef *hlcd, uint8_t Command)
+{
+	
+	(void)hlcd; // Not used by the host GPIO and SPI macros
+	
+	/* ---------------- Select Chip ----------------- */
+	ST7789_GPIO_WritePin(ST7789_GPIO_PORT(hlcd->CSPort), hlcd->CSPin, ST7789_GPIO_PIN_RESET);
+	
+	/* ------------- Set to Command Mode ------------ */
+	ST7789_GPIO_WritePin(ST7789_GPIO_PORT(hlcd->DCPort), hlcd->DCPin, ST7789_GPIO_PIN_RESET);
+	
+	/* ---------------- Transmit Data --------------- */
+	ST7789_SPI_Transmit(hlcd->SPI, &Command, 1, ST7789_SPI_TIMEOUT);
+	
+}
+
+static void ST7789_SPIBus_WriteData(ST7789_HandleTypeDef *hlcd, const uint8_t *Data, uint16_t Size)
+{
+	
+	(void)hlcd;
+	
+	/* ---------------- Select Chip ----------------- */
+	ST7789_GPIO_WritePin(ST7789_GPIO_PORT(hlcd->CSPort), hlcd->CSPin, ST7789_GPIO_PIN_RESET);
+	
+	/* -------------- Set to Data Mode -------------- */
+	ST7789_GPIO_WritePin(ST7789_GPIO_PORT(hlcd->DCPort), hlcd->DCPin, ST7789_GPIO_PIN_SET);
+	
+	/* ---------------- Transmit Data --------------- */
+	ST7789_SPI_Transmit(hlcd->SPI, (uint8_t *)Data, Size, ST7789_SPI_TIMEOUT);
+	
+}
+
+static void ST7789_SPIBus_WriteBulk(ST7789_HandleTypeDef *hlcd, const uint8_t *Data, uint32_t Size)
+{
+	
+	uint16_t tSize;
+	
+	(void)hlcd;
+	
+	/* ---------------- Select Chip ----------------- */
+	ST7789_GPIO_WritePin(ST7789_GPIO_PORT(hlcd->CSPort), hlcd->CSPin, ST7789_GPIO_PIN_RESET);
+	
+	/* -------------- Set to Data Mode -------------- */
+	ST7789_GPIO_WritePin(ST7789_GPIO_PORT(hlcd->DCPort), hlcd->DCPin, ST7789_GPIO_PIN_SET);
+	
+	/* ---------------- Transmit Data --------------- */
+	while (Size > 0)
+	{
+	
+		/* ~~~~~~~~~~~~~~~ Calculate transmit size ~~~~~~~~~~~~~~~ */
+		tSize = Size > UINT16_MAX ? UINT16_MAX : Size;
+	
+		/* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+		#ifdef ST7789_USE_DMA
+	
+		if (ST7789_DMA_MIN_SIZE <= tSize)
+		{
+	
+			ST7789_SPI_Transmit_DMA(hlcd->SPI, (uint8_t *)Data, tSize);
+			while (ST7789_SPI_IsBusy(hlcd->SPI)) { ST7789_OS_YIELD(); }
+	
+		}
+		else
+		{
+			ST7789_SPI_Transmit(hlcd->SPI, (uint8_t *)Data, tSize, ST7789_SPI_TIMEOUT);
+		}
+	
+		#else
+	
+		ST7789_SPI_Transmit(hlcd->SPI, (uint8_t *)Data, tSize, ST7789_SPI_TIMEOUT);
+	
+		#endif
+	
+		Data += tSize;
+		Size -= tSize;
+	
+	}
+	
+}
+
+#ifdef ST7789_USE_DMA
+
+static void ST7789_SPIBus_WriteBulkAsync(ST7789_HandleTypeDef *hlcd, const uint8_t *Data, uint32_t Size)
+{
+	
+	/* DMA moves up to UINT16_MAX bytes, ST7789_Disp_TxCpltCallback starts the next packet from the rest */
+	uint16_t tSize = (Size > UINT16_MAX) ? UINT16_MAX : (uint16_t)Size;
+	
+	hlcd->TxData = Data + tSize;
+	hlcd->TxSize = Size - tSize;
+	
+	/* ---------------- Select Chip ----------------- */
+	ST7789_GPIO_WritePin(ST7789_GPIO_PORT(hlcd->CSPort), hlcd->CSPin, ST7789_GPIO_PIN_RESET);
+	
+	/* -------------- Set to Data Mode -------------- */
+	ST7789_GPIO_WritePin(ST7789_GPIO_PORT(hlcd->DCPort), hlcd->DCPin, ST7789_GPIO_PIN_SET);
+	
+	/* ---------------- Start the Packet ------------ */
+	ST7789_SPI_Transmit_DMA(hlcd->SPI, (uint8_t *)Data, tSize);
+	
+}
+
+#endif
+
+#if defined(ST7789_USE_DMA) && defined(USE_HAL_DRIVER)
+
+static void ST7789_SPIBus_SetRepeatMode(SPI_HandleTypeDef *hspi, uint8_t Repeat)
+{
+	
+	/* -------- 16-bit Frames, Fixed DMA Source ------- */
+	hspi->Init.DataSize                    = Repeat ? SPI_DATASIZE_16BIT : SPI_DATASIZE_8BIT;
+	hspi->hdmatx->Init.MemInc              = Repeat ? DMA_MINC_DISABLE : DMA_MINC_ENABLE;
+	hspi->hdmatx->Init.PeriphDataAlignment = Repeat ? DMA_PDATAALIGN_HALFWORD : DMA_PDATAALIGN_BYTE;
+	hspi->hdmatx->Init.MemDataAlignment    = Repeat ? DMA_MDATAALIGN_HALFWORD : DMA_MDATAALIGN_BYTE;
+	
+	HAL_SPI_Init(hspi);
+	HAL_DMA_Init(hspi->hdmatx);
+	
+}
+
+static void ST7789_SPIBus_WriteRepeat(ST7789_HandleTypeDef *hlcd, const uint16_t *Pixel, uint32_t Count)
+{
+	
+	/* The pixels are equal, so the odd part is sent first and the last full chunk runs in the background */
+	uint16_t tCount = ((Count - 1) % UINT16_MAX) + 1;
+	
+	/* ---------------- Select Chip ----------------- */
+	ST7789_GPIO_WritePin(ST7789_GPIO_PORT(hlcd->CSPort), hlcd->CSPin, ST7789_GPIO_PIN_RESET);
+	
+	/* -------------- Set to Data Mode -------------- */
+	ST7789_GPIO_WritePin(ST7789_GPIO_PORT(hlcd->DCPort), hlcd->DCPin, ST7789_GPIO_PIN_SET);
+	
+	/* An SPI frame is one pixel (MSB first), ST7789_SPIBus_End restores the byte mode */
+	ST7789_SPIBus_SetRepeatMode(hlcd->SPI, 1);
+	
+	/* ---------------- Transmit Pixels ------------- */
+	while (1)
+	{
+		
+		Count -= tCount;
+		
+		/* Only the TX complete interrupt of the last chunk releases the LCD */
+		hlcd->TxBusy = (Count == 0);
+		
+		ST7789_SPI_Transmit_DMA(hlcd->SPI, (uint8_t *)Pixel, tCount);
+		
+		if (Count == 0)
+		{
+			break;
+		}
+		
+		while (ST7789_SPI_IsBusy(hlcd->SPI)) { ST7789_OS_YIELD(); }
+		
+		tCount = UINT16_MAX;
+		
+	}
+	
+}
+
+#endif
+
+static uint8_t ST7789_SPIBus_IsBusy(ST7789_HandleTypeDef *hlcd)
+{
+	
+	#ifdef ST7789_USE_DMA
+	
+	return ST7789_SPI_IsBusy(hlcd->SPI);
+	
+	#else
+	
+	(void)hlcd;
+	
+	return 0;
+	
+	#endif
+	
+}
+
+static void ST7789_SPIBus_Read(ST7789_HandleTypeDef *hlcd, uint8_t Command, uint8_t *Data, uint16_t Size)
+{
+	
+	ST7789_SPIBus_WriteCommand(hlcd, Command);
+	
+	/* -------------- Set to Data Mode -------------- */
+	ST7789_GPIO_WritePin(ST7789_GPIO_PORT(hlcd->DCPort), hlcd->DCPin, ST7789_GPIO_PIN_SET);
+	ST7789_SPI_SetReadClock(hlcd->SPI);
+	
+	/* The first byte after a read command is a dummy read */
+	ST7789_SPI_Receive(hlcd->SPI, Data, 1, ST7789_SPI_TIMEOUT);
+	ST7789_SPI_Receive(hlcd->SPI, Data, Size, ST7789_SPI_TIMEOUT);
+	
+	ST7789_SPI_SetWriteClock(hlcd->SPI);
+	
+	/* ---------------- Unselect Chip --------------- */
+	ST7789_GPIO_WritePin(ST7789_GPIO_PORT(hlcd->CSPort), hlcd->CSPin, ST7789_GPIO_PIN_SET);
+	
+}
+
+static void ST7789_SPIBus_End(ST7789_HandleTypeDef *hlcd)
+{
+	
+	(void)hlcd;
+	
+	#if defined(ST7789_USE_DMA) && defined(USE_HAL_DRIVER)
+	
+	/* ------------- End of Repeat Transfer --------- */
+	if (hlcd->SPI->Init.DataSize != SPI_DATASIZE_8BIT)
+	{
+		ST7789_SPIBus_SetRepeatMode(hlcd->SPI, 0);
+	}
+	
+	#endif
+	
+	/* ---------------- Unselect Chip --------------- */
+	ST7789_GPIO_WritePin(ST7789_GPIO_PORT(hlcd->CSPort), hlcd->CSPin, ST7789_GPIO_PIN_SET);
+	
+}
+
+const ST7789_BusOpsTypeDef ST7789_Bus_SPI =
+{
+	ST7789_SPIBus_WriteCommand,
+	ST7789_SPIBus_WriteData,
+	ST7789_SPIBus_WriteBulk,
+	
+	#ifdef ST7789_USE_DMA
+	ST7789_SPIBus_WriteBulkAsync,
+	#else
+	NULL,
+	#endif
+	
+	#if defined(ST7789_USE_DMA) && defined(USE_HAL_DRIVER)
+	ST7789_SPIBus_WriteRepeat,
+	#else
+	NULL,
+	#endif
+	
+	ST7789_SPIBus_IsBusy,
+	ST7789_SPIBus_Read,
+	ST7789_SPIBus_End
+};
+
+/* ....................... SPI Registers ....................... */
+#ifdef ST7789_SPI_LL_TypeDef
+
+/*
+	Short transfers skip the HAL: the bytes are written to DR when TXE is set, and BSY is polled
+	before D/CX or CS changes. Bulk data longer than ST7789_SPI_LL_MAX_SIZE uses the SPI backend (DMA).
+*/
+static void ST7789_SPILLBus_Write(ST7789_HandleTypeDef *hlcd, const uint8_t *Data, uint32_t Size)
+{
+	
+	ST7789_SPI_LL_TypeDef *reg = ST7789_SPI_LL_Instance(hlcd->SPI);
+	
+	(void)hlcd;
+	
+	/* HAL enables the SPI on its first transfer */
+	ST7789_SPI_LL_Enable(reg);
+	
+	/* ---------------- Transmit Data --------------- */
+	while (Size--)
+	{
+		
+		while (!ST7789_SPI_LL_IsTxEmpty(reg)) { }
+		ST7789_SPI_LL_WriteByte(reg, *Data++);
+		
+	}
+	
+	/* ----------- Wait for the last bit ------------ */
+	while (!ST7789_SPI_LL_IsTxEmpty(reg)) { }
+	while (ST7789_SPI_LL_IsBusy(reg)) { }
+	
+	/* The received bytes are not used, reading DR then SR clears the overrun */
+	while (ST7789_SPI_LL_IsRxNotEmpty(reg))
+	{
+		(void)ST7789_SPI_LL_ReadByte(reg);
+	}
+	
+}
+
+static void ST7789_SPILLBus_WriteCommand(ST7789_HandleTypeDef *hlcd, uint8_t Command)
+{
+	
+	/* ---------------- Select Chip ----------------- */
+	ST7789_GPIO_WritePin(ST7789_GPIO_PORT(hlcd->CSPort), hlcd->CSPin, ST7789_GPIO_PIN_RESET);
+	
+	/* ------------- Set to Command Mode ------------ */
+	ST7789_GPIO_WritePin(ST7789_GPIO_PORT(hlcd->DCPort), hlcd->DCPin, ST7789_GPIO_PIN_RESET);
+	
+	ST7789_SPILLBus_Write(hlcd, &Command, 1);
+	
+}
+
+static void ST7789_SPILLBus_WriteData(ST7789_HandleTypeDef *hlcd, const uint8_t *Data, uint16_t Size)
+{
+	
+	/* ---------------- Select Chip ----------------- */
+	ST7789_GPIO_WritePin(ST7789_GPIO_PORT(hlcd->CSPort), hlcd->CSPin, ST7789_GPIO_PIN_RESET);
+	
+	/* -------------- Set to Data Mode -------------- */
+	ST7789_GPIO_WritePin(ST7789_GPIO_PORT(hlcd->DCPort), hlcd->DCPin, ST7789_GPIO_PIN_SET);
+	
+	ST7789_SPILLBus_Write(hlcd, Data, Size);
+	
+}
+
+static void ST7789_SPILLBus_WriteBulk(ST7789_HandleTypeDef *hlcd, const uint8_t *Data, uint32_t Size)
+{
+	
+	if (Size > ST7789_SPI_LL_MAX_SIZE)
+	{
+		ST7789_SPIBus_WriteBulk(hlcd, Data, Size);
+	}
+	else
+	{
+		ST7789_SPILLBus_WriteData(hlcd, Data, (uint16_t)Size);
+	}
+	
+}
+
+#ifdef ST7789_USE_DMA
+
+static void ST7789_SPILLBus_WriteBulkAsync(ST7789_HandleTypeDef *hlcd, const uint8_t *Data, uint32_t Size)
+{
+	
+	/* A short transfer is finished before DMA could be started */
+	if (Size > ST7789_SPI_LL_MAX_SIZE)
+	{
+		ST7789_SPIBus_WriteBulkAsync(hlcd, Data, Size);
+	}
+	else
+	{
+		ST7789_SPILLBus_WriteData(hlcd, Data, (uint16_t)Size);
+	}
+	
+}
+
+#endif
+
+const ST7789_BusOpsTypeDef ST7789_Bus_SPI_LL =
+{
+	ST7789_SPILLBus_WriteCommand,
+	ST7789_SPILLBus_WriteData,
+	ST7789_SPILLBus_WriteBulk,
+	
+	#ifdef ST7789_USE_DMA
+	ST7789_SPILLBus_WriteBulkAsync,
+	#else
+	NULL,
+	#endif
+	
+	#if defined(ST7789_USE_DMA) && defined(USE_HAL_DRIVER)
+	ST7789_SPIBus_WriteRepeat,
+	#else
+	NULL,
+	#endif
+	
+	ST7789_SPIBus_IsBusy,
+	ST7789_SPIBus_Read, /* Reads are rare, HAL handles the dummy byte and the read clock */
+	ST7789_SPIBus_End
+};
+
+#endif /* ST7789_SPI_LL_TypeDef */
+
+/* ............................ FMC ............................ */
+/*
+	8080 parallel interface: Every store to the data register is one WRX strobe.
+	Parameters and 8-bit pixels use D[7:0], a 16-bit bus writes one RGB565 pixel per strobe.
+*/
+static void ST7789_FMCBus_WriteCommand(ST7789_HandleTypeDef *hlcd, uint8_t Command)
+{
+	
+	ST7789_FMCBusTypeDef *fmc = (ST7789_FMCBusTypeDef *)hlcd->BusContext;
+	
+	if (fmc->Width == 8)
+	{
+		*(volatile uint8_t *)fmc->Command = Command;
+	}
+	else
+	{
+		*fmc->Command = Command;
+	}
+	
+}
+
+static void ST7789_FMCBus_WriteData(ST7789_HandleTypeDef *hlcd, const uint8_t *Data, uint16_t Size)
+{
+	
+	ST7789_FMCBusTypeDef *fmc = (ST7789_FMCBusTypeDef *)hlcd->BusContext;
+	
+	if (fmc->Width == 8)
+	{
+	
+		while (Size--)
+		{
+			*(volatile uint8_t *)fmc->Data = *Data++;
+		}
+	
+	}
+	else
+	{
+	
+		while (Size--)
+		{
+			*fmc->Data = *Data++;
+		}
+	
+	}
+	
+}
+
+static void ST7789_FMCBus_WriteBulk(ST7789_HandleTypeDef *hlcd, const uint8_t *Data, uint32_t Size)
+{
+	
+	ST7789_FMCBusTypeDef *fmc = (ST7789_FMCBusTypeDef *)hlcd->BusContext;
+	
+	if (fmc->Width == 8)
+	{
+	
+		while (Size--)
+		{
+			*(volatile uint8_t *)fmc->Data = *Data++;
+		}
+	
+	}
+	else
+	{
+	
+		/* ---------- Big-endian bytes to one pixel ----- */
+		for (; Size >= 2; Size -= 2, Data += 2)
+		{
+			*fmc->Data = ((uint16_t)Data[0] << 8) | Data[1];
+		}
+	
+	}
+	
+}
+
+static void ST7789_FMCBus_WriteRepeat(ST7789_HandleTypeDef *hlcd, const uint16_t *Pixel, uint32_t Count)
+{
+	
+	ST7789_FMCBusTypeDef *fmc = (ST7789_FMCBusTypeDef *)hlcd->BusContext;
+	uint16_t pixel            = *Pixel;
+	
+	if (fmc->Width == 8)
+	{
+		
+		while (Count--)
+		{
+			*(volatile uint8_t *)fmc->Data = pixel >> 8;
+			*(volatile uint8_t *)fmc->Data = pixel & 0xFF;
+		}
+		
+	}
+	else
+	{
+		
+		while (Count--)
+		{
+			*fmc->Data = pixel;
+		}
+		
+	}
+	
+}
+
+static uint8_t ST7789_FMCBus_IsBusy(ST7789_HandleTypeDef *hlcd)
+{
+	
+	(void)hlcd;
+	
+	return 0;
+	
+}
+
+static void ST7789_FMCBus_Read(ST7789_HandleTypeDef *hlcd, uint8_t Command, uint8_t *Data, uint16_t Size)
+{
+	
+	ST7789_FMCBusTypeDef *fmc = (ST7789_FMCBusTypeDef *)hlcd->BusContext;
+	
+	uint16_t word;
+	
+	ST7789_FMCBus_WriteCommand(hlcd, Command);
+	
+	/* ------------- One Byte per RDX Strobe -------- */
+	if (fmc->Width == 8)
+	{
+		
+		/* The first read after a read command is a dummy read */
+		(void)*(volatile uint8_t *)fmc->Data;
+		
+		while (Size--)
+		{
+			*Data++ = *(volatile uint8_t *)fmc->Data;
+		}
+		
+	}
+	else
+	{
+		
+		(void)*fmc->Data;
+		
+		/* ------------ Two Bytes per RDX Strobe -------- */
+		while (Size > 0)
+		{
+			
+			word    = *fmc->Data;
+			*Data++ = (uint8_t)(word >> 8);
+			Size--;
+			
+			/* The low byte of the last word is dropped for an odd size */
+			if (Size > 0)
+			{
+				*Data++ = (uint8_t)word;
+				Size--;
+			}
+			
+		}
+		
+	}
+	
+}
+
+static void ST7789_FMCBus_End(ST7789_HandleTypeDef *hlcd)
+{
+	
+	/* The FMC drives CSX */
+	(void)hlcd;
+	
+}
+
+const ST7789_BusOpsTypeDef ST7789_Bus_FMC =
+{
+	ST7789_FMCBus_WriteCommand,
+	ST7789_FMCBus_WriteData,
+	ST7789_FMCBus_WriteBulk,
+	NULL, /* The CPU stores are as fast as the bus */
+	ST7789_FMCBus_WriteRepeat,
+	ST7789_FMCBus_IsBusy,
+	ST7789_FMCBus_Read,
+	ST7789_FMCBus_End
+};
+
+/* ............................ RAM ............................ */
+static void ST7789_RAMBus_Advance(ST7789_RAMBusTypeDef *ram, uint16_t Count)
+{
+	
+	/* ------------- Next Address of Window --------- */
+	ram->X += Count;
+	
+	if (ram->X > ram->XEnd)
+	{
+	
+		ram->X = ram->XStart;
+	
+		if (++ram->Y > ram->YEnd)
+		{
+			ram->Y = ram->YStart;
+		}
+	
+	}
+	
+}
+
+static void ST7789_RAMBus_SetDirty(ST7789_RAMBusTypeDef *ram)
+{
+	
+	/* ------------ Add the Window to the Area ------ */
+	if (!ram->DirtyValid)
+	{
+		
+		ram->Dirty.XStart = ram->XStart;
+		ram->Dirty.YStart = ram->YStart;
+		ram->Dirty.XEnd   = ram->XEnd;
+		ram->Dirty.YEnd   = ram->YEnd;
+		ram->DirtyValid   = 1;
+		
+		return;
+		
+	}
+	
+	ram->Dirty.XStart = (ram->XStart < ram->Dirty.XStart) ? ram->XStart : ram->Dirty.XStart;
+	ram->Dirty.YStart = (ram->YStart < ram->Dirty.YStart) ? ram->YStart : ram->Dirty.YStart;
+	ram->Dirty.XEnd   = (ram->XEnd > ram->Dirty.XEnd) ? ram->XEnd : ram->Dirty.XEnd;
+	ram->Dirty.YEnd   = (ram->YEnd > ram->Dirty.YEnd) ? ram->YEnd : ram->Dirty.YEnd;
+	
+}
+
+static void ST7789_RAMBus_WriteCommand(ST7789_HandleTypeDef *hlcd, uint8_t Command)
+{
+	
+	ST7789_RAMBusTypeDef *ram = (ST7789_RAMBusTypeDef *)hlcd->BusContext;
+	
+	ram->Command    = Command;
+	ram->ParamCount = 0;
+	ram->PixelByte  = 0;
+	
+	/* ------------- Memory Write/Read Start -------- */
+	if ((Command == ST7789_CMD_RAMWR) || (Command == ST7789_CMD_RAMRD))
+	{
+		ram->X = ram->XStart;
+		ram->Y = ram->YStart;
+	}
+	
+}
+
+static void ST7789_RAMBus_WriteParam(ST7789_HandleTypeDef *hlcd, ST7789_RAMBusTypeDef *ram, uint8_t Param)
+{
+	
+	uint16_t start;
+	uint16_t end;
+	
+	if (ram->ParamCount >= sizeof(ram->Params))
+	{
+		return;
+	}
+	
+	ram->Params[ram->ParamCount++] = Param;
+	
+	if (ram->ParamCount < 4)
+	{
+		return;
+	}
+	
+	start = ((uint16_t)ram->Params[0] << 8) | ram->Params[1];
+	end   = ((uint16_t)ram->Params[2] << 8) | ram->Params[3];
+	
+	/* ------ Window in the Coordinates of the Frame ------ */
+	if (ram->Command == ST7789_CMD_CASET)
+	{
+		
+		start = start - hlcd->XOffset;
+		end   = end - hlcd->XOffset;
+		
+		ram->XStart = (start < ram->Width) ? start : (ram->Width - 1);
+		ram->XEnd   = (end < ram->Width) ? end : (ram->Width - 1);
+		
+	}
+	else if (ram->Command == ST7789_CMD_RASET)
+	{
+		
+		start = start - hlcd->YOffset;
+		end   = end - hlcd->YOffset;
+		
+		ram->YStart = (start < ram->Height) ? start : (ram->Height - 1);
+		ram->YEnd   = (end < ram->Height) ? end : (ram->Height - 1);
+		
+	}
+	
+}
+
+static void ST7789_RAMBus_WriteBulk(ST7789_HandleTypeDef *hlcd, const uint8_t *Data, uint32_t Size)
+{
+	
+	ST7789_RAMBusTypeDef *ram = (ST7789_RAMBusTypeDef *)hlcd->BusContext;
+	uint8_t              *pixel;
+	uint32_t              count;
+	
+	/* ~~~~~~~~~~~~~~~~~~~~~ Parameter ~~~~~~~~~~~~~~~~~~~~~ */
+	if ((ram->Command != ST7789_CMD_RAMWR) && (ram->Command != ST7789_CMD_WRMEMC))
+	{
+		
+		while (Size--)
+		{
+			ST7789_RAMBus_WriteParam(hlcd, ram, *Data++);
+		}
+		
+		return;
+		
+	}
+	
+	/* ~~~~~~~~~~~~~~~~~~~~~~~ Pixel ~~~~~~~~~~~~~~~~~~~~~~~ */
+	if (Size > 0)
+	{
+		ST7789_RAMBus_SetDirty(ram);
+	}
+	
+	/* Second byte of a pixel that was split by the last call */
+	if ((ram->PixelByte == 1) && (Size > 0))
+	{
+		
+		pixel    = (uint8_t *)&ram->Pixels[(uint32_t)ram->Y * ram->Width + ram->X];
+		pixel[0] = ram->PixelHigh;
+		pixel[1] = *Data++;
+		
+		ram->PixelByte = 0;
+		Size--;
+		
+		ST7789_RAMBus_Advance(ram, 1);
+		
+	}
+	
+	/* ------------- Copy Rows of the Window -------- */
+	while (Size >= 2)
+	{
+		
+		count = ram->XEnd - ram->X + 1U;
+		count = (count < (Size / 2U)) ? count : (Size / 2U);
+		
+		memcpy(&ram->Pixels[(uint32_t)ram->Y * ram->Width + ram->X], Data, count * 2U);
+		
+		Data += count * 2U;
+		Size -= count * 2U;
+		
+		ST7789_RAMBus_Advance(ram, (uint16_t)count);
+		
+	}
+	
+	if (Size > 0)
+	{
+		ram->PixelHigh = *Data;
+		ram->PixelByte = 1;
+	}
+	
+}
+
+static void ST7789_RAMBus_WriteData(ST7789_HandleTypeDef *hlcd, const uint8_t *Data, uint16_t Size)
+{
+	ST7789_RAMBus_WriteBulk(hlcd, Data, Size);
+}
+
+static void ST7789_RAMBus_WriteRepeat(ST7789_HandleTypeDef *hlcd, const uint16_t *Pixel, uint32_t Count)
+{
+	
+	ST7789_RAMBusTypeDef *ram   = (ST7789_RAMBusTypeDef *)hlcd->BusContext;
+	uint16_t              value = (*Pixel >> 8) | (*Pixel << 8); // Big-endian in the frame
+	uint16_t             *dest;
+	uint32_t              count;
+	
+	if (Count > 0)
+	{
+		ST7789_RAMBus_SetDirty(ram);
+	}
+	
+	/* ------------- Fill Rows of the Window -------- */
+	while (Count > 0)
+	{
+		
+		count = ram->XEnd - ram->X + 1U;
+		count = (count < Count) ? count : Count;
+		
+		dest   = &ram->Pixels[(uint32_t)ram->Y * ram->Width + ram->X];
+		Count -= count;
+		
+		ST7789_RAMBus_Advance(ram, (uint16_t)count);
+		
+		while (count--)
+		{
+			*dest++ = value;
+		}
+		
+	}
+	
+}
+
+static uint8_t ST7789_RAMBus_IsBusy(ST7789_HandleTypeDef *hlcd)
+{
+	
+	(void)hlcd;
+	
+	return 0;
+	
+}
+
+static void ST7789_RAMBus_Read(ST7789_HandleTypeDef *hlcd, uint8_t Command, uint8_t *Data, uint16_t Size)
+{
+	
+	ST7789_RAMBusTypeDef *ram = (ST7789_RAMBusTypeDef *)hlcd->BusContext;
+	const uint8_t        *src;
+	uint16_t              pixel;
+	
+	ST7789_RAMBus_WriteCommand(hlcd, Command);
+	
+	if ((Command != ST7789_CMD_RAMRD) && (Command != ST7789_CMD_RDMEMC))
+	{
+		
+		memset(Data, 0, Size);
+		return;
+		
+	}
+	
+	/* ------------ 18bit Pixels like the LCD ------- */
+	while (Size--)
+	{
+	
+		src   = (const uint8_t *)&ram->Pixels[(uint32_t)ram->Y * ram->Width + ram->X];
+		pixel = ((uint16_t)src[0] << 8) | src[1];
+	
+		switch (ram->PixelByte)
+		{
+			case 0: *Data++ = (pixel >> 8) & 0xF8; break;
+			case 1: *Data++ = (pixel >> 3) & 0xFC; break;
+			default: *Data++ = (pixel << 3) & 0xF8; break;
+		}
+	
+		if (++ram->PixelByte == 3)
+		{
+	
+			ram->PixelByte = 0;
+	
+			ST7789_RAMBus_Advance(ram, 1);
+	
+		}
+	
+	}
+	
+}
+
+static void ST7789_RAMBus_End(ST7789_HandleTypeDef *hlcd)
+{
+	(void)hlcd;
+}
+
+const ST7789_BusOpsTypeDef ST7789_Bus_RAM =
+{
+	ST7789_RAMBus_WriteCommand,
+	ST7789_RAMBus_WriteData,
+	ST7789_RAMBus_WriteBulk,
+	NULL,
+	ST7789_RAMBus_WriteRepeat,
+	ST7789_RAMBus_IsBusy,
+	ST7789_RAMBus_Read,
+	ST7789_RAMBus_End
+};
+
+/* ........................... Host ............................ */
+#ifdef ST7789_HOST
+
+ST7789_HostBusTypeDef ST7789_Host_Bus;
+
+static void ST7789_HostBus_Advance(ST7789_HostBusTypeDef *mock)
+{
+	
+	/* ------------- Next Address of Window --------- */
+	if (++mock->X > mock->XEnd)
+	{
+	
+		mock->X = mock->XStart;
+	
+		if (++mock->Y > mock->YEnd)
+		{
+			mock->Y = mock->YStart;
+		}
+	
+	}
+	
+}
+
+static void ST7789_HostBus_Transfer(const uint8_t *Data, uint32_t Size)
+{
+	
+	uint16_t tSize;
+	
+	/* Simulated bus time and byte counter */
+	while (Size > 0)
+	{
+	
+		tSize = Size > UINT16_MAX ? UINT16_MAX : Size;
+	
+		ST7789_Host_SPI_Transmit((uint8_t *)Data, tSize);
+	
+		Data += tSize;
+		Size -= tSize;
+	
+	}
+	
+}
+
+static void ST7789_HostBus_WriteCommand(ST7789_HandleTypeDef *hlcd, uint8_t Command)
+{
+	
+	ST7789_HostBusTypeDef *mock = (ST7789_HostBusTypeDef *)hlcd->BusContext;
+	
+	ST7789_HostBus_Transfer(&Command, 1);
+	
+	mock->Command    = Command;
+	mock->ParamCount = 0;
+	mock->PixelByte  = 0;
+	mock->Commands++;
+	
+	/* ------------- Memory Write/Read Start -------- */
+	if ((Command == ST7789_CMD_RAMWR) || (Command == ST7789_CMD_RAMRD))
+	{
+		mock->X = mock->XStart;
+		mock->Y = mock->YStart;
+	}
+	
+}
+
+static void ST7789_HostBus_WriteBulk(ST7789_HandleTypeDef *hlcd, const uint8_t *Data, uint32_t Size)
+{
+	
+	ST7789_HostBusTypeDef *mock = (ST7789_HostBusTypeDef *)hlcd->BusContext;
+	
+	ST7789_HostBus_Transfer(Data, Size);
+	
+	mock->DataBytes += Size;
+	
+	while (Size--)
+	{
+	
+		/* ~~~~~~~~~~~~~~~~~~~~~~~ Pixel ~~~~~~~~~~~~~~~~~~~~~~~ */
+		if ((mock->Command == ST7789_CMD_RAMWR) || (mock->Command == ST7789_CMD_WRMEMC))
+		{
+	
+			if (mock->PixelByte == 0)
+			{
+	
+				mock->PixelHigh = *Data;
+				mock->PixelByte = 1;
+	
+			}
+			else
+			{
+	
+				mock->GRAM[mock->Y][mock->X] = ((uint16_t)mock->PixelHigh << 8) | *Data;
+				mock->PixelByte = 0;
+	
+				ST7789_HostBus_Advance(mock);
+	
+			}
+	
+		}
+	
+		/* ~~~~~~~~~~~~~~~~~~~~~ Parameter ~~~~~~~~~~~~~~~~~~~~~ */
+		else if (mock->ParamCount < sizeof(mock->Params))
+		{
+	
+			mock->Params[mock->ParamCount++] = *Data;
+	
+			if (mock->ParamCount == 4)
+			{
+	
+				if (mock->Command == ST7789_CMD_CASET)
+				{
+					mock->XStart = ((uint16_t)mock->Params[0] << 8) | mock->Params[1];
+					mock->XEnd   = ((uint16_t)mock->Params[2] << 8) | mock->Params[3];
+				}
+				else if (mock->Command == ST7789_CMD_RASET)
+				{
+					mock->YStart = ((uint16_t)mock->Params[0] << 8) | mock->Params[1];
+					mock->YEnd   = ((uint16_t)mock->Params[2] << 8) | mock->Params[3];
+				}
+	
+				/* Keep the window inside the frame memory */
+				mock->XEnd = (mock->XEnd < ST7789_HEIGHT_MAX) ? mock->XEnd : (ST7789_HEIGHT_MAX - 1);
+				mock->YEnd = (mock->YEnd < ST7789_HEIGHT_MAX) ? mock->YEnd : (ST7789_HEIGHT_MAX - 1);
+	
+			}
+	
+		}
+	
+		Data++;
+	
+	}
+	
+}
+
+static void ST7789_HostBus_WriteData(ST7789_HandleTypeDef *hlcd, const uint8_t *Data, uint16_t Size)
+{
+	ST7789_HostBus_WriteBulk(hlcd, Data, Size);
+}
+
+static void ST7789_HostBus_WriteRepeat(ST7789_HandleTypeDef *hlcd, const uint16_t *Pixel, uint32_t Count)
+{
+	
+	ST7789_HostBusTypeDef *mock = (ST7789_HostBusTypeDef *)hlcd->BusContext;
+	uint32_t bytes              = Count * 2U;
+	uint16_t tSize;
+	
+	/* Simulated bus time of the pixels */
+	while (bytes > 0)
+	{
+		
+		tSize = bytes > UINT16_MAX ? UINT16_MAX : bytes;
+		
+		ST7789_Host_SPI_Transmit((uint8_t *)Pixel, tSize);
+		
+		bytes -= tSize;
+		
+	}
+	
+	mock->DataBytes += Count * 2U;
+	mock->Repeats++;
+	
+	/* ------------------ Write GRAM ---------------- */
+	while (Count--)
+	{
+		
+		mock->GRAM[mock->Y][mock->X] = *Pixel;
+		
+		ST7789_HostBus_Advance(mock);
+		
+	}
+	
+}
+
+static uint8_t ST7789_HostBus_IsBusy(ST7789_HandleTypeDef *hlcd)
+{
+	
+	(void)hlcd;
+	
+	return 0;
+	
+}
+
+static void ST7789_HostBus_Read(ST7789_HandleTypeDef *hlcd, uint8_t Command, uint8_t *Data, uint16_t Size)
+{
+	
+	ST7789_HostBusTypeDef *mock = (ST7789_HostBusTypeDef *)hlcd->BusContext;
+	uint16_t pixel;
+	
+	ST7789_HostBus_WriteCommand(hlcd, Command);
+	
+	/* Dummy byte and data */
+	ST7789_Host_SPI_Receive(Data, 1);
+	ST7789_Host_SPI_Receive(Data, Size);
+	
+	mock->ReadBytes += Size;
+	
+	if ((Command != ST7789_CMD_RAMRD) && (Command != ST7789_CMD_RDMEMC))
+	{
+		return;
+	}
+	
+	/* ------------ 18bit Pixels from GRAM ---------- */
+	while (Size--)
+	{
+	
+		pixel = mock->GRAM[mock->Y][mock->X];
+	
+		switch (mock->PixelByte)
+		{
+			case 0: *Data++ = (pixel >> 8) & 0xF8; break;
+			case 1: *Data++ = (pixel >> 3) & 0xFC; break;
+			default: *Data++ = (pixel << 3) & 0xF8; break;
+		}
+	
+		if (++mock->PixelByte == 3)
+		{
+	
+			mock->PixelByte = 0;
+	
+			ST7789_HostBus_Advance(mock);
+	
+		}
+	
+	}
+	
+}
+
+static void ST7789_HostBus_End(ST7789_HandleTypeDef *hlcd)
+{
+	(void)hlcd;
+}
+
+const ST7789_BusOpsTypeDef ST7789_Bus_Host =
+{
+	ST7789_HostBus_WriteCommand,
+	ST7789_HostBus_WriteData,
+	ST7789_HostBus_WriteBulk,
+	NULL,
+	ST7789_HostBus_WriteRepeat,
+	ST7789_HostBus_IsBusy,
+	ST7789_HostBus_Read,
+	ST7789_HostBus_End
+};
+
+#endif /* ST7789_HOST */
+
+/* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ End of the program ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
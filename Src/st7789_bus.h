@@ -0,0 +1,124 @@
+/*
+------------------------------------------------------------------------------
+~ File   : st7789_bus.h
+~ Author : Majid Derhambakhsh
+~ Version: V1.0.0
+~ Created: 08/25/2023 18:00:00 PM
+~ Brief  : Bus backends of the ST7789 driver (SPI, 8080 parallel on FMC, host mock)
+~ Support:
+           E-Mail : Majid.Derhambakhsh@gmail.com (subject : Embedded Library Support)
+
+           Github : https://github.com/Majid-Derhambakhsh
+------------------------------------------------------------------------------
+~ Description:    The driver writes to the LCD through the Bus operations of the display
+                  handle, select a backend with the Bus and BusContext fields:
+
+                  - ST7789_Bus_SPI    : 4-line SPI with the ST7789_SPI_xxx macros (BusContext: Unused)
+                  - ST7789_Bus_SPI_LL : 4-line SPI, commands and short data are written to the SPI registers (BusContext: Unused)
+                  - ST7789_Bus_FMC    : 8080 8/16-bit parallel on the FMC/FSMC (BusContext: ST7789_FMCBusTypeDef)
+                  - ST7789_Bus_Host   : Host mock with an emulated frame memory (BusContext: ST7789_HostBusTypeDef)
+                  - ST7789_Bus_RAM    : Frame buffer in the MCU memory, e.g. the back buffer of st7789_swap.h (BusContext: ST7789_RAMBusTypeDef)
+
+~ Attention  :    FMC: Connect D/CX to an address line, the command and data registers are
+                  the bank address with this line low and high. Configure the FMC region as
+                  device memory (MPU) so the stores are not cached or merged.
+
+~ Changes    :
+------------------------------------------------------------------------------
+*/
+
+#ifndef __ST7789_BUS_H_
+#define __ST7789_BUS_H_
+
+/* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ Include ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+#include "st7789.h"
+
+/* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ Defines ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+#ifndef ST7789_SPI_LL_MAX_SIZE
+	#define ST7789_SPI_LL_MAX_SIZE  32 // Longer bulk data is sent by ST7789_Bus_SPI (DMA)
+#endif
+
+/* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ Types ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+typedef struct /* FMC Bus */
+{
+	
+	volatile uint16_t *Command; // Address of the command register (D/CX low)
+	volatile uint16_t *Data;    // Address of the data register (D/CX high)
+	uint8_t            Width;   // Data bus width (8 or 16)
+	
+}ST7789_FMCBusTypeDef;
+
+typedef struct /* RAM Bus */
+{
+	
+	uint16_t           *Pixels;    // Width x Height pixels in the ST7789_PutImage format (Big-endian RGB565)
+	uint16_t           Width;      // Width and height of the display in its current rotation
+	uint16_t           Height;
+	
+	uint8_t            Command;    // Last command
+	uint8_t            Params[4];  // Parameters of the last command
+	uint8_t            ParamCount;
+	
+	uint16_t           XStart;     // Window (CASET/RASET without the frame memory offset)
+	uint16_t           XEnd;
+	uint16_t           YStart;
+	uint16_t           YEnd;
+	uint16_t           X;          // Memory pointer
+	uint16_t           Y;
+	uint8_t            PixelHigh;  // First byte of the pixel
+	uint8_t            PixelByte;  // Byte counter of the pixel (Write: 0..1, Read: 0..2)
+	
+	uint8_t            DirtyValid; // Pixels are written since the dirty area was cleared
+	ST7789_AreaTypeDef Dirty;      // Bounding box of the written windows
+	
+}ST7789_RAMBusTypeDef;
+
+#ifdef ST7789_HOST
+
+typedef struct /* Host Mock Bus */
+{
+	
+	uint16_t GRAM[ST7789_HEIGHT_MAX][ST7789_HEIGHT_MAX]; // Frame memory [Row][Column] of the window addresses
+	
+	uint8_t  Command;    // Last command
+	uint8_t  Params[8];  // Parameters of the last command
+	uint8_t  ParamCount;
+	
+	uint16_t XStart;     // Window (CASET/RASET)
+	uint16_t XEnd;
+	uint16_t YStart;
+	uint16_t YEnd;
+	uint16_t X;          // Memory pointer
+	uint16_t Y;
+	uint8_t  PixelHigh;  // First byte of the pixel
+	uint8_t  PixelByte;  // Byte counter of the pixel (Write: 0..1, Read: 0..2)
+	
+	uint32_t Commands;   // Written commands
+	uint32_t DataBytes;  // Written parameter and pixel bytes
+	uint32_t ReadBytes;  // Read bytes
+	uint32_t Repeats;    // Repeat transfers (WriteRepeat)
+	
+}ST7789_HostBusTypeDef;
+
+#endif
+
+/* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ Variables ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+extern const ST7789_BusOpsTypeDef ST7789_Bus_SPI;
+extern const ST7789_BusOpsTypeDef ST7789_Bus_FMC;
+extern const ST7789_BusOpsTypeDef ST7789_Bus_RAM;
+
+#ifdef ST7789_SPI_LL_TypeDef /* HAL (Except STM32H7) and host */
+
+extern const ST7789_BusOpsTypeDef ST7789_Bus_SPI_LL;
+
+#endif
+
+#ifdef ST7789_HOST
+
+extern const ST7789_BusOpsTypeDef ST7789_Bus_Host;
+extern ST7789_HostBusTypeDef      ST7789_Host_Bus; // Context of the default display on the host
+
+#endif
+
+/* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ End of the program ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+#endif /* __ST7789_BUS_H_ */
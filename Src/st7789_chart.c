@@ -0,0 +1,796 @@
+/*
+------------------------------------------------------------------------------
+~ File   : st7789_chart.c
+~ Author : Majid Derhambakhsh
+~ Version: V1.0.0
+~ Created: 08/25/2023 18:00:00 PM
+~ Brief  : Chart widgets with delta-only updates (trace, strip chart, bar graph, histogram)
+~ Support:
+           E-Mail : Majid.Derhambakhsh@gmail.com (subject : Embedded Library Support)
+
+           Github : https://github.com/Majid-Derhambakhsh
+------------------------------------------------------------------------------
+~ Description:
+
+~ Attention  :
+
+~ Changes    :
+------------------------------------------------------------------------------
+*/
+
+/* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ Include ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+#include "st7789_chart.h"
+
+/* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ Defines ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+#define CHART_EMPTY_TOP     1 // Top > Bottom: Nothing is drawn in the column
+#define CHART_EMPTY_BOTTOM  0
+
+/* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ G Struct ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+typedef struct /* Plot Area of a Column Widget (Trace, Strip) */
+{
+	
+	ST7789_HandleTypeDef     *hlcd;
+	ST7789_ChartStatsTypeDef *Stats;
+	
+	uint16_t                  YPos;
+	ST7789_ColorTypeDef       Color;
+	ST7789_ColorTypeDef       BackgroundColor;
+	ST7789_ColorTypeDef       GridColor;
+	uint16_t                  GridX;
+	uint16_t                  GridY;
+	
+}ST7789_ChartPlotTypeDef;
+
+/* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ Function ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+static uint32_t ST7789_Chart_Fill(ST7789_HandleTypeDef *hlcd, ST7789_ChartStatsTypeDef *Stats, uint16_t XStart, uint16_t YStart, uint16_t XEnd, uint16_t YEnd, ST7789_ColorTypeDef Color)
+{
+	
+	uint32_t pixels = (uint32_t)(XEnd - XStart + 1) * (YEnd - YStart + 1);
+	
+	ST7789_Disp_Fill(hlcd, XStart, YStart, XEnd, YEnd, Color);
+	
+	Stats->Spans++;
+	Stats->Pixels += pixels;
+	
+	return pixels;
+	
+}
+
+static void ST7789_Chart_DrawPlot(const ST7789_ChartPlotTypeDef *Plot, uint16_t XPos, uint16_t Width, uint16_t Height)
+{
+	
+	uint16_t counter;
+	
+	/* ------------- Background and Grid ------------ */
+	ST7789_Disp_Fill(Plot->hlcd, XPos, Plot->YPos, XPos + Width - 1, Plot->YPos + Height - 1, Plot->BackgroundColor);
+	
+	if (Plot->GridX > 0)
+	{
+		
+		for (counter = 0; counter < Width; counter += Plot->GridX)
+		{
+			ST7789_Disp_Fill(Plot->hlcd, XPos + counter, Plot->YPos, XPos + counter, Plot->YPos + Height - 1, Plot->GridColor);
+		}
+		
+	}
+	
+	if (Plot->GridY > 0)
+	{
+		
+		for (counter = 0; counter < Height; counter += Plot->GridY)
+		{
+			ST7789_Disp_Fill(Plot->hlcd, XPos, Plot->YPos + counter, XPos + Width - 1, Plot->YPos + counter, Plot->GridColor);
+		}
+		
+	}
+	
+}
+
+static uint32_t ST7789_Chart_Restore(const ST7789_ChartPlotTypeDef *Plot, uint16_t X, uint16_t Column, uint16_t Top, uint16_t Bottom)
+{
+	
+	uint32_t pixels = 0;
+	uint16_t gridRow;
+	uint16_t end;
+	
+	/* ------------- Vertical Grid Line ------------- */
+	if ((Plot->GridX > 0) && ((Column % Plot->GridX) == 0))
+	{
+		return ST7789_Chart_Fill(Plot->hlcd, Plot->Stats, X, Plot->YPos + Top, X, Plot->YPos + Bottom, Plot->GridColor);
+	}
+	
+	if (Plot->GridY == 0)
+	{
+		return ST7789_Chart_Fill(Plot->hlcd, Plot->Stats, X, Plot->YPos + Top, X, Plot->YPos + Bottom, Plot->BackgroundColor);
+	}
+	
+	/* ----- Background Runs between the Grid Rows ----- */
+	while (Top <= Bottom)
+	{
+		
+		gridRow = (uint16_t)(((uint32_t)Top + Plot->GridY - 1) / Plot->GridY * Plot->GridY);
+		
+		if (gridRow == Top)
+		{
+			
+			pixels += ST7789_Chart_Fill(Plot->hlcd, Plot->Stats, X, Plot->YPos + Top, X, Plot->YPos + Top, Plot->GridColor);
+			
+			if (Top == Bottom)
+			{
+				break;
+			}
+			
+			Top++;
+			
+			continue;
+			
+		}
+		
+		end    = ((gridRow - 1) < Bottom) ? (gridRow - 1) : Bottom;
+		pixels += ST7789_Chart_Fill(Plot->hlcd, Plot->Stats, X, Plot->YPos + Top, X, Plot->YPos + end, Plot->BackgroundColor);
+		
+		if (end == Bottom)
+		{
+			break;
+		}
+		
+		Top = end + 1;
+		
+	}
+	
+	return pixels;
+	
+}
+
+static uint32_t ST7789_Chart_Column(const ST7789_ChartPlotTypeDef *Plot, uint16_t X, uint16_t Column, uint16_t *Top, uint16_t *Bottom, uint16_t NewTop, uint16_t NewBottom)
+{
+	
+	uint32_t pixels    = 0;
+	uint16_t oldTop    = *Top;
+	uint16_t oldBottom = *Bottom;
+	
+	if ((NewTop == oldTop) && (NewBottom == oldBottom))
+	{
+		return 0;
+	}
+	
+	Plot->Stats->Columns++;
+	
+	/* ~~~~~~~~~~~~~ Erase the Uncovered Rows ~~~~~~~~~~~~~ */
+	if (oldTop <= oldBottom)
+	{
+		
+		if (NewTop > NewBottom)
+		{
+			pixels += ST7789_Chart_Restore(Plot, X, Column, oldTop, oldBottom);
+		}
+		else
+		{
+			
+			if (oldTop < NewTop)
+			{
+				pixels += ST7789_Chart_Restore(Plot, X, Column, oldTop, (oldBottom < NewTop) ? oldBottom : (NewTop - 1));
+			}
+			
+			if (oldBottom > NewBottom)
+			{
+				pixels += ST7789_Chart_Restore(Plot, X, Column, (oldTop > NewBottom) ? oldTop : (NewBottom + 1), oldBottom);
+			}
+			
+		}
+		
+	}
+	
+	/* ~~~~~~~~~~~~~~~ Draw the New Rows ~~~~~~~~~~~~~~~ */
+	if (NewTop <= NewBottom)
+	{
+		
+		if (oldTop > oldBottom)
+		{
+			pixels += ST7789_Chart_Fill(Plot->hlcd, Plot->Stats, X, Plot->YPos + NewTop, X, Plot->YPos + NewBottom, Plot->Color);
+		}
+		else
+		{
+			
+			if (NewTop < oldTop)
+			{
+				pixels += ST7789_Chart_Fill(Plot->hlcd, Plot->Stats, X, Plot->YPos + NewTop, X, Plot->YPos + ((NewBottom < oldTop) ? NewBottom : (oldTop - 1)), Plot->Color);
+			}
+			
+			if (NewBottom > oldBottom)
+			{
+				pixels += ST7789_Chart_Fill(Plot->hlcd, Plot->Stats, X, Plot->YPos + ((NewTop > oldBottom) ? NewTop : (oldBottom + 1)), X, Plot->YPos + NewBottom, Plot->Color);
+			}
+			
+		}
+		
+	}
+	
+	*Top    = NewTop;
+	*Bottom = NewBottom;
+	
+	return pixels;
+	
+}
+
+static void ST7789_Chart_Extend(uint16_t Sample, uint16_t Neighbour, uint16_t *Top, uint16_t *Bottom)
+{
+	
+	/* Half way to the neighbour, the two columns meet without a gap */
+	uint16_t mid = (uint16_t)((int16_t)Sample + ((int16_t)Neighbour - (int16_t)Sample) / 2);
+	
+	*Top    = (mid < *Top) ? mid : *Top;
+	*Bottom = (mid > *Bottom) ? mid : *Bottom;
+	
+}
+
+static uint16_t ST7789_Chart_Clamp(int16_t Sample, uint16_t Height)
+{
+	
+	if (Sample < 0)
+	{
+		return 0;
+	}
+	
+	return ((uint16_t)Sample >= Height) ? (Height - 1) : (uint16_t)Sample;
+	
+}
+
+/* ........................... Trace ........................... */
+void ST7789_Trace_Init(ST7789_TraceTypeDef *Trace)
+{
+	
+	ST7789_ChartPlotTypeDef plot;
+	uint16_t counter;
+	
+	if (Trace->hlcd == NULL)
+	{
+		Trace->hlcd = &ST7789_Display;
+	}
+	
+	Trace->Stats.Updates = 0;
+	Trace->Stats.Columns = 0;
+	Trace->Stats.Spans   = 0;
+	Trace->Stats.Pixels  = 0;
+	
+	if ((Trace->Width == 0) || (Trace->Height == 0))
+	{
+		return;
+	}
+	
+	for (counter = 0; counter < Trace->Width; counter++)
+	{
+		Trace->Top[counter]    = CHART_EMPTY_TOP;
+		Trace->Bottom[counter] = CHART_EMPTY_BOTTOM;
+	}
+	
+	plot.hlcd            = Trace->hlcd;
+	plot.YPos            = Trace->YPos;
+	plot.BackgroundColor = Trace->BackgroundColor;
+	plot.GridColor       = Trace->GridColor;
+	plot.GridX           = Trace->GridX;
+	plot.GridY           = Trace->GridY;
+	
+	ST7789_OS_LOCK(Trace->hlcd);
+	ST7789_Chart_DrawPlot(&plot, Trace->XPos, Trace->Width, Trace->Height);
+	ST7789_OS_UNLOCK(Trace->hlcd);
+	
+}
+
+uint32_t ST7789_Trace_Update(ST7789_TraceTypeDef *Trace, const int16_t *Samples, uint16_t Count)
+{
+	
+	ST7789_ChartPlotTypeDef plot;
+	
+	uint32_t pixels = 0;
+	uint16_t column;
+	uint16_t sample;
+	uint16_t previous = 0;
+	uint16_t next     = 0;
+	uint16_t newTop;
+	uint16_t newBottom;
+	
+	if (Count > Trace->Width)
+	{
+		Count = Trace->Width;
+	}
+	
+	if (Count > 0)
+	{
+		next = ST7789_Chart_Clamp(Samples[0], Trace->Height);
+	}
+	
+	plot.hlcd            = Trace->hlcd;
+	plot.Stats           = &Trace->Stats;
+	plot.YPos            = Trace->YPos;
+	plot.Color           = Trace->Color;
+	plot.BackgroundColor = Trace->BackgroundColor;
+	plot.GridColor       = Trace->GridColor;
+	plot.GridX           = Trace->GridX;
+	plot.GridY           = Trace->GridY;
+	
+	ST7789_OS_LOCK(Trace->hlcd);
+	
+	for (column = 0; column < Trace->Width; column++)
+	{
+		
+		/* ~~~~~~~~~~~~~~~~~~ New Coverage ~~~~~~~~~~~~~~~~~ */
+		if (column < Count)
+		{
+			
+			sample    = next;
+			newTop    = sample;
+			newBottom = sample;
+			
+			if (column > 0)
+			{
+				ST7789_Chart_Extend(sample, previous, &newTop, &newBottom);
+			}
+			
+			if ((column + 1) < Count)
+			{
+				
+				next = ST7789_Chart_Clamp(Samples[column + 1], Trace->Height);
+				ST7789_Chart_Extend(sample, next, &newTop, &newBottom);
+				
+			}
+			
+			previous = sample;
+			
+		}
+		else
+		{
+			newTop    = CHART_EMPTY_TOP;
+			newBottom = CHART_EMPTY_BOTTOM;
+		}
+		
+		pixels += ST7789_Chart_Column(&plot, Trace->XPos + column, column, &Trace->Top[column], &Trace->Bottom[column], newTop, newBottom);
+		
+	}
+	
+	Trace->Stats.Updates++;
+	
+	ST7789_OS_UNLOCK(Trace->hlcd);
+	
+	return pixels;
+	
+}
+
+/* ........................... Strip ........................... */
+static uint16_t ST7789_Strip_GetSample(const ST7789_StripTypeDef *Strip, uint16_t Age)
+{
+	
+	uint16_t index = Strip->Head + Strip->Width - 1 - Age; // Head is the entry after the newest sample
+	
+	return (uint16_t)Strip->Samples[(index >= Strip->Width) ? (index - Strip->Width) : index];
+	
+}
+
+static uint32_t ST7789_Strip_DrawColumn(ST7789_StripTypeDef *Strip, const ST7789_ChartPlotTypeDef *Plot, uint16_t Age)
+{
+	
+	uint16_t x;
+	uint16_t column;
+	uint16_t sample;
+	uint16_t newTop    = CHART_EMPTY_TOP;
+	uint16_t newBottom = CHART_EMPTY_BOTTOM;
+	
+	/* The newest sample is shown at the right column */
+	x = Strip->XPos + Strip->Width - 1 - Age;
+	
+	if (Strip->Mode == ST7789_STRIP_SCROLL)
+	{
+		x = ST7789_Disp_Scroll_GetColumn(Strip->hlcd, x);
+	}
+	
+	column = x - Strip->XPos;
+	
+	/* ~~~~~~~~~~~~~~~~~~ New Coverage ~~~~~~~~~~~~~~~~~ */
+	if (Age < Strip->Count)
+	{
+		
+		sample    = ST7789_Strip_GetSample(Strip, Age);
+		newTop    = sample;
+		newBottom = sample;
+		
+		if (Strip->Style == ST7789_STRIP_FILLED)
+		{
+			newBottom = Strip->Height - 1;
+		}
+		else
+		{
+			
+			if (Age > 0)
+			{
+				ST7789_Chart_Extend(sample, ST7789_Strip_GetSample(Strip, Age - 1), &newTop, &newBottom);
+			}
+			
+			if ((Age + 1) < Strip->Count)
+			{
+				ST7789_Chart_Extend(sample, ST7789_Strip_GetSample(Strip, Age + 1), &newTop, &newBottom);
+			}
+			
+		}
+		
+	}
+	
+	return ST7789_Chart_Column(Plot, x, column, &Strip->Top[column], &Strip->Bottom[column], newTop, newBottom);
+	
+}
+
+ST7789_StatusTypeDef ST7789_Strip_Init(ST7789_StripTypeDef *Strip)
+{
+	
+	ST7789_ChartPlotTypeDef plot;
+	uint16_t counter;
+	
+	if (Strip->hlcd == NULL)
+	{
+		Strip->hlcd = &ST7789_Display;
+	}
+	
+	Strip->Head          = 0;
+	Strip->Count         = 0;
+	Strip->Stats.Updates = 0;
+	Strip->Stats.Columns = 0;
+	Strip->Stats.Spans   = 0;
+	Strip->Stats.Pixels  = 0;
+	
+	if ((Strip->Width == 0) || (Strip->Height == 0))
+	{
+		return ST7789_ERROR;
+	}
+	
+	for (counter = 0; counter < Strip->Width; counter++)
+	{
+		Strip->Top[counter]    = CHART_EMPTY_TOP;
+		Strip->Bottom[counter] = CHART_EMPTY_BOTTOM;
+	}
+	
+	ST7789_OS_LOCK(Strip->hlcd);
+	
+	if ((Strip->Mode == ST7789_STRIP_SCROLL) && (ST7789_Disp_Scroll_Enable(Strip->hlcd, Strip->XPos, Strip->Width) != ST7789_OK))
+	{
+		
+		ST7789_OS_UNLOCK(Strip->hlcd);
+		return ST7789_ERROR;
+		
+	}
+	
+	/* The horizontal grid lines are the same in every column, they do not move with the scroll */
+	plot.hlcd            = Strip->hlcd;
+	plot.YPos            = Strip->YPos;
+	plot.BackgroundColor = Strip->BackgroundColor;
+	plot.GridColor       = Strip->GridColor;
+	plot.GridX           = 0;
+	plot.GridY           = Strip->GridY;
+	
+	ST7789_Chart_DrawPlot(&plot, Strip->XPos, Strip->Width, Strip->Height);
+	
+	ST7789_OS_UNLOCK(Strip->hlcd);
+	
+	return ST7789_OK;
+	
+}
+
+uint32_t ST7789_Strip_Push(ST7789_StripTypeDef *Strip, int16_t Sample)
+{
+	
+	ST7789_ChartPlotTypeDef plot;
+	
+	uint32_t pixels = 0;
+	uint16_t age;
+	
+	if ((Strip->Width == 0) || (Strip->Height == 0))
+	{
+		return 0;
+	}
+	
+	/* ------------------ Add to the Ring ----------------- */
+	Strip->Samples[Strip->Head] = (int16_t)ST7789_Chart_Clamp(Sample, Strip->Height);
+	Strip->Head                 = ((Strip->Head + 1) == Strip->Width) ? 0 : (Strip->Head + 1);
+	
+	if (Strip->Count < Strip->Width)
+	{
+		Strip->Count++;
+	}
+	
+	plot.hlcd            = Strip->hlcd;
+	plot.Stats           = &Strip->Stats;
+	plot.YPos            = Strip->YPos;
+	plot.Color           = Strip->Color;
+	plot.BackgroundColor = Strip->BackgroundColor;
+	plot.GridColor       = Strip->GridColor;
+	plot.GridX           = 0;
+	plot.GridY           = Strip->GridY;
+	
+	ST7789_OS_LOCK(Strip->hlcd);
+	
+	if (Strip->Mode == ST7789_STRIP_SCROLL)
+	{
+		
+		/* ~~~~~~~~~~ Scroll, the Oldest Column comes in at the Right ~~~~~~~~~~ */
+		ST7789_Disp_Scroll_Left(Strip->hlcd);
+		
+		pixels += ST7789_Strip_DrawColumn(Strip, &plot, 0);
+		
+		/* The line of the neighbours ends half way to the new and the dropped sample */
+		if (Strip->Style == ST7789_STRIP_LINE)
+		{
+			
+			if (Strip->Count > 1)
+			{
+				pixels += ST7789_Strip_DrawColumn(Strip, &plot, 1);
+			}
+			
+			if ((Strip->Count == Strip->Width) && (Strip->Width > 2))
+			{
+				pixels += ST7789_Strip_DrawColumn(Strip, &plot, Strip->Width - 1);
+			}
+			
+		}
+		
+	}
+	else
+	{
+		
+		/* ~~~~~~~~~~ Ring, every Column shows the Next Sample ~~~~~~~~~~ */
+		for (age = 0; age < Strip->Width; age++)
+		{
+			pixels += ST7789_Strip_DrawColumn(Strip, &plot, age);
+		}
+		
+	}
+	
+	Strip->Stats.Updates++;
+	
+	ST7789_OS_UNLOCK(Strip->hlcd);
+	
+	return pixels;
+	
+}
+
+/* ............................ Bar ............................ */
+static uint16_t ST7789_Bar_Scale(const ST7789_BarTypeDef *Bar, uint32_t Value)
+{
+	
+	if (Bar->Max > 0)
+	{
+		Value = (Value >= Bar->Max) ? Bar->Length : ((Value * Bar->Length) / Bar->Max);
+	}
+	
+	return (Value > Bar->Length) ? Bar->Length : (uint16_t)Value;
+	
+}
+
+static uint32_t ST7789_Bar_Fill(ST7789_BarTypeDef *Bar, uint16_t Index, uint16_t Start, uint16_t End, ST7789_ColorTypeDef Color)
+{
+	
+	uint16_t position = Index * (Bar->Thickness + Bar->Gap); // Start of the bar across its length
+	
+	/* Start..End-1 are pixels from the base of the bar */
+	if (Bar->Orientation == ST7789_BAR_HORIZONTAL)
+	{
+		return ST7789_Chart_Fill(Bar->hlcd, &Bar->Stats, Bar->XPos + Start, Bar->YPos + position, Bar->XPos + End - 1, Bar->YPos + position + Bar->Thickness - 1, Color);
+	}
+	
+	return ST7789_Chart_Fill(Bar->hlcd, &Bar->Stats, Bar->XPos + position, Bar->YPos + Bar->Length - End, Bar->XPos + position + Bar->Thickness - 1, Bar->YPos + Bar->Length - 1 - Start, Color);
+	
+}
+
+void ST7789_Bar_Init(ST7789_BarTypeDef *Bar)
+{
+	
+	uint32_t counter;
+	uint16_t size;
+	
+	if (Bar->hlcd == NULL)
+	{
+		Bar->hlcd = &ST7789_Display;
+	}
+	
+	Bar->Stats.Updates = 0;
+	Bar->Stats.Columns = 0;
+	Bar->Stats.Spans   = 0;
+	Bar->Stats.Pixels  = 0;
+	
+	if ((Bar->Bars == 0) || (Bar->Segments == 0) || (Bar->Length == 0) || (Bar->Thickness == 0))
+	{
+		return;
+	}
+	
+	for (counter = 0; counter < ((uint32_t)Bar->Bars * Bar->Segments); counter++)
+	{
+		Bar->Ends[counter] = 0;
+	}
+	
+	/* ---------------- Background ---------------- */
+	size = Bar->Bars * Bar->Thickness + (Bar->Bars - 1) * Bar->Gap;
+	
+	if (Bar->Orientation == ST7789_BAR_HORIZONTAL)
+	{
+		ST7789_Disp_Fill(Bar->hlcd, Bar->XPos, Bar->YPos, Bar->XPos + Bar->Length - 1, Bar->YPos + size - 1, Bar->BackgroundColor);
+	}
+	else
+	{
+		ST7789_Disp_Fill(Bar->hlcd, Bar->XPos, Bar->YPos, Bar->XPos + size - 1, Bar->YPos + Bar->Length - 1, Bar->BackgroundColor);
+	}
+	
+}
+
+uint32_t ST7789_Bar_Update(ST7789_BarTypeDef *Bar, const uint16_t *Values)
+{
+	
+	ST7789_ColorTypeDef oldColor;
+	ST7789_ColorTypeDef newColor;
+	ST7789_ColorTypeDef runColor = Bar->BackgroundColor;
+	
+	uint16_t *ends;
+	uint32_t  pixels = 0;
+	uint32_t  sum;
+	uint16_t  bar;
+	uint16_t  newEnd;
+	uint16_t  limit;
+	uint16_t  position;
+	uint16_t  next;
+	uint16_t  runStart;
+	uint16_t  runEnd;
+	uint8_t   oldSegment;
+	uint8_t   newSegment;
+	
+	if ((Bar->Bars == 0) || (Bar->Segments == 0))
+	{
+		return 0;
+	}
+	
+	ST7789_OS_LOCK(Bar->hlcd);
+	
+	for (bar = 0; bar < Bar->Bars; bar++, Values += Bar->Segments)
+	{
+		
+		ends = &Bar->Ends[(uint32_t)bar * Bar->Segments];
+		
+		/* ---------- Walk the Old and New Segments from the Base ---------- */
+		/*
+			Both bars are a sequence of colored parts, only the parts where the old
+			and the new color differ are written (an unchanged bar writes nothing).
+		*/
+		for (sum = 0, newSegment = 0; newSegment < Bar->Segments; newSegment++)
+		{
+			sum += Values[newSegment];
+		}
+		
+		limit      = ST7789_Bar_Scale(Bar, sum);
+		limit      = (ends[Bar->Segments - 1] > limit) ? ends[Bar->Segments - 1] : limit;
+		sum        = Values[0];
+		newEnd     = ST7789_Bar_Scale(Bar, sum);
+		oldSegment = 0;
+		newSegment = 0;
+		position   = 0;
+		runStart   = 0;
+		runEnd     = 0;
+		
+		while (position < limit)
+		{
+			
+			while ((oldSegment < Bar->Segments) && (ends[oldSegment] <= position))
+			{
+				oldSegment++;
+			}
+			
+			while ((newSegment < Bar->Segments) && (newEnd <= position))
+			{
+				
+				if (++newSegment < Bar->Segments)
+				{
+					sum   += Values[newSegment];
+					newEnd = ST7789_Bar_Scale(Bar, sum);
+				}
+				
+			}
+			
+			oldColor = (oldSegment < Bar->Segments) ? Bar->Colors[oldSegment] : Bar->BackgroundColor;
+			newColor = (newSegment < Bar->Segments) ? Bar->Colors[newSegment] : Bar->BackgroundColor;
+			
+			next = (oldSegment < Bar->Segments) ? ends[oldSegment] : limit;
+			next = ((newSegment < Bar->Segments) && (newEnd < next)) ? newEnd : next;
+			
+			if (oldColor != newColor)
+			{
+				
+				/* Join the parts of one color */
+				if ((runEnd == position) && (runEnd > runStart) && (runColor == newColor))
+				{
+					runEnd = next;
+				}
+				else
+				{
+					
+					if (runEnd > runStart)
+					{
+						pixels += ST7789_Bar_Fill(Bar, bar, runStart, runEnd, runColor);
+					}
+					
+					runStart = position;
+					runEnd   = next;
+					runColor = newColor;
+					
+				}
+				
+			}
+			
+			position = next;
+			
+		}
+		
+		if (runEnd > runStart)
+		{
+			
+			pixels += ST7789_Bar_Fill(Bar, bar, runStart, runEnd, runColor);
+			Bar->Stats.Columns++;
+			
+		}
+		
+		/* ------------------ Store the New Ends ------------------ */
+		for (sum = 0, newSegment = 0; newSegment < Bar->Segments; newSegment++)
+		{
+			
+			sum             += Values[newSegment];
+			ends[newSegment] = ST7789_Bar_Scale(Bar, sum);
+			
+		}
+		
+	}
+	
+	Bar->Stats.Updates++;
+	
+	ST7789_OS_UNLOCK(Bar->hlcd);
+	
+	return pixels;
+	
+}
+
+uint32_t ST7789_Histogram_Update(ST7789_BarTypeDef *Bar, const int16_t *Samples, uint16_t Count, int16_t Min, uint16_t BinWidth, uint16_t *Bins)
+{
+	
+	uint32_t bin;
+	uint16_t counter;
+	
+	if (Bar->Segments != 1)
+	{
+		return 0;
+	}
+	
+	if (BinWidth == 0)
+	{
+		BinWidth = 1;
+	}
+	
+	for (counter = 0; counter < Bar->Bars; counter++)
+	{
+		Bins[counter] = 0;
+	}
+	
+	/* ------------------ Count the Samples ----------------- */
+	for (counter = 0; counter < Count; counter++)
+	{
+		
+		if (Samples[counter] < Min)
+		{
+			continue;
+		}
+		
+		bin = (uint32_t)((int32_t)Samples[counter] - Min) / BinWidth;
+		
+		if ((bin < Bar->Bars) && (Bins[bin] < UINT16_MAX))
+		{
+			Bins[bin]++;
+		}
+		
+	}
+	
+	return ST7789_Bar_Update(Bar, Bins);
+	
+}
+
+/* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ End of the program ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
@@ -0,0 +1,327 @@
+/*
+------------------------------------------------------------------------------
+~ File   : st7789_chart.h
+~ Author : Majid Derhambakhsh
+~ Version: V1.0.0
+~ Created: 08/25/2023 18:00:00 PM
+~ Brief  : Chart widgets with delta-only updates (trace, strip chart, bar graph, histogram)
+~ Support:
+           E-Mail : Majid.Derhambakhsh@gmail.com (subject : Embedded Library Support)
+
+           Github : https://github.com/Majid-Derhambakhsh
+------------------------------------------------------------------------------
+~ Description:    A widget remembers what it has drawn and every update writes only the
+                  difference, the plot area is never cleared.
+
+                  Trace: The covered rows of every column of a waveform (from the sample
+                  to the half way points of its neighbours) are kept. An update erases the
+                  rows that are no longer covered and draws the new rows, both as vertical
+                  spans, the grid is put back into the erased rows.
+
+                  Strip  : A rolling chart of the last samples (line or filled). In the ring
+                  mode the samples are kept in a ring and every column is compared with the
+                  sample it shows now, in the scroll mode the hardware scroll moves the
+                  chart and only the new column and its neighbours are written.
+
+                  Bar    : Vertical or horizontal bars, each bar may be stacked from segments.
+                  The drawn end of every segment is kept, an update writes only the parts
+                  of a bar whose color changed. A histogram counts the samples into the
+                  bars of a bar graph.
+
+~ Attention  :    The column memory of a widget comes from the caller, one widget per
+                  structure. Call the Init function again after something else is drawn
+                  over the widget.
+
+                  The scroll mode of the strip chart needs rotation 1 or 3 and scrolls every
+                  row of its columns, keep the rest of these columns empty.
+
+~ Changes    :
+------------------------------------------------------------------------------
+*/
+
+#ifndef __ST7789_CHART_H_
+#define __ST7789_CHART_H_
+
+/* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ Include ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+#include "st7789.h"
+
+/* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ Types ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+typedef enum /* Strip Chart Style */
+{
+	
+	ST7789_STRIP_LINE   = 0, // Line through the samples
+	ST7789_STRIP_FILLED = 1, // Filled from the sample to the bottom row
+	
+}ST7789_StripStyleTypeDef;
+
+typedef enum /* Strip Chart Mode */
+{
+	
+	ST7789_STRIP_RING   = 0, // Every column is updated to the sample it shows now
+	ST7789_STRIP_SCROLL = 1, // Hardware scroll, the new column is written (Rotation 1 and 3)
+	
+}ST7789_StripModeTypeDef;
+
+typedef enum /* Bar Orientation */
+{
+	
+	ST7789_BAR_VERTICAL   = 0, // Bars grow up from the bottom row
+	ST7789_BAR_HORIZONTAL = 1, // Bars grow right from the left column
+	
+}ST7789_BarOrientationTypeDef;
+
+typedef struct /* Chart Statistics */
+{
+	
+	uint32_t Updates; // Update calls
+	uint32_t Columns; // Columns (or bars) with a changed geometry
+	uint32_t Spans;   // Written spans (windows)
+	uint32_t Pixels;  // Written pixels
+	
+}ST7789_ChartStatsTypeDef;
+
+typedef struct /* Waveform Trace */
+{
+	
+	/* ~~~~~~~~~~~~~~~~~~~~~ Set before ST7789_Trace_Init ~~~~~~~~~~~~~~~~~~~~~ */
+	ST7789_HandleTypeDef    *hlcd;            // Display (NULL: ST7789_Display)
+	
+	uint16_t                 XPos;            // Top left of the plot area
+	uint16_t                 YPos;
+	uint16_t                 Width;           // Columns, one sample per column
+	uint16_t                 Height;          // Rows
+	
+	ST7789_ColorTypeDef      Color;           // Trace
+	ST7789_ColorTypeDef      BackgroundColor;
+	ST7789_ColorTypeDef      GridColor;
+	uint16_t                 GridX;           // Columns between the vertical grid lines (0: None)
+	uint16_t                 GridY;           // Rows between the horizontal grid lines (0: None)
+	
+	uint16_t                *Top;             // Width entries: First covered row of every column
+	uint16_t                *Bottom;          // Width entries: Last covered row (Top > Bottom: Empty)
+	
+	/* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ State ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+	ST7789_ChartStatsTypeDef Stats;
+	
+}ST7789_TraceTypeDef;
+
+typedef struct /* Strip Chart */
+{
+	
+	/* ~~~~~~~~~~~~~~~~~~~~~ Set before ST7789_Strip_Init ~~~~~~~~~~~~~~~~~~~~~ */
+	ST7789_HandleTypeDef    *hlcd;            // Display (NULL: ST7789_Display)
+	
+	uint16_t                 XPos;            // Top left of the plot area
+	uint16_t                 YPos;
+	uint16_t                 Width;           // Columns, the newest sample is at the right column
+	uint16_t                 Height;          // Rows
+	
+	ST7789_ColorTypeDef      Color;
+	ST7789_ColorTypeDef      BackgroundColor;
+	ST7789_ColorTypeDef      GridColor;
+	uint16_t                 GridY;           // Rows between the horizontal grid lines (0: None)
+	uint8_t                  Style;           // ST7789_StripStyleTypeDef
+	uint8_t                  Mode;            // ST7789_StripModeTypeDef
+	
+	int16_t                 *Samples;         // Width entries: Ring of the last samples
+	uint16_t                *Top;             // Width entries: First covered row of every column
+	uint16_t                *Bottom;          // Width entries: Last covered row (Top > Bottom: Empty)
+	
+	/* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ State ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+	uint16_t                 Head;            // Next entry of Samples
+	uint16_t                 Count;           // Samples in the ring
+	ST7789_ChartStatsTypeDef Stats;
+	
+}ST7789_StripTypeDef;
+
+typedef struct /* Bar Graph */
+{
+	
+	/* ~~~~~~~~~~~~~~~~~~~~~~ Set before ST7789_Bar_Init ~~~~~~~~~~~~~~~~~~~~~~ */
+	ST7789_HandleTypeDef      *hlcd;            // Display (NULL: ST7789_Display)
+	
+	uint16_t                   XPos;            // Top left of the first bar
+	uint16_t                   YPos;
+	uint16_t                   Length;          // Pixels of a full bar
+	uint16_t                   Thickness;       // Width of a vertical bar, height of a horizontal bar
+	uint16_t                   Gap;             // Pixels between the bars
+	uint16_t                   Bars;
+	uint8_t                    Segments;        // Stacked segments of every bar (1: Simple bars)
+	uint8_t                    Orientation;     // ST7789_BarOrientationTypeDef
+	uint16_t                   Max;             // Value of a full bar (0: The values are pixels)
+	
+	const ST7789_ColorTypeDef *Colors;          // Segments entries, from the base of the bar
+	ST7789_ColorTypeDef        BackgroundColor;
+	
+	uint16_t                  *Ends;            // Bars x Segments entries: Drawn end of every segment (Pixels from the base)
+	
+	/* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ State ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+	ST7789_ChartStatsTypeDef   Stats;
+	
+}ST7789_BarTypeDef;
+
+/* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ Prototype ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+/* ........................... Trace ........................... */
+/*
+ * Function: ST7789_Trace_Init
+ * ---------------------------
+ * Draw the empty plot area with its grid, the columns are empty
+ *
+ * Param  :
+ *         Trace : Trace with the settings and the column memory
+ *
+ * Returns:
+ *         -
+ *
+ * Example:
+ *         static uint16_t top[200], bottom[200];
+ *         static ST7789_TraceTypeDef scope = {NULL, 20, 40, 200, 128, ST7789_COLOR_GREEN, ST7789_COLOR_BLACK,
+ *                                             ST7789_COLOR_GRAY, 25, 32, top, bottom};
+ *
+ *         ST7789_Trace_Init(&scope);
+ *         ...
+ *
+ */
+void ST7789_Trace_Init(ST7789_TraceTypeDef *Trace);
+
+/*
+ * Function: ST7789_Trace_Update
+ * -----------------------------
+ * Draw a new waveform, only the rows whose coverage changed are written
+ *
+ * Param  :
+ *         Trace   : Trace
+ *         Samples : Row of every column (0: Top row of the plot area, clamped to the area)
+ *         Count   : Samples, the columns after them are empty (Width at most)
+ *
+ * Returns:
+ *         Pixels : Written pixels
+ *
+ * Example:
+ *         for (i = 0; i < 200; i++)
+ *         {
+ *             samples[i] = 127 - (adc[i] >> 5); // 12-bit ADC to 128 rows
+ *         }
+ *
+ *         ST7789_Trace_Update(&scope, samples, 200);
+ *         ...
+ *
+ */
+uint32_t ST7789_Trace_Update(ST7789_TraceTypeDef *Trace, const int16_t *Samples, uint16_t Count);
+
+/* ........................... Strip ........................... */
+/*
+ * Function: ST7789_Strip_Init
+ * ---------------------------
+ * Draw the empty plot area with its grid, the ring is empty
+ *
+ * Param  :
+ *         Strip : Strip chart with the settings and the ring memory
+ *
+ * Returns:
+ *         ST7789_OK    : The strip chart is ready
+ *         ST7789_ERROR : Scroll mode in rotation 0 or 2, or outside of the display (See ST7789_Scroll_Enable)
+ *
+ * Example:
+ *         static int16_t  ring[280];
+ *         static uint16_t top[280], bottom[280];
+ *         static ST7789_StripTypeDef load = {NULL, 0, 0, 280, 240, ST7789_COLOR_CYAN, ST7789_COLOR_BLACK,
+ *                                            ST7789_COLOR_GRAY, 40, ST7789_STRIP_LINE, ST7789_STRIP_SCROLL, ring, top, bottom};
+ *
+ *         ST7789_Strip_Init(&load);
+ *         ...
+ *
+ */
+ST7789_StatusTypeDef ST7789_Strip_Init(ST7789_StripTypeDef *Strip);
+
+/*
+ * Function: ST7789_Strip_Push
+ * ---------------------------
+ * Add a sample at the right column, the older samples move one column to the left
+ *
+ * Param  :
+ *         Strip  : Strip chart
+ *         Sample : Row of the sample (0: Top row of the plot area, clamped to the area)
+ *
+ * Returns:
+ *         Pixels : Written pixels
+ *
+ * Example:
+ *         ST7789_Strip_Push(&load, 239 - (cpuLoad * 239) / 100);
+ *         ...
+ *
+ */
+uint32_t ST7789_Strip_Push(ST7789_StripTypeDef *Strip, int16_t Sample);
+
+/* ............................ Bar ............................ */
+/*
+ * Function: ST7789_Bar_Init
+ * -------------------------
+ * Draw the background of the bars, the bars are empty
+ *
+ * Param  :
+ *         Bar : Bar graph with the settings and the segment memory
+ *
+ * Returns:
+ *         -
+ *
+ * Example:
+ *         static const ST7789_ColorTypeDef colors[3] = {ST7789_COLOR_GREEN, ST7789_COLOR_YELLOW, ST7789_COLOR_RED};
+ *         static uint16_t                  ends[4 * 3];
+ *         static ST7789_BarTypeDef         tasks = {NULL, 10, 100, 120, 30, 6, 4, 3, ST7789_BAR_VERTICAL, 100,
+ *                                                   colors, ST7789_COLOR_BLACK, ends};
+ *
+ *         ST7789_Bar_Init(&tasks);
+ *         ...
+ *
+ */
+void ST7789_Bar_Init(ST7789_BarTypeDef *Bar);
+
+/*
+ * Function: ST7789_Bar_Update
+ * ---------------------------
+ * Draw new values, only the parts of the bars whose color changed are written
+ *
+ * Param  :
+ *         Bar    : Bar graph
+ *         Values : Bars x Segments values, the segments of a bar follow each other from the base
+ *
+ * Returns:
+ *         Pixels : Written pixels
+ *
+ * Example:
+ *         uint16_t values[4 * 3] = {20, 10, 5,  40, 0, 0,  10, 30, 30,  5, 5, 5}; // Stacked (Max: 100)
+ *
+ *         ST7789_Bar_Update(&tasks, values);
+ *         ...
+ *
+ */
+uint32_t ST7789_Bar_Update(ST7789_BarTypeDef *Bar, const uint16_t *Values);
+
+/*
+ * Function: ST7789_Histogram_Update
+ * ---------------------------------
+ * Count the samples into the bars of a simple bar graph (Segments: 1) and draw the counts
+ *
+ * Param  :
+ *         Bar      : Bar graph, one bar per bin
+ *         Samples  : Samples, the samples outside of the bins are not counted
+ *         Count    : Samples
+ *         Min      : Lowest value of the first bin
+ *         BinWidth : Values of a bin
+ *         Bins     : Bars entries, the counts of the bins
+ *
+ * Returns:
+ *         Pixels : Written pixels
+ *
+ * Example:
+ *         static uint16_t bins[32];
+ *
+ *         ST7789_Histogram_Update(&spread, adcSamples, 1024, 0, 128, bins); // 12-bit ADC in 32 bins
+ *         ...
+ *
+ */
+uint32_t ST7789_Histogram_Update(ST7789_BarTypeDef *Bar, const int16_t *Samples, uint16_t Count, int16_t Min, uint16_t BinWidth, uint16_t *Bins);
+
+/* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ End of the program ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+#endif /* __ST7789_CHART_H_ */
@@ -37,8 +37,12 @@
 //#include "spi_unit.h"
 
 /* Driver-library for STM32 */
+#ifndef ST7789_HOST
 #include "main.h"
 #include "spi.h"
+#endif
+
+/* Host simulation (PC): Define ST7789_HOST in the compiler options */
 
 /* ~~~~~~~~~~~~~~~~~~~ Fonts ~~~~~~~~~~~~~~~~~~~ */
 
@@ -91,7 +95,86 @@
 #define ST7789_USE_DMA
 
 #define ST7789_DMA_MIN_SIZE  16 // Minimum size of data length
+
+/* ~~~~~~~~~~~ OS ~~~~~~~~~~~ */
+/*
+	Guide :
+			LCD_USE_FREE_RTOS     : 1 = Lock every call with a FreeRTOS mutex and block on a semaphore for DMA (HAL)
+			ST7789_USE_PTHREAD    : Use POSIX threads (Always used on the host)
+			ST7789_OS_TX_TIMEOUT  : Poll the bus again after this time without the TX complete callback (ms)
+			
+	Notice:
+		- Call ST7789_Disp_TxCpltCallback from HAL_SPI_TxCpltCallback, the waiting task wakes at the end of the transfer
+		- Call ST7789_Init before the tasks start drawing, the first call creates the mutex and the semaphore
+		- FreeRTOS needs configUSE_RECURSIVE_MUTEXES 1
+*/
+
+#define LCD_USE_FREE_RTOS     0
+
+//#define ST7789_USE_PTHREAD
+
+#define ST7789_OS_TX_TIMEOUT  2
+
+/* ~~~~~~~~~ Cache ~~~~~~~~~ */
+/*
+	Guide :
+			ST7789_CACHE_CLEAN(Addr, Size) : Write the D-cache back before DMA reads the data, Addr and Size are whole cache lines
+			                                 (Default on Cortex-M7: SCB_CleanDCache_by_Addr)
+			ST7789_CACHE_LINE              : Cache line size (Bytes)
+			
+	Notice:
+		- The LCD Buffer is aligned and padded to cache lines, ST7789_PutImage data is cleaned before it is sent
+		- If all the transmitted data is in a non-cacheable MPU region (e.g. SRAM with TEX=1, C=0, B=0),
+		  define ST7789_CACHE_CLEAN(Addr, Size) as ((void)0) to skip the maintenance
+*/
+
+//#define ST7789_CACHE_CLEAN(Addr, Size)  ((void)0)
 
+/* ~~~~~~~~~~ Bus ~~~~~~~~~~ */
+/*
+	Guide :
+			ST7789_USE_FMC              : Use the 8080 parallel interface on the FMC/FSMC instead of SPI
+			ST7789_USE_SPI_LL           : Use ST7789_Bus_SPI_LL, the HAL call costs more than a short SPI transfer
+			ST7789_FMC_COMMAND_ADDRESS  : Address of the bank with D/CX low
+			ST7789_FMC_DATA_ADDRESS     : Address of the bank with D/CX high
+			ST7789_FMC_WIDTH            : Data bus width (8 or 16)
+			
+	Example :
+				D/CX on A16, 16-bit bus, NE1: Data address = 0x60000000 | (1 << (16 + 1))
+*/
+
+//#define ST7789_USE_FMC
+
+// Uncomment to write commands and short data to the SPI registers (HAL, except STM32H7)
+//#define ST7789_USE_SPI_LL
+#define ST7789_SPI_LL_MAX_SIZE      32 // Longer data is sent by HAL/DMA
+
+#define ST7789_FMC_COMMAND_ADDRESS  0x60000000
+#define ST7789_FMC_DATA_ADDRESS     0x60020000
+#define ST7789_FMC_WIDTH            16
+
+/* ~~~~~~~~~~ Init ~~~~~~~~~~ */
+/*
+	Guide :
+			ST7789_INIT_POWER_DELAY   : Wait for the LCD power before the reset (ms)
+			ST7789_INIT_RESET_DELAY   : Reset pulse (ms, Datasheet: 10us)
+			ST7789_INIT_READY_DELAY   : Wait after the reset before the first command (ms, Datasheet: 5ms)
+			ST7789_INIT_SLPOUT_DELAY  : Wait after sleep out (ms, Datasheet: 5ms)
+			
+			ST7789_INIT_CLEAR_COLOR   : Fill the display before it is turned on (Comment it if the first frame covers the display)
+*/
+
+#define ST7789_INIT_POWER_DELAY   0
+#define ST7789_INIT_RESET_DELAY   1
+#define ST7789_INIT_READY_DELAY   5
+#define ST7789_INIT_SLPOUT_DELAY  5
+
+#define ST7789_INIT_CLEAR_COLOR   ST7789_COLOR_BLACK
+
+/* ~~~~~ Register Cache ~~~~~ */
+// Comment the line to send CASET/RASET/MADCTL/COLMOD/INV on every call
+#define ST7789_USE_REG_CACHE
+
 /* ~~~~~~~~~ Buffer ~~~~~~~~~ */
 /*
 
@@ -104,10 +187,65 @@
 		- If your MCU RAM size is very low, disable DMA
 		
 		- Increase LCD Buffer length to LCD resolution size for increased speed (If MCU has enough RAM)
+		- Set ST7789_HOR_LEN to 0 and call ST7789_AddMemory before ST7789_Init to use your own memory
+		  (e.g. external SDRAM), the chunk sizes follow the given memory
 	
 */
 
 #define ST7789_HOR_LEN 	     5 // Buffer length factor
+#define ST7789_PATTERN_CHUNK 32 // Pixels of ST7789_FillPattern/FillGradient on the stack if there is no LCD Buffer, and of ST7789_Fill without the repeat mode
+#define ST7789_LINE_CHUNK    32 // Pixels of ST7789_DrawLine_AA on the stack if there is no LCD Buffer
+#define ST7789_CLIP_DEPTH    4  // Nested areas of ST7789_Clip_Push
+
+/* ~~~~~~~~ Readback ~~~~~~~~ */
+/*
+	Guide :
+			ST7789_SPI_READ_PRESCALER  : SPI prescaler during GRAM read (The read clock of ST7789 is slower than write)
+			ST7789_READ_CHUNK          : Pixels converted per SPI read (3 bytes per pixel on the stack)
+*/
+
+//#define ST7789_SPI_READ_PRESCALER  SPI_BAUDRATEPRESCALER_16
+#define ST7789_READ_CHUNK          16
+
+/* ~~~~~~~~~ Frame ~~~~~~~~~~ */
+/*
+	Guide :
+			ST7789_FRAME_MAX_AREAS  : Maximum dirty areas of one frame (Extra areas are merged)
+			ST7789_FRAME_PERIOD_US  : Frame period until the TE period is measured (us)
+			ST7789_FRAME_WAIT()     : Called while the scheduler waits for the scan line (e.g. osThreadYield())
+			
+			ST7789_HOST_SPI_CLOCK   : Simulated SPI clock of the host build (Hz, 0: No bus delay)
+*/
+
+#define ST7789_FRAME_MAX_AREAS  8
+#define ST7789_FRAME_PERIOD_US  16667
+#define ST7789_FRAME_WAIT()
+
+#define ST7789_HOST_SPI_CLOCK   40000000
+
+/* ~~~~~~~~~ Queue ~~~~~~~~~~ */
+/*
+	Guide :
+			ST7789_QUEUE_SIZE            : Draw commands in the queue of st7789_queue.h (Power of 2)
+			ST7789_QUEUE_TEXT_LEN        : Characters copied by ST7789_Queue_Text
+			ST7789_QUEUE_COALESCE_DEPTH  : Later commands searched for the same target (0: Draw every command)
+*/
+
+#define ST7789_QUEUE_SIZE            32
+#define ST7789_QUEUE_TEXT_LEN        24
+#define ST7789_QUEUE_COALESCE_DEPTH  8
+
+/* ~~~~~~~~~ Sprite ~~~~~~~~~ */
+/*
+	Guide :
+			ST7789_SPRITE_MAX        : Sprites of st7789_sprite.h
+			ST7789_SPRITE_MAX_AREAS  : Dirty areas of one update (Extra areas are merged)
+			ST7789_SPRITE_CHUNK      : Pixels composed on the stack if there is no LCD Buffer
+*/
+
+#define ST7789_SPRITE_MAX        8
+#define ST7789_SPRITE_MAX_AREAS  8
+#define ST7789_SPRITE_CHUNK      32
 
 /* ~~~~~~~~~~~~~~~~~~ Options ~~~~~~~~~~~~~~~~~~ */
 #define ST7789_WIDTH     240
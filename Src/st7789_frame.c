@@ -0,0 +1,351 @@
+/*
+------------------------------------------------------------------------------
+~ File   : st7789_frame.c
+~ Author : Majid Derhambakhsh
+~ Version: V1.0.0
+~ Created: 08/25/2023 18:00:00 PM
+~ Brief  : Tearing effect (TE) synchronised frame scheduler
+~ Support:
+           E-Mail : Majid.Derhambakhsh@gmail.com (subject : Embedded Library Support)
+
+           Github : https://github.com/Majid-Derhambakhsh
+------------------------------------------------------------------------------
+~ Description:
+
+~ Attention  :
+
+~ Changes    :
+------------------------------------------------------------------------------
+*/
+
+/* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ Include ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+#include "st7789_frame.h"
+
+/* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ Defines ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+#define FRAME_PIXEL_TIME_INIT  410 // Transfer time of one pixel until it is measured (1/256 us, 16 bit at 10MHz)
+#define FRAME_LEARN_TICKS      8   // Shorter flushes are not measured, one tick of the time base would be a large error
+
+#ifndef ST7789_MICROS_TICK
+	#define ST7789_MICROS_TICK  1U // Resolution of ST7789_GetMicros (us)
+#endif
+
+/* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ G Struct ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+typedef struct /* Dirty Area */
+{
+	
+	ST7789_AreaTypeDef Area;
+	
+	uint16_t ScanFirst; // First row of the area in the scan order of the panel
+	uint16_t ScanLast;  // Last row of the area in the scan order of the panel
+	
+}ST7789_FrameAreaTypeDef;
+
+/* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ G Variables ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+static ST7789_FrameFlushTypeDef FrameFlush;
+static ST7789_FrameAreaTypeDef  FrameAreas[ST7789_FRAME_MAX_AREAS];
+static uint8_t                  FrameAreaCount;
+
+static volatile uint32_t FrameTECount;
+static volatile uint32_t FrameTETime;
+static volatile uint32_t FrameTEPeriod;
+
+static uint32_t FrameLastTE;
+static uint32_t FrameLastStart;
+static uint32_t FramePixelTime;
+
+static ST7789_FrameStatsTypeDef FrameStats;
+
+/* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ Function ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+static void ST7789_Frame_SetScanRows(ST7789_FrameAreaTypeDef *Dirty)
+{
+	
+	/*
+		The panel is refreshed from the first to the last gate line, the rotation
+		decides which display axis and direction this is.
+	*/
+	switch (ST7789_Display.Rotation)
+	{
+		
+		case 0: /* MY: Bottom to top */
+		
+		Dirty->ScanFirst = ST7789_HEIGHT_MAX - 1 - (Dirty->Area.YEnd + ST7789_Display.YOffset);
+		Dirty->ScanLast  = ST7789_HEIGHT_MAX - 1 - (Dirty->Area.YStart + ST7789_Display.YOffset);
+		
+		break;
+		
+		case 1: /* MY, MV: Right to left */
+		
+		Dirty->ScanFirst = ST7789_HEIGHT_MAX - 1 - (Dirty->Area.XEnd + ST7789_Display.XOffset);
+		Dirty->ScanLast  = ST7789_HEIGHT_MAX - 1 - (Dirty->Area.XStart + ST7789_Display.XOffset);
+		
+		break;
+		
+		case 2: /* Top to bottom */
+		
+		Dirty->ScanFirst = Dirty->Area.YStart + ST7789_Display.YOffset;
+		Dirty->ScanLast  = Dirty->Area.YEnd + ST7789_Display.YOffset;
+		
+		break;
+		
+		default: /* MV: Left to right */
+		
+		Dirty->ScanFirst = Dirty->Area.XStart + ST7789_Display.XOffset;
+		Dirty->ScanLast  = Dirty->Area.XEnd + ST7789_Display.XOffset;
+		
+		break;
+		
+	}
+	
+}
+
+static uint32_t ST7789_Frame_GetAreaSize(const ST7789_AreaTypeDef *Area)
+{
+	return (uint32_t)(Area->XEnd - Area->XStart + 1) * (Area->YEnd - Area->YStart + 1);
+}
+
+void ST7789_Frame_Init(ST7789_FrameFlushTypeDef Flush)
+{
+	
+	FrameFlush     = Flush;
+	FrameAreaCount = 0;
+	
+	FrameTEPeriod  = 0;
+	FrameLastTE    = FrameTECount;
+	FrameLastStart = 0;
+	FramePixelTime = FRAME_PIXEL_TIME_INIT;
+	
+	FrameStats.Frames          = 0;
+	FrameStats.MissedDeadlines = 0;
+	FrameStats.Waits           = 0;
+	FrameStats.FrameTime       = 0;
+	FrameStats.FlushTime       = 0;
+	FrameStats.TEPeriod        = 0;
+	
+	/* ----------------- Enable TE ------------------ */
+	ST7789_TearEffect(ST7789_TEAR_ON);
+	
+}
+
+void ST7789_Frame_Invalidate(uint16_t XStart, uint16_t YStart, uint16_t XEnd, uint16_t YEnd)
+{
+	
+	ST7789_AreaTypeDef area;
+	ST7789_AreaTypeDef merged;
+	ST7789_AreaTypeDef *dirty;
+	
+	uint32_t growth;
+	uint32_t minGrowth = UINT32_MAX;
+	uint8_t  areaCounter;
+	uint8_t  mergeIndex = 0;
+	
+	/* ---------------- Size Control ---------------- */
+	if ((XStart > XEnd) || (YStart > YEnd) || (XStart >= ST7789_Display.Width) || (YStart >= ST7789_Display.Height))
+	{
+		return;
+	}
+	
+	area.XStart = XStart;
+	area.YStart = YStart;
+	area.XEnd   = (XEnd >= ST7789_Display.Width) ? (ST7789_Display.Width - 1) : XEnd;
+	area.YEnd   = (YEnd >= ST7789_Display.Height) ? (ST7789_Display.Height - 1) : YEnd;
+	
+	/* ------- Find Overlapping or Nearest Area ------- */
+	for (areaCounter = 0; areaCounter < FrameAreaCount; areaCounter++)
+	{
+		
+		dirty = &FrameAreas[areaCounter].Area;
+		
+		if ((area.XStart <= dirty->XEnd) && (area.XEnd >= dirty->XStart) && (area.YStart <= dirty->YEnd) && (area.YEnd >= dirty->YStart))
+		{
+			minGrowth  = 0; // Overlapping areas are always merged
+			mergeIndex = areaCounter;
+			break;
+		}
+		
+		merged.XStart = (area.XStart < dirty->XStart) ? area.XStart : dirty->XStart;
+		merged.YStart = (area.YStart < dirty->YStart) ? area.YStart : dirty->YStart;
+		merged.XEnd   = (area.XEnd > dirty->XEnd) ? area.XEnd : dirty->XEnd;
+		merged.YEnd   = (area.YEnd > dirty->YEnd) ? area.YEnd : dirty->YEnd;
+		
+		growth = ST7789_Frame_GetAreaSize(&merged) - ST7789_Frame_GetAreaSize(dirty);
+		
+		if (growth < minGrowth)
+		{
+			minGrowth  = growth;
+			mergeIndex = areaCounter;
+		}
+		
+	}
+	
+	/* --------------- Add or Merge Area ------------ */
+	if ((minGrowth != 0) && (FrameAreaCount < ST7789_FRAME_MAX_AREAS))
+	{
+		mergeIndex = FrameAreaCount++;
+		FrameAreas[mergeIndex].Area = area;
+	}
+	else
+	{
+	
+		dirty = &FrameAreas[mergeIndex].Area;
+	
+		dirty->XStart = (area.XStart < dirty->XStart) ? area.XStart : dirty->XStart;
+		dirty->YStart = (area.YStart < dirty->YStart) ? area.YStart : dirty->YStart;
+		dirty->XEnd   = (area.XEnd > dirty->XEnd) ? area.XEnd : dirty->XEnd;
+		dirty->YEnd   = (area.YEnd > dirty->YEnd) ? area.YEnd : dirty->YEnd;
+	
+	}
+	
+	ST7789_Frame_SetScanRows(&FrameAreas[mergeIndex]);
+	
+}
+
+void ST7789_Frame_TE_Callback(void)
+{
+	
+	uint32_t now = ST7789_GetMicros();
+	
+	/* ---------------- Measure Period -------------- */
+	if (FrameTECount != 0)
+	{
+		FrameTEPeriod = now - FrameTETime;
+	}
+	
+	FrameTETime = now;
+	FrameTECount++;
+	
+}
+
+uint8_t ST7789_Frame_Process(void)
+{
+	
+	ST7789_FrameAreaTypeDef areas[ST7789_FRAME_MAX_AREAS];
+	ST7789_FrameAreaTypeDef swap;
+	
+	uint8_t  areaCount;
+	uint8_t  areaCounter;
+	uint8_t  sortCounter;
+	uint8_t  missed = 0;
+	
+	uint32_t teCount;
+	uint32_t frameStart;
+	uint32_t period;
+	uint32_t start;
+	uint32_t now;
+	uint32_t pixels;
+	uint32_t transferTime;
+	uint32_t reachTime;
+	uint32_t passTime;
+	
+	/* ----------------- TE Snapshot ---------------- */
+	do
+	{
+		teCount    = FrameTECount;
+		frameStart = FrameTETime;
+	}
+	while (teCount != FrameTECount);
+	
+	if ((teCount == FrameLastTE) || (FrameAreaCount == 0) || (FrameFlush == NULL))
+	{
+		return 0;
+	}
+	
+	period = (FrameTEPeriod != 0) ? FrameTEPeriod : ST7789_FRAME_PERIOD_US;
+	start  = ST7789_GetMicros();
+	
+	/* Started after the frame of the last TE pulse */
+	while ((start - frameStart) >= period)
+	{
+		frameStart += period;
+		missed      = 1;
+	}
+	
+	/* -------------- Sort by Scan Order ------------ */
+	areaCount      = FrameAreaCount;
+	FrameAreaCount = 0;
+	
+	for (areaCounter = 0; areaCounter < areaCount; areaCounter++)
+	{
+	
+		areas[areaCounter] = FrameAreas[areaCounter];
+	
+		for (sortCounter = areaCounter; (sortCounter > 0) && (areas[sortCounter - 1].ScanFirst > areas[sortCounter].ScanFirst); sortCounter--)
+		{
+			swap                   = areas[sortCounter];
+			areas[sortCounter]     = areas[sortCounter - 1];
+			areas[sortCounter - 1] = swap;
+		}
+	
+	}
+	
+	/* ---------------- Flush the Areas ------------- */
+	for (areaCounter = 0; areaCounter < areaCount; areaCounter++)
+	{
+	
+		pixels       = ST7789_Frame_GetAreaSize(&areas[areaCounter].Area);
+		transferTime = (pixels * FramePixelTime) >> 8;
+	
+		reachTime = ((uint32_t)areas[areaCounter].ScanFirst * period) / ST7789_HEIGHT_MAX;
+		passTime  = ((uint32_t)(areas[areaCounter].ScanLast + 1) * period) / ST7789_HEIGHT_MAX;
+	
+		now = ST7789_GetMicros();
+	
+		/* ~~~~~~~~~~~~ Stay behind the scan line if it cannot be raced ~~~~~~~~~~~~ */
+		if (((now - frameStart) + transferTime > reachTime) && ((now - frameStart) < passTime))
+		{
+	
+			FrameStats.Waits++;
+	
+			while ((ST7789_GetMicros() - frameStart) < passTime)
+			{
+				ST7789_FRAME_WAIT();
+			}
+	
+			now = ST7789_GetMicros();
+	
+		}
+	
+		FrameFlush(&areas[areaCounter].Area);
+		ST7789_WaitForTransfer(); // The last DMA transfer of the area
+	
+		/* ~~~~~~~~~~~~~~~~~~~~~~~~ Learn the transfer rate ~~~~~~~~~~~~~~~~~~~~~~~~ */
+		transferTime = ST7789_GetMicros() - now;
+	
+		if (transferTime >= (FRAME_LEARN_TICKS * ST7789_MICROS_TICK))
+		{
+			transferTime   = (transferTime << 8) / pixels;
+			FramePixelTime = ((FramePixelTime * 3) + transferTime) / 4;
+		}
+	
+	}
+	
+	/* ------------------ Statistics ---------------- */
+	now = ST7789_GetMicros();
+	
+	if (FrameTECount != teCount)
+	{
+		missed = 1; // The next TE pulse arrived during the flush
+	}
+	
+	if (FrameStats.Frames != 0)
+	{
+		FrameStats.FrameTime = start - FrameLastStart;
+	}
+	
+	FrameStats.FlushTime        = now - start;
+	FrameStats.TEPeriod         = FrameTEPeriod;
+	FrameStats.MissedDeadlines += missed;
+	FrameStats.Frames++;
+	
+	FrameLastStart = start;
+	FrameLastTE    = teCount;
+	
+	return 1;
+	
+}
+
+void ST7789_Frame_GetStats(ST7789_FrameStatsTypeDef *Stats)
+{
+	*Stats = FrameStats;
+}
+
+/* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ End of the program ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
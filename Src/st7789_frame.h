@@ -0,0 +1,177 @@
+/*
+------------------------------------------------------------------------------
+~ File   : st7789_frame.h
+~ Author : Majid Derhambakhsh
+~ Version: V1.0.0
+~ Created: 08/25/2023 18:00:00 PM
+~ Brief  : Tearing effect (TE) synchronised frame scheduler
+~ Support:
+           E-Mail : Majid.Derhambakhsh@gmail.com (subject : Embedded Library Support)
+
+           Github : https://github.com/Majid-Derhambakhsh
+------------------------------------------------------------------------------
+~ Description:    The application marks the changed areas with ST7789_Frame_Invalidate,
+                  after each TE pulse ST7789_Frame_Process calls the flush callback
+                  for every dirty area in the scan order of the panel.
+
+                  An area is written ahead of the scan line when the transfer can finish
+                  before the scan line reaches it, otherwise the scheduler waits until the
+                  scan line has passed the area, so the writes never cross the scan line.
+
+~ Attention  :    Connect the TE pin of the LCD to an EXTI pin and call
+                  ST7789_Frame_TE_Callback from the rising edge interrupt:
+
+                  void HAL_GPIO_EXTI_Callback(uint16_t GPIO_Pin)
+                  {
+                      if (GPIO_Pin == LCD_TE_Pin)
+                      {
+                          ST7789_Frame_TE_Callback();
+                      }
+                  }
+
+                  The scan line position is estimated from ST7789_GetMicros, use a time
+                  base with microsecond resolution for best results. Set ST7789_MICROS_TICK
+                  to its resolution, flushes shorter than 8 ticks do not update the rate.
+
+~ Changes    :
+------------------------------------------------------------------------------
+*/
+
+#ifndef __ST7789_FRAME_H_
+#define __ST7789_FRAME_H_
+
+/* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ Include ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+#include "st7789.h"
+
+/* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ Defines ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+#ifndef ST7789_FRAME_MAX_AREAS
+	#define ST7789_FRAME_MAX_AREAS  8
+#endif
+
+#ifndef ST7789_FRAME_PERIOD_US
+	#define ST7789_FRAME_PERIOD_US  16667
+#endif
+
+#ifndef ST7789_FRAME_WAIT
+	#define ST7789_FRAME_WAIT()
+#endif
+
+/* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ Types ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+typedef void (*ST7789_FrameFlushTypeDef)(const ST7789_AreaTypeDef *Area); /* Draws the area */
+
+typedef struct /* Frame Statistics */
+{
+	
+	uint32_t Frames;          // Flushed frames
+	uint32_t MissedDeadlines; // Frames that started too late or did not finish before the next TE pulse
+	uint32_t Waits;           // Areas that waited for the scan line
+	
+	uint32_t FrameTime;       // Time between the last two flushed frames (us)
+	uint32_t FlushTime;       // Duration of the last flush (us)
+	uint32_t TEPeriod;        // Measured period of the TE signal (us)
+	
+}ST7789_FrameStatsTypeDef;
+
+/* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ Prototype ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+/*
+ * Function: ST7789_Frame_Init
+ * ---------------------------
+ * Initialize the frame scheduler and enable the TE output of the LCD
+ *
+ * Param  :
+ *         Flush : Callback that draws one dirty area
+ *
+ * Returns:
+ *         -
+ *
+ * Example:
+ *         void Gauge_Flush(const ST7789_AreaTypeDef *Area) { ... }
+ *
+ *         ST7789_Frame_Init(Gauge_Flush);
+ *         ...
+ *
+ */
+void ST7789_Frame_Init(ST7789_FrameFlushTypeDef Flush);
+
+/*
+ * Function: ST7789_Frame_Invalidate
+ * ---------------------------------
+ * Mark an area to be flushed in the next frame, overlapping areas are merged
+ *
+ * Param  :
+ *         XStart : Start position of the area in the x-axis
+ *         YStart : Start position of the area in the y-axis
+ *         XEnd   : The end position of the area in the x-axis
+ *         YEnd   : The end position of the area in the y-axis
+ *
+ * Returns:
+ *         -
+ *
+ * Example:
+ *         ST7789_Frame_Invalidate(10, 10, 109, 49);
+ *         ...
+ *
+ */
+void ST7789_Frame_Invalidate(uint16_t XStart, uint16_t YStart, uint16_t XEnd, uint16_t YEnd);
+
+/*
+ * Function: ST7789_Frame_TE_Callback
+ * ----------------------------------
+ * Vertical sync, call it from the TE edge interrupt
+ *
+ * Param  :
+ *         -
+ *
+ * Returns:
+ *         -
+ *
+ * Example:
+ *         ST7789_Frame_TE_Callback();
+ *         ...
+ *
+ */
+void ST7789_Frame_TE_Callback(void);
+
+/*
+ * Function: ST7789_Frame_Process
+ * ------------------------------
+ * Flush the dirty areas once per TE pulse, call it from the main loop or the render task
+ *
+ * Param  :
+ *         -
+ *
+ * Returns:
+ *         1 : A frame is flushed
+ *         0 : No new TE pulse or nothing to flush
+ *
+ * Example:
+ *         while (1)
+ *         {
+ *             ST7789_Frame_Process();
+ *         }
+ *
+ */
+uint8_t ST7789_Frame_Process(void);
+
+/*
+ * Function: ST7789_Frame_GetStats
+ * -------------------------------
+ * Get the frame pacing statistics
+ *
+ * Param  :
+ *         Stats : Pointer to the statistics
+ *
+ * Returns:
+ *         -
+ *
+ * Example:
+ *         ST7789_FrameStatsTypeDef stats;
+ *
+ *         ST7789_Frame_GetStats(&stats);
+ *         ...
+ *
+ */
+void ST7789_Frame_GetStats(ST7789_FrameStatsTypeDef *Stats);
+
+/* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ End of the program ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+#endif /* __ST7789_FRAME_H_ */
@@ -0,0 +1,308 @@
+/*
+------------------------------------------------------------------------------
+~ File   : st7789_host.c
+~ Author : Majid Derhambakhsh
+~ Version: V1.0.0
+~ Created: 08/25/2023 18:00:00 PM
+~ Brief  : Host (PC) simulation of the ST7789 hardware interface
+~ Support:
+           E-Mail : Majid.Derhambakhsh@gmail.com (subject : Embedded Library Support)
+
+           Github : https://github.com/Majid-Derhambakhsh
+------------------------------------------------------------------------------
+~ Description:
+
+~ Attention  :    Define ST7789_HOST in the compiler options and link with pthread.
+
+~ Changes    :
+------------------------------------------------------------------------------
+*/
+
+/* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ Include ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+/* clock_gettime and clock_nanosleep are POSIX, not in strict C99 */
+#ifndef _POSIX_C_SOURCE
+	#define _POSIX_C_SOURCE 200809L
+#endif
+
+#include "st7789_frame.h"
+
+#ifdef ST7789_HOST
+
+#include <pthread.h>
+#include <string.h>
+#include <time.h>
+
+/* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ G Variables ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+static volatile uint32_t HostSPIBytes;
+static uint64_t          HostSPIBusFree; // End of the last simulated byte (ns)
+
+ST7789_HostSPIRegTypeDef ST7789_Host_SPIReg;
+
+static uint32_t          HostCacheCleans;
+static uint32_t          HostCacheLines;
+
+static pthread_t         HostTEThread;
+static volatile uint8_t  HostTERunning;
+static uint32_t          HostTEPeriod;
+
+/* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ Function ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+/* ........................... Time ............................ */
+uint32_t ST7789_Host_GetMicros(void)
+{
+	
+	struct timespec now;
+	
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	
+	return (uint32_t)((uint64_t)now.tv_sec * 1000000U + (uint64_t)now.tv_nsec / 1000U);
+	
+}
+
+void ST7789_Host_Delay(uint32_t Delay)
+{
+	
+	struct timespec wait = {Delay / 1000U, (Delay % 1000U) * 1000000L};
+	
+	nanosleep(&wait, NULL);
+	
+}
+
+/* ............................ SPI ............................ */
+static uint64_t ST7789_Host_GetNanos(void)
+{
+	
+	struct timespec now;
+	
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	
+	return (uint64_t)now.tv_sec * 1000000000U + (uint64_t)now.tv_nsec;
+	
+}
+
+static uint64_t ST7789_Host_SPI_ByteTime(void)
+{
+	
+	#if (ST7789_HOST_SPI_CLOCK > 0)
+	
+	return (8U * 1000000000ULL) / ST7789_HOST_SPI_CLOCK;
+	
+	#else
+	
+	return 0;
+	
+	#endif
+	
+}
+
+static void ST7789_Host_SPI_Wait(uint16_t Size)
+{
+	
+	#if (ST7789_HOST_SPI_CLOCK > 0)
+	
+	uint64_t now = ST7789_Host_GetNanos();
+	
+	/* ------- Bus is busy until the last bit is out ------- */
+	HostSPIBusFree  = (HostSPIBusFree > now) ? HostSPIBusFree : now;
+	HostSPIBusFree += (uint64_t)Size * ST7789_Host_SPI_ByteTime();
+	
+	while (ST7789_Host_GetNanos() < HostSPIBusFree) { }
+	
+	#endif
+	
+	HostSPIBytes += Size;
+	
+}
+
+void ST7789_Host_SPI_Transmit(uint8_t *Data, uint16_t Size)
+{
+	
+	(void)Data;
+	
+	ST7789_Host_SPI_Wait(Size);
+	
+}
+
+void ST7789_Host_SPI_Receive(uint8_t *Data, uint16_t Size)
+{
+	
+	memset(Data, 0, Size);
+	
+	ST7789_Host_SPI_Wait(Size);
+	
+}
+
+void ST7789_Host_SPI_TransmitReceive(uint8_t *TxData, uint8_t *RxData, uint16_t Size)
+{
+	
+	(void)TxData;
+	
+	ST7789_Host_SPI_Receive(RxData, Size);
+	
+}
+
+uint32_t ST7789_Host_SPI_GetBytes(void)
+{
+	return HostSPIBytes;
+}
+
+/* ........................... Cache ........................... */
+void ST7789_Host_Cache_Clean(uintptr_t Addr, uint32_t Size)
+{
+	
+	/* The driver passes whole lines, like SCB_CleanDCache_by_Addr needs on older CMSIS */
+	if (((Addr % ST7789_CACHE_LINE) != 0) || ((Size % ST7789_CACHE_LINE) != 0))
+	{
+		return;
+	}
+	
+	HostCacheCleans++;
+	HostCacheLines += Size / ST7789_CACHE_LINE;
+	
+}
+
+uint32_t ST7789_Host_Cache_GetCleans(uint32_t *Lines)
+{
+	
+	if (Lines != NULL)
+	{
+		*Lines = HostCacheLines;
+	}
+	
+	return HostCacheCleans;
+	
+}
+
+/* ....................... SPI Registers ....................... */
+uint32_t ST7789_Host_SPI_LL_GetSR(ST7789_HostSPIRegTypeDef *Reg)
+{
+	
+	uint64_t now = ST7789_Host_GetNanos();
+	
+	/* ----- TXE: Only the shift register is busy ------ */
+	Reg->SR &= ~(ST7789_HOST_SPI_SR_TXE | ST7789_HOST_SPI_SR_BSY);
+	
+	if (HostSPIBusFree <= (now + ST7789_Host_SPI_ByteTime()))
+	{
+		Reg->SR |= ST7789_HOST_SPI_SR_TXE;
+	}
+	
+	if (now < HostSPIBusFree)
+	{
+		Reg->SR |= ST7789_HOST_SPI_SR_BSY;
+	}
+	
+	return Reg->SR;
+	
+}
+
+void ST7789_Host_SPI_LL_Write(ST7789_HostSPIRegTypeDef *Reg, uint8_t Byte)
+{
+	
+	uint64_t now = ST7789_Host_GetNanos();
+	
+	/* ---------------- Check the Access --------------- */
+	if (!(Reg->CR1 & ST7789_HOST_SPI_CR1_SPE) || (HostSPIBusFree > (now + ST7789_Host_SPI_ByteTime())))
+	{
+		Reg->Errors++;
+	}
+	
+	/* The received byte of the last write is not read */
+	if (Reg->SR & ST7789_HOST_SPI_SR_RXNE)
+	{
+		Reg->SR |= ST7789_HOST_SPI_SR_OVR;
+	}
+	
+	/* ------------------- Shift Out ------------------- */
+	Reg->DR  = Byte;
+	Reg->SR |= ST7789_HOST_SPI_SR_RXNE;
+	
+	HostSPIBusFree  = (HostSPIBusFree > now) ? HostSPIBusFree : now;
+	HostSPIBusFree += ST7789_Host_SPI_ByteTime();
+	
+	HostSPIBytes++;
+	
+}
+
+uint8_t ST7789_Host_SPI_LL_Read(ST7789_HostSPIRegTypeDef *Reg)
+{
+	
+	/* Reading DR (and SR) clears RXNE and the overrun */
+	Reg->SR &= ~(ST7789_HOST_SPI_SR_RXNE | ST7789_HOST_SPI_SR_OVR);
+	
+	return (uint8_t)Reg->DR;
+	
+}
+
+/* ............................ TE ............................. */
+static void *ST7789_Host_TE_Thread(void *Arg)
+{
+	
+	struct timespec next;
+	
+	(void)Arg;
+	
+	clock_gettime(CLOCK_MONOTONIC, &next);
+	
+	while (HostTERunning)
+	{
+	
+		/* ~~~~~~~~~~~~~~~~ Wait for the next pulse ~~~~~~~~~~~~~~~~ */
+		next.tv_nsec += (long)HostTEPeriod * 1000L;
+	
+		while (next.tv_nsec >= 1000000000L)
+		{
+			next.tv_nsec -= 1000000000L;
+			next.tv_sec++;
+		}
+	
+		clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &next, NULL);
+	
+		/* ~~~~~~~~~~~~~~~~~~~~~ Vertical sync ~~~~~~~~~~~~~~~~~~~~~ */
+		if (HostTERunning)
+		{
+			ST7789_Frame_TE_Callback();
+		}
+	
+	}
+	
+	return NULL;
+	
+}
+
+uint8_t ST7789_Host_TE_Start(uint32_t Period)
+{
+	
+	if (HostTERunning || (Period == 0))
+	{
+		return 1;
+	}
+	
+	HostTEPeriod  = Period;
+	HostTERunning = 1;
+	
+	if (pthread_create(&HostTEThread, NULL, ST7789_Host_TE_Thread, NULL) != 0)
+	{
+		HostTERunning = 0;
+		return 1;
+	}
+	
+	return 0;
+	
+}
+
+void ST7789_Host_TE_Stop(void)
+{
+	
+	if (!HostTERunning)
+	{
+		return;
+	}
+	
+	HostTERunning = 0;
+	pthread_join(HostTEThread, NULL);
+	
+}
+
+#endif /* ST7789_HOST */
+
+/* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ End of the program ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
@@ -0,0 +1,148 @@
+/*
+------------------------------------------------------------------------------
+~ File   : st7789_host.h
+~ Author : Majid Derhambakhsh
+~ Version: V1.0.0
+~ Created: 08/25/2023 18:00:00 PM
+~ Brief  : Host (PC) simulation of the ST7789 hardware interface
+~ Support:
+           E-Mail : Majid.Derhambakhsh@gmail.com (subject : Embedded Library Support)
+
+           Github : https://github.com/Majid-Derhambakhsh
+------------------------------------------------------------------------------
+~ Description:
+
+~ Attention  :    Define ST7789_HOST in the compiler options and link with pthread.
+                  The SPI functions only count the bytes and wait for the simulated
+                  bus time (ST7789_HOST_SPI_CLOCK).
+
+~ Changes    :
+------------------------------------------------------------------------------
+*/
+
+#ifndef __ST7789_HOST_H_
+#define __ST7789_HOST_H_
+
+/* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ Include ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+#include <stdint.h>
+
+/* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ Defines ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+/* Bits of the emulated SPI registers (Same as STM32 SPI) */
+#define ST7789_HOST_SPI_CR1_SPE  (1U << 6)
+
+#define ST7789_HOST_SPI_SR_RXNE  (1U << 0)
+#define ST7789_HOST_SPI_SR_TXE   (1U << 1)
+#define ST7789_HOST_SPI_SR_OVR   (1U << 6)
+#define ST7789_HOST_SPI_SR_BSY   (1U << 7)
+
+/* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ Types ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+typedef struct /* Emulated SPI Register Block */
+{
+	
+	volatile uint32_t CR1;
+	volatile uint32_t SR;     // Read with ST7789_Host_SPI_LL_GetSR, TXE and BSY follow the simulated bus time
+	volatile uint32_t DR;
+	
+	uint32_t          Errors; // Writes while the SPI is disabled or DR is full
+	
+}ST7789_HostSPIRegTypeDef;
+
+/* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ Variables ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+extern ST7789_HostSPIRegTypeDef ST7789_Host_SPIReg;
+
+/* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ Prototype ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+/* ........................... Time ............................ */
+uint32_t ST7789_Host_GetMicros(void);
+void ST7789_Host_Delay(uint32_t Delay);
+
+/* ............................ SPI ............................ */
+void ST7789_Host_SPI_Transmit(uint8_t *Data, uint16_t Size);
+void ST7789_Host_SPI_Receive(uint8_t *Data, uint16_t Size);
+void ST7789_Host_SPI_TransmitReceive(uint8_t *TxData, uint8_t *RxData, uint16_t Size);
+
+/*
+ * Function: ST7789_Host_SPI_GetBytes
+ * ----------------------------------
+ * Get the number of bytes transmitted on the simulated bus
+ *
+ * Param  :
+ *         -
+ *
+ * Returns:
+ *         Bytes : Transmitted bytes since start-up
+ *
+ * Example:
+ *         uint32_t bytes = ST7789_Host_SPI_GetBytes();
+ *         ...
+ *
+ */
+uint32_t ST7789_Host_SPI_GetBytes(void);
+
+/* ....................... SPI Registers ....................... */
+uint32_t ST7789_Host_SPI_LL_GetSR(ST7789_HostSPIRegTypeDef *Reg);
+void ST7789_Host_SPI_LL_Write(ST7789_HostSPIRegTypeDef *Reg, uint8_t Byte);
+uint8_t ST7789_Host_SPI_LL_Read(ST7789_HostSPIRegTypeDef *Reg);
+
+/* ........................... Cache ........................... */
+void ST7789_Host_Cache_Clean(uintptr_t Addr, uint32_t Size);
+
+/*
+ * Function: ST7789_Host_Cache_GetCleans
+ * -------------------------------------
+ * Get the number of D-cache clean operations of the driver (ST7789_CACHE_CLEAN)
+ *
+ * Param  :
+ *         Lines : Pointer to the number of cleaned cache lines (NULL: Unused)
+ *
+ * Returns:
+ *         Cleans : Clean operations since start-up
+ *
+ * Example:
+ *         uint32_t lines;
+ *         uint32_t cleans = ST7789_Host_Cache_GetCleans(&lines);
+ *         ...
+ *
+ */
+uint32_t ST7789_Host_Cache_GetCleans(uint32_t *Lines);
+
+/* ............................ TE ............................. */
+/*
+ * Function: ST7789_Host_TE_Start
+ * ------------------------------
+ * Start a timer thread that simulates the TE signal of the panel, the thread
+ * calls ST7789_Frame_TE_Callback on each period
+ *
+ * Param  :
+ *         Period : Period of the TE signal (us), e.g. 16667 for 60Hz
+ *
+ * Returns:
+ *         0 : Thread is started
+ *         1 : Thread is already running or could not be created
+ *
+ * Example:
+ *         ST7789_Host_TE_Start(16667);
+ *         ...
+ *
+ */
+uint8_t ST7789_Host_TE_Start(uint32_t Period);
+
+/*
+ * Function: ST7789_Host_TE_Stop
+ * -----------------------------
+ * Stop the simulated TE signal
+ *
+ * Param  :
+ *         -
+ *
+ * Returns:
+ *         -
+ *
+ * Example:
+ *         ST7789_Host_TE_Stop();
+ *         ...
+ *
+ */
+void ST7789_Host_TE_Stop(void);
+
+/* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ End of the program ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+#endif /* __ST7789_HOST_H_ */
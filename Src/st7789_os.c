@@ -0,0 +1,222 @@
+/*
+------------------------------------------------------------------------------
+~ File   : st7789_os.c
+~ Author : Majid Derhambakhsh
+~ Version: V1.0.0
+~ Created: 08/25/2023 18:00:00 PM
+~ Brief  : OS abstraction of the ST7789 driver (mutex, TX complete semaphore, yield)
+~ Support:
+           E-Mail : Majid.Derhambakhsh@gmail.com (subject : Embedded Library Support)
+
+           Github : https://github.com/Majid-Derhambakhsh
+------------------------------------------------------------------------------
+~ Description:
+
+~ Attention  :
+
+~ Changes    :
+------------------------------------------------------------------------------
+*/
+
+/* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ Include ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+/* Recursive mutexes and sem_timedwait are POSIX, not in strict C99 */
+#ifndef _POSIX_C_SOURCE
+	#define _POSIX_C_SOURCE 200809L
+#endif
+
+#include "st7789.h"
+
+#ifdef ST7789_USE_OS
+
+#ifdef ST7789_OS_POSIX
+	#include <errno.h>
+	#include <sched.h>
+	#include <time.h>
+#endif
+
+/* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ Function ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+/* ........................... Mutex ........................... */
+void ST7789_OS_Create(ST7789_OSTypeDef *OS)
+{
+	
+	#if defined(ST7789_OS_FREERTOS)
+	
+	OS->Mutex  = xSemaphoreCreateRecursiveMutex();
+	OS->TxDone = xSemaphoreCreateBinary();
+	
+	#else
+	
+	pthread_mutexattr_t attr;
+	
+	/* Drawing functions call each other, the owner may lock again */
+	pthread_mutexattr_init(&attr);
+	pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_RECURSIVE);
+	pthread_mutex_init(&OS->Mutex, &attr);
+	pthread_mutexattr_destroy(&attr);
+	
+	sem_init(&OS->TxDone, 0, 0);
+	
+	#endif
+	
+	OS->Created = 1;
+	
+}
+
+void ST7789_OS_Lock(ST7789_OSTypeDef *OS)
+{
+	
+	uint32_t waitStart;
+	
+	/* The first call comes before the tasks share the display */
+	if (!OS->Created)
+	{
+		ST7789_OS_Create(OS);
+	}
+	
+	/* ---------------- Try Without Wait ------------ */
+	#if defined(ST7789_OS_FREERTOS)
+	
+	if (xSemaphoreTakeRecursive(OS->Mutex, 0) == pdTRUE)
+	
+	#else
+	
+	if (pthread_mutex_trylock(&OS->Mutex) == 0)
+	
+	#endif
+	{
+	
+		OS->Stats.Locks++;
+		return;
+	
+	}
+	
+	/* ------------- Wait for the Other Task -------- */
+	waitStart = ST7789_GetMicros();
+	
+	#if defined(ST7789_OS_FREERTOS)
+	xSemaphoreTakeRecursive(OS->Mutex, portMAX_DELAY);
+	#else
+	pthread_mutex_lock(&OS->Mutex);
+	#endif
+	
+	OS->Stats.Locks++;
+	OS->Stats.Contentions++;
+	OS->Stats.WaitTime += ST7789_GetMicros() - waitStart;
+	
+}
+
+void ST7789_OS_Unlock(ST7789_OSTypeDef *OS)
+{
+	
+	#if defined(ST7789_OS_FREERTOS)
+	xSemaphoreGiveRecursive(OS->Mutex);
+	#else
+	pthread_mutex_unlock(&OS->Mutex);
+	#endif
+	
+}
+
+/* ......................... Semaphore ......................... */
+uint8_t ST7789_OS_TxWait(ST7789_OSTypeDef *OS, uint32_t Timeout)
+{
+	
+	#if defined(ST7789_OS_POSIX)
+	struct timespec deadline;
+	#endif
+	
+	if (!OS->Created)
+	{
+		return 0;
+	}
+	
+	OS->Stats.TxWaits++;
+	
+	#if defined(ST7789_OS_FREERTOS)
+	
+	return (xSemaphoreTake(OS->TxDone, pdMS_TO_TICKS(Timeout)) == pdTRUE) ? 1 : 0;
+	
+	#else
+	
+	clock_gettime(CLOCK_REALTIME, &deadline);
+	
+	deadline.tv_sec  += Timeout / 1000U;
+	deadline.tv_nsec += (long)(Timeout % 1000U) * 1000000L;
+	
+	if (deadline.tv_nsec >= 1000000000L)
+	{
+		deadline.tv_sec++;
+		deadline.tv_nsec -= 1000000000L;
+	}
+	
+	while (sem_timedwait(&OS->TxDone, &deadline) != 0)
+	{
+	
+		if (errno != EINTR)
+		{
+			return 0;
+		}
+	
+	}
+	
+	return 1;
+	
+	#endif
+	
+}
+
+void ST7789_OS_TxSignal(ST7789_OSTypeDef *OS)
+{
+	
+	#if defined(ST7789_OS_FREERTOS)
+	BaseType_t woken = pdFALSE;
+	#else
+	int        count;
+	#endif
+	
+	if (!OS->Created)
+	{
+		return;
+	}
+	
+	#if defined(ST7789_OS_FREERTOS)
+	
+	/* The SPI TX complete callback runs in the interrupt */
+	if (__get_IPSR() != 0U)
+	{
+	
+		xSemaphoreGiveFromISR(OS->TxDone, &woken);
+		portYIELD_FROM_ISR(woken);
+	
+	}
+	else
+	{
+		xSemaphoreGive(OS->TxDone);
+	}
+	
+	#else
+	
+	/* Binary like FreeRTOS, a signal without a waiting task is kept once */
+	sem_getvalue(&OS->TxDone, &count);
+	
+	if (count == 0)
+	{
+		sem_post(&OS->TxDone);
+	}
+	
+	#endif
+	
+}
+
+/* ........................... Yield ........................... */
+void ST7789_OS_Yield(void)
+{
+	
+	#if defined(ST7789_OS_FREERTOS)
+	taskYIELD();
+	#else
+	sched_yield();
+	#endif
+	
+}
+
+#endif /* ST7789_USE_OS */
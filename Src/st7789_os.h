@@ -0,0 +1,161 @@
+/*
+------------------------------------------------------------------------------
+~ File   : st7789_os.h
+~ Author : Majid Derhambakhsh
+~ Version: V1.0.0
+~ Created: 08/25/2023 18:00:00 PM
+~ Brief  : OS abstraction of the ST7789 driver (mutex, TX complete semaphore, yield)
+~ Support:
+           E-Mail : Majid.Derhambakhsh@gmail.com (subject : Embedded Library Support)
+
+           Github : https://github.com/Majid-Derhambakhsh
+------------------------------------------------------------------------------
+~ Description:    Every ST7789_Disp_xxx call takes the recursive mutex of the display, so
+                  several tasks can draw on the same display. A task that waits for a DMA
+                  transfer blocks on the TX complete semaphore instead of polling the bus.
+
+                  - FreeRTOS      : LCD_USE_FREE_RTOS 1 (HAL, needs configUSE_RECURSIVE_MUTEXES)
+                  - POSIX threads : ST7789_USE_PTHREAD (Always used on the host)
+                  - None          : The hooks are empty
+
+~ Attention  :    Call ST7789_Disp_TxCpltCallback from HAL_SPI_TxCpltCallback to release the
+                  waiting task, otherwise the bus is polled every ST7789_OS_TX_TIMEOUT.
+                  The objects are created by the first call, call ST7789_Init (or
+                  ST7789_AddMemory) before the tasks start drawing.
+
+~ Changes    :
+------------------------------------------------------------------------------
+*/
+
+#ifndef __ST7789_OS_H_
+#define __ST7789_OS_H_
+
+/* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ Include ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+#include <stdint.h>
+
+#include "st7789_conf.h"
+
+/* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ Defines ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+#if defined(USE_HAL_DRIVER) && defined(LCD_USE_FREE_RTOS) && (LCD_USE_FREE_RTOS == 1)
+
+	#define ST7789_USE_OS
+	#define ST7789_OS_FREERTOS
+
+	#include "FreeRTOS.h"
+	#include "semphr.h"
+	#include "task.h"
+
+#elif defined(ST7789_USE_PTHREAD) || defined(ST7789_HOST)
+
+	#define ST7789_USE_OS
+	#define ST7789_OS_POSIX
+
+	#include <pthread.h>
+	#include <semaphore.h>
+
+#endif
+
+#ifndef ST7789_OS_TX_TIMEOUT
+	#define ST7789_OS_TX_TIMEOUT  2 // Wait for the TX complete semaphore before the bus is polled again (ms)
+#endif
+
+/* ................... Macro's .................... */
+#ifdef ST7789_USE_OS
+
+	#define ST7789_OS_LOCK(hlcd)                                             ST7789_OS_Lock(&(hlcd)->OS)
+	#define ST7789_OS_UNLOCK(hlcd)                                           ST7789_OS_Unlock(&(hlcd)->OS)
+	#define ST7789_OS_TX_SIGNAL(hlcd)                                        ST7789_OS_TxSignal(&(hlcd)->OS)
+	#define ST7789_OS_YIELD()                                                ST7789_OS_Yield()
+
+#else
+
+	#define ST7789_OS_LOCK(hlcd)
+	#define ST7789_OS_UNLOCK(hlcd)
+	#define ST7789_OS_TX_SIGNAL(hlcd)
+	#define ST7789_OS_YIELD()
+
+#endif
+
+/* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ Types ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+typedef struct /* Lock Statistics */
+{
+	
+	uint32_t Locks;       // Lock calls (Nested calls included)
+	uint32_t Contentions; // Lock calls that waited for another task
+	uint32_t WaitTime;    // Time waited for other tasks (us, ST7789_GetMicros)
+	uint32_t TxWaits;     // Transfers waited on the TX complete semaphore
+	
+}ST7789_OSStatsTypeDef;
+
+typedef struct /* OS Objects */
+{
+	
+	#if defined(ST7789_OS_FREERTOS)
+	
+	SemaphoreHandle_t Mutex;  // Recursive mutex of the display
+	SemaphoreHandle_t TxDone; // Given by ST7789_Disp_TxCpltCallback
+	
+	#elif defined(ST7789_OS_POSIX)
+	
+	pthread_mutex_t   Mutex;
+	sem_t             TxDone;
+	
+	#endif
+	
+	uint8_t               Created;
+	ST7789_OSStatsTypeDef Stats;
+	
+}ST7789_OSTypeDef;
+
+/* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ Prototype ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+#ifdef ST7789_USE_OS
+
+/* ........................... Mutex ........................... */
+void ST7789_OS_Create(ST7789_OSTypeDef *OS);
+void ST7789_OS_Lock(ST7789_OSTypeDef *OS);
+void ST7789_OS_Unlock(ST7789_OSTypeDef *OS);
+
+/* ......................... Semaphore ......................... */
+/*
+ * Function: ST7789_OS_TxWait
+ * --------------------------
+ * Block the calling task until ST7789_OS_TxSignal or the timeout
+ *
+ * Param  :
+ *         OS      : OS objects of the display
+ *         Timeout : Maximum wait (ms)
+ *
+ * Returns:
+ *         1 : Signaled
+ *         0 : Timeout
+ *
+ * Example:
+ *         -
+ *
+ */
+uint8_t ST7789_OS_TxWait(ST7789_OSTypeDef *OS, uint32_t Timeout);
+
+/*
+ * Function: ST7789_OS_TxSignal
+ * ----------------------------
+ * Release the task in ST7789_OS_TxWait, can be called from an interrupt
+ *
+ * Param  :
+ *         OS : OS objects of the display
+ *
+ * Returns:
+ *         -
+ *
+ * Example:
+ *         -
+ *
+ */
+void ST7789_OS_TxSignal(ST7789_OSTypeDef *OS);
+
+/* ........................... Yield ........................... */
+void ST7789_OS_Yield(void);
+
+#endif /* ST7789_USE_OS */
+
+/* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ End of the program ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+#endif /* __ST7789_OS_H_ */
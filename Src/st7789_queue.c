@@ -0,0 +1,401 @@
+/*
+------------------------------------------------------------------------------
+~ File   : st7789_queue.c
+~ Author : Majid Derhambakhsh
+~ Version: V1.0.0
+~ Created: 08/25/2023 18:00:00 PM
+~ Brief  : Lock-free multi-producer draw command queue
+~ Support:
+           E-Mail : Majid.Derhambakhsh@gmail.com (subject : Embedded Library Support)
+
+           Github : https://github.com/Majid-Derhambakhsh
+------------------------------------------------------------------------------
+~ Description:    Bounded ring with a sequence number per cell: a producer reserves the
+                  cell at Head with a compare and swap, writes the command and publishes
+                  it with the sequence number. The render task is the only consumer.
+
+~ Attention  :
+
+~ Changes    :
+------------------------------------------------------------------------------
+*/
+
+/* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ Include ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+#include "st7789_queue.h"
+
+#ifdef ST7789_ATOMIC_CAS
+
+#if (ST7789_QUEUE_SIZE & (ST7789_QUEUE_SIZE - 1)) != 0
+	#error ST7789_QUEUE_SIZE must be a power of 2
+#endif
+
+/* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ G Struct ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+typedef struct /* Queue Cell */
+{
+	
+	uint32_t                Sequence; // Position + 1: Published, Position + Size: Free for the next round
+	ST7789_QueueItemTypeDef Item;
+	
+}ST7789_QueueCellTypeDef;
+
+/* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ G Variables ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+static ST7789_HandleTypeDef    *QueueDisplay = &ST7789_Display;
+static ST7789_QueueCellTypeDef  QueueCells[ST7789_QUEUE_SIZE];
+static uint32_t                 QueueHead; // Next cell of the producers
+static uint32_t                 QueueTail; // Next cell of the render task
+
+static ST7789_QueueStatsTypeDef QueueStats;
+
+/* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ Function ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+static ST7789_QueueItemTypeDef *ST7789_Queue_Reserve(uint32_t *Position)
+{
+	
+	ST7789_QueueCellTypeDef *cell;
+	uint32_t pos = ST7789_ATOMIC_LOAD(&QueueHead);
+	int32_t  diff;
+	
+	/* ---------------- Claim the Head Cell ---------------- */
+	while (1)
+	{
+	
+		cell = &QueueCells[pos & (ST7789_QUEUE_SIZE - 1)];
+		diff = (int32_t)(ST7789_ATOMIC_LOAD(&cell->Sequence) - pos);
+	
+		if (diff == 0)
+		{
+	
+			/* Another producer may take it first, pos is reloaded on failure */
+			if (ST7789_ATOMIC_CAS(&QueueHead, &pos, pos + 1))
+			{
+				break;
+			}
+	
+		}
+		else if (diff < 0)
+		{
+	
+			/* The render task has not drawn this cell of the last round */
+			ST7789_ATOMIC_ADD(&QueueStats.Dropped, 1);
+			return NULL;
+	
+		}
+		else
+		{
+			pos = ST7789_ATOMIC_LOAD(&QueueHead);
+		}
+	
+	}
+	
+	*Position = pos;
+	
+	return &cell->Item;
+	
+}
+
+static ST7789_StatusTypeDef ST7789_Queue_Publish(uint32_t Position)
+{
+	
+	ST7789_ATOMIC_STORE(&QueueCells[Position & (ST7789_QUEUE_SIZE - 1)].Sequence, Position + 1);
+	ST7789_ATOMIC_ADD(&QueueStats.Pushed, 1);
+	
+	return ST7789_OK;
+	
+}
+
+static ST7789_StatusTypeDef ST7789_Queue_PushArea(ST7789_QueueCmdTypeDef Type, uint16_t X1, uint16_t Y1, uint16_t X2, uint16_t Y2, ST7789_ColorTypeDef Color)
+{
+	
+	uint32_t pos;
+	ST7789_QueueItemTypeDef *item = ST7789_Queue_Reserve(&pos);
+	
+	if (item == NULL)
+	{
+		return ST7789_ERROR;
+	}
+	
+	item->Type  = Type;
+	item->X1    = X1;
+	item->Y1    = Y1;
+	item->X2    = X2;
+	item->Y2    = Y2;
+	item->Color = Color;
+	
+	return ST7789_Queue_Publish(pos);
+	
+}
+
+static uint8_t ST7789_Queue_SameTarget(const ST7789_QueueItemTypeDef *Item, const ST7789_QueueItemTypeDef *Later)
+{
+	
+	if ((Item->Type != Later->Type) || (Item->X1 != Later->X1) || (Item->Y1 != Later->Y1))
+	{
+		return 0;
+	}
+	
+	switch (Item->Type)
+	{
+	
+		case ST7789_QUEUE_FILL:
+		case ST7789_QUEUE_LINE:
+		case ST7789_QUEUE_IMAGE:
+		return (Item->X2 == Later->X2) && (Item->Y2 == Later->Y2);
+	
+		/* The later text covers the same cells with its background */
+		case ST7789_QUEUE_TEXT:
+		return (Item->Font == Later->Font) && (Item->X2 == Later->X2);
+	
+		default:
+		return 0;
+	
+	}
+	
+}
+
+static uint8_t ST7789_Queue_IsSuperseded(uint32_t Position, const ST7789_QueueItemTypeDef *Item)
+{
+	
+	#if (ST7789_QUEUE_COALESCE_DEPTH > 0)
+	
+	const ST7789_QueueCellTypeDef *cell;
+	uint32_t pos;
+	
+	/* --------------- Search the Published Cells --------------- */
+	for (pos = Position + 1; pos <= (Position + ST7789_QUEUE_COALESCE_DEPTH); pos++)
+	{
+	
+		cell = &QueueCells[pos & (ST7789_QUEUE_SIZE - 1)];
+	
+		if ((ST7789_ATOMIC_LOAD(&cell->Sequence) != (pos + 1)) || (cell->Item.Type == ST7789_QUEUE_FLUSH))
+		{
+			break;
+		}
+	
+		if (ST7789_Queue_SameTarget(Item, &cell->Item))
+		{
+			return 1;
+		}
+	
+	}
+	
+	#endif
+	
+	return 0;
+	
+}
+
+static void ST7789_Queue_Draw(const ST7789_QueueItemTypeDef *Item)
+{
+	
+	switch (Item->Type)
+	{
+	
+		case ST7789_QUEUE_FILL:
+		ST7789_Disp_Fill(QueueDisplay, Item->X1, Item->Y1, Item->X2, Item->Y2, Item->Color);
+		break;
+	
+		case ST7789_QUEUE_LINE:
+		ST7789_Disp_DrawLine(QueueDisplay, Item->X1, Item->Y1, Item->X2, Item->Y2, Item->Color);
+		break;
+	
+		case ST7789_QUEUE_TEXT:
+		ST7789_Disp_PutString(QueueDisplay, Item->X1, Item->Y1, Item->Text, *Item->Font, Item->Color, Item->BgColor);
+		break;
+	
+		case ST7789_QUEUE_IMAGE:
+		ST7789_Disp_PutImage(QueueDisplay, Item->X1, Item->Y1, Item->X2, Item->Y2, Item->Image);
+		break;
+	
+		case ST7789_QUEUE_FLUSH:
+	
+		ST7789_Disp_WaitForTransfer(QueueDisplay);
+	
+		if (Item->Done != NULL)
+		{
+			*Item->Done = 1;
+		}
+	
+		break;
+	
+		default:
+		break;
+	
+	}
+	
+}
+
+/* ........................... Setup ........................... */
+void ST7789_Queue_Init(ST7789_HandleTypeDef *hlcd)
+{
+	
+	uint32_t cellCounter;
+	
+	QueueDisplay = (hlcd != NULL) ? hlcd : &ST7789_Display;
+	
+	/* Cell n is free for the position n */
+	for (cellCounter = 0; cellCounter < ST7789_QUEUE_SIZE; cellCounter++)
+	{
+		QueueCells[cellCounter].Sequence = cellCounter;
+	}
+	
+	QueueHead = 0;
+	QueueTail = 0;
+	
+	QueueStats.Pushed    = 0;
+	QueueStats.Dropped   = 0;
+	QueueStats.Drawn     = 0;
+	QueueStats.Coalesced = 0;
+	QueueStats.HighWater = 0;
+	
+}
+
+/* ......................... Producers ......................... */
+ST7789_StatusTypeDef ST7789_Queue_Fill(uint16_t XStart, uint16_t YStart, uint16_t XEnd, uint16_t YEnd, ST7789_ColorTypeDef Color)
+{
+	return ST7789_Queue_PushArea(ST7789_QUEUE_FILL, XStart, YStart, XEnd, YEnd, Color);
+}
+
+ST7789_StatusTypeDef ST7789_Queue_Line(uint16_t XStart, uint16_t YStart, uint16_t XEnd, uint16_t YEnd, ST7789_ColorTypeDef Color)
+{
+	return ST7789_Queue_PushArea(ST7789_QUEUE_LINE, XStart, YStart, XEnd, YEnd, Color);
+}
+
+ST7789_StatusTypeDef ST7789_Queue_Text(uint16_t XPos, uint16_t YPos, const char *Str, const ST7789_FontTypeDef *Font, ST7789_ColorTypeDef Color, ST7789_ColorTypeDef BackgroundColor)
+{
+	
+	uint32_t pos;
+	uint16_t length = 0;
+	ST7789_QueueItemTypeDef *item = ST7789_Queue_Reserve(&pos);
+	
+	if (item == NULL)
+	{
+		return ST7789_ERROR;
+	}
+	
+	/* ----------------- Copy the String ------------------ */
+	while ((Str[length] != '\0') && (length < (ST7789_QUEUE_TEXT_LEN - 1)))
+	{
+		item->Text[length] = Str[length];
+		length++;
+	}
+	
+	item->Text[length] = '\0';
+	
+	item->Type    = ST7789_QUEUE_TEXT;
+	item->X1      = XPos;
+	item->Y1      = YPos;
+	item->X2      = length; // Same length: Same cells
+	item->Font    = Font;
+	item->Color   = Color;
+	item->BgColor = BackgroundColor;
+	
+	return ST7789_Queue_Publish(pos);
+	
+}
+
+ST7789_StatusTypeDef ST7789_Queue_Image(uint16_t XPos, uint16_t YPos, uint16_t Width, uint16_t Height, const uint16_t *Image)
+{
+	
+	uint32_t pos;
+	ST7789_QueueItemTypeDef *item = ST7789_Queue_Reserve(&pos);
+	
+	if (item == NULL)
+	{
+		return ST7789_ERROR;
+	}
+	
+	item->Type  = ST7789_QUEUE_IMAGE;
+	item->X1    = XPos;
+	item->Y1    = YPos;
+	item->X2    = Width;
+	item->Y2    = Height;
+	item->Image = Image;
+	
+	return ST7789_Queue_Publish(pos);
+	
+}
+
+ST7789_StatusTypeDef ST7789_Queue_Flush(volatile uint8_t *Done)
+{
+	
+	uint32_t pos;
+	ST7789_QueueItemTypeDef *item;
+	
+	if (Done != NULL)
+	{
+		*Done = 0;
+	}
+	
+	item = ST7789_Queue_Reserve(&pos);
+	
+	if (item == NULL)
+	{
+		return ST7789_ERROR;
+	}
+	
+	item->Type = ST7789_QUEUE_FLUSH;
+	item->Done = Done;
+	
+	return ST7789_Queue_Publish(pos);
+	
+}
+
+/* ........................ Render Task ........................ */
+uint32_t ST7789_Queue_Process(uint32_t MaxCommands)
+{
+	
+	ST7789_QueueCellTypeDef *cell;
+	uint32_t count = 0;
+	uint32_t depth = ST7789_ATOMIC_LOAD(&QueueHead) - QueueTail;
+	
+	if (depth > QueueStats.HighWater)
+	{
+		QueueStats.HighWater = depth;
+	}
+	
+	/* ------------- Draw the Published Cells ------------- */
+	while ((MaxCommands == 0) || (count < MaxCommands))
+	{
+	
+		cell = &QueueCells[QueueTail & (ST7789_QUEUE_SIZE - 1)];
+	
+		if (ST7789_ATOMIC_LOAD(&cell->Sequence) != (QueueTail + 1))
+		{
+			break;
+		}
+	
+		if (ST7789_Queue_IsSuperseded(QueueTail, &cell->Item))
+		{
+			QueueStats.Coalesced++;
+		}
+		else
+		{
+	
+			ST7789_Queue_Draw(&cell->Item);
+			QueueStats.Drawn++;
+	
+		}
+	
+		/* ~~~~~~~~~~~~~~~ Free the cell for the next round ~~~~~~~~~~~~~~~ */
+		ST7789_ATOMIC_STORE(&cell->Sequence, QueueTail + ST7789_QUEUE_SIZE);
+		QueueTail++;
+	
+		count++;
+	
+	}
+	
+	return count;
+	
+}
+
+void ST7789_Queue_GetStats(ST7789_QueueStatsTypeDef *Stats)
+{
+	
+	Stats->Pushed    = ST7789_ATOMIC_LOAD(&QueueStats.Pushed);
+	Stats->Dropped   = ST7789_ATOMIC_LOAD(&QueueStats.Dropped);
+	Stats->Drawn     = QueueStats.Drawn;
+	Stats->Coalesced = QueueStats.Coalesced;
+	Stats->HighWater = QueueStats.HighWater;
+	
+}
+
+#endif /* ST7789_ATOMIC_CAS */
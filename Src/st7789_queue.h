@@ -0,0 +1,216 @@
+/*
+------------------------------------------------------------------------------
+~ File   : st7789_queue.h
+~ Author : Majid Derhambakhsh
+~ Version: V1.0.0
+~ Created: 08/25/2023 18:00:00 PM
+~ Brief  : Lock-free multi-producer draw command queue
+~ Support:
+           E-Mail : Majid.Derhambakhsh@gmail.com (subject : Embedded Library Support)
+
+           Github : https://github.com/Majid-Derhambakhsh
+------------------------------------------------------------------------------
+~ Description:    Tasks and interrupts put draw commands in a bounded ring with
+                  ST7789_Queue_xxx and return at once, the render task draws them with
+                  ST7789_Queue_Process. The producers reserve a cell with one compare and
+                  swap and never wait for the LCD, a full queue drops the command and
+                  counts it (back-pressure).
+
+                  Coalesce: A fill, line, text or image command is skipped when a later
+                  command in the queue draws the same target again (e.g. a value that is
+                  updated faster than the LCD can show it).
+
+~ Attention  :    The ring uses the atomic built-ins of GCC/Clang (Cortex-M3 and above,
+                  host), define the ST7789_ATOMIC_xxx macros for other cores.
+                  The image of ST7789_Queue_Image is not copied, keep it until the
+                  command is drawn (ST7789_Queue_Flush).
+
+~ Changes    :
+------------------------------------------------------------------------------
+*/
+
+#ifndef __ST7789_QUEUE_H_
+#define __ST7789_QUEUE_H_
+
+/* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ Include ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+#include "st7789.h"
+
+/* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ Defines ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+#ifndef ST7789_QUEUE_SIZE
+	#define ST7789_QUEUE_SIZE            32 // Commands (Power of 2)
+#endif
+
+#ifndef ST7789_QUEUE_TEXT_LEN
+	#define ST7789_QUEUE_TEXT_LEN        24 // Characters of a text command (Longer strings are cut)
+#endif
+
+#ifndef ST7789_QUEUE_COALESCE_DEPTH
+	#define ST7789_QUEUE_COALESCE_DEPTH  8  // Later commands searched for the same target (0: Off)
+#endif
+
+/* ................... Macro's .................... */
+#if !defined(ST7789_ATOMIC_CAS) && defined(__GNUC__) && !defined(__AVR__) && !defined(__ARM_ARCH_6M__)
+
+	#define ST7789_ATOMIC_LOAD(pVar)                                         __atomic_load_n((pVar), __ATOMIC_ACQUIRE)
+	#define ST7789_ATOMIC_STORE(pVar, Value)                                 __atomic_store_n((pVar), (Value), __ATOMIC_RELEASE)
+	#define ST7789_ATOMIC_CAS(pVar, pExpected, Desired)                      __atomic_compare_exchange_n((pVar), (pExpected), (Desired), 1, __ATOMIC_ACQ_REL, __ATOMIC_RELAXED)
+	#define ST7789_ATOMIC_ADD(pVar, Value)                                   __atomic_fetch_add((pVar), (Value), __ATOMIC_RELAXED)
+
+#endif
+
+/* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ Types ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+typedef enum /* Queue Commands */
+{
+	
+	ST7789_QUEUE_FILL  = 0x00, // ST7789_Fill
+	ST7789_QUEUE_LINE  = 0x01, // ST7789_DrawLine
+	ST7789_QUEUE_TEXT  = 0x02, // ST7789_PutString with a copy of the string
+	ST7789_QUEUE_IMAGE = 0x03, // ST7789_PutImage with a reference to the image
+	ST7789_QUEUE_FLUSH = 0x04, // Wait for the transfers and set the done flag
+	
+}ST7789_QueueCmdTypeDef;
+
+typedef struct /* Draw Command */
+{
+	
+	uint8_t                   Type;   // ST7789_QueueCmdTypeDef
+	
+	uint16_t                  X1;     // Fill: Area, Line: Ends, Text: Position, Image: Position and size
+	uint16_t                  Y1;
+	uint16_t                  X2;
+	uint16_t                  Y2;
+	
+	ST7789_ColorTypeDef       Color;
+	ST7789_ColorTypeDef       BgColor;
+	
+	const ST7789_FontTypeDef *Font;
+	const uint16_t           *Image;
+	volatile uint8_t         *Done;   // Flush: Set to 1 when the commands before it are drawn
+	
+	char                      Text[ST7789_QUEUE_TEXT_LEN];
+	
+}ST7789_QueueItemTypeDef;
+
+typedef struct /* Queue Statistics */
+{
+	
+	uint32_t Pushed;    // Commands put in the queue
+	uint32_t Dropped;   // Commands lost because the queue was full
+	uint32_t Drawn;     // Commands drawn by ST7789_Queue_Process
+	uint32_t Coalesced; // Commands skipped because a later command draws the same target
+	uint32_t HighWater; // Most commands waiting at the same time
+	
+}ST7789_QueueStatsTypeDef;
+
+/* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ Prototype ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+#ifdef ST7789_ATOMIC_CAS
+
+/*
+ * Function: ST7789_Queue_Init
+ * ---------------------------
+ * Empty the queue and select the display of the render task
+ *
+ * Param  :
+ *         hlcd : Display handle (NULL: ST7789_Display)
+ *
+ * Returns:
+ *         -
+ *
+ * Example:
+ *         ST7789_Init();
+ *         ST7789_Queue_Init(NULL);
+ *         ...
+ *
+ */
+void ST7789_Queue_Init(ST7789_HandleTypeDef *hlcd);
+
+/*
+ * Function: ST7789_Queue_xxx
+ * --------------------------
+ * Put a draw command in the queue, same parameters as the ST7789_xxx function. Can be called
+ * from any task or interrupt, returns without waiting for the LCD.
+ *
+ * Returns:
+ *         ST7789_OK    : The command is in the queue
+ *         ST7789_ERROR : The queue is full, the command is dropped
+ *
+ * Example:
+ *         ST7789_Queue_Fill(0, 0, 239, 19, ST7789_COLOR_BLACK);
+ *         ST7789_Queue_Text(4, 4, tempString, &Font_7x10, ST7789_COLOR_WHITE, ST7789_COLOR_BLACK);
+ *         ...
+ *
+ */
+ST7789_StatusTypeDef ST7789_Queue_Fill(uint16_t XStart, uint16_t YStart, uint16_t XEnd, uint16_t YEnd, ST7789_ColorTypeDef Color);
+ST7789_StatusTypeDef ST7789_Queue_Line(uint16_t XStart, uint16_t YStart, uint16_t XEnd, uint16_t YEnd, ST7789_ColorTypeDef Color);
+ST7789_StatusTypeDef ST7789_Queue_Text(uint16_t XPos, uint16_t YPos, const char *Str, const ST7789_FontTypeDef *Font, ST7789_ColorTypeDef Color, ST7789_ColorTypeDef BackgroundColor);
+ST7789_StatusTypeDef ST7789_Queue_Image(uint16_t XPos, uint16_t YPos, uint16_t Width, uint16_t Height, const uint16_t *Image);
+
+/*
+ * Function: ST7789_Queue_Flush
+ * ----------------------------
+ * Put a flush command in the queue, the render task waits for the transfers and sets the flag
+ * when the commands before it are drawn (e.g. before the source of an image is changed)
+ *
+ * Param  :
+ *         Done : Flag, cleared here and set to 1 by the render task (NULL: Unused)
+ *
+ * Returns:
+ *         ST7789_OK    : The command is in the queue
+ *         ST7789_ERROR : The queue is full
+ *
+ * Example:
+ *         volatile uint8_t done;
+ *
+ *         ST7789_Queue_Image(0, 40, 64, 64, iconBuffer);
+ *         ST7789_Queue_Flush(&done);
+ *         while (!done) { osDelay(1); }
+ *         ...
+ *
+ */
+ST7789_StatusTypeDef ST7789_Queue_Flush(volatile uint8_t *Done);
+
+/*
+ * Function: ST7789_Queue_Process
+ * ------------------------------
+ * Draw the commands of the queue, call it from the single render task
+ *
+ * Param  :
+ *         MaxCommands : Maximum commands drawn by this call (0: Until the queue is empty)
+ *
+ * Returns:
+ *         Count : Drawn and coalesced commands
+ *
+ * Example:
+ *         while (1)
+ *         {
+ *             ST7789_Queue_Process(0);
+ *             osDelay(1);
+ *         }
+ *
+ */
+uint32_t ST7789_Queue_Process(uint32_t MaxCommands);
+
+/*
+ * Function: ST7789_Queue_GetStats
+ * -------------------------------
+ * Get the statistics of the queue, Dropped and HighWater show the back-pressure of the producers
+ *
+ * Param  :
+ *         Stats : Pointer to the statistics
+ *
+ * Returns:
+ *         -
+ *
+ * Example:
+ *         ST7789_QueueStatsTypeDef stats;
+ *
+ *         ST7789_Queue_GetStats(&stats);
+ *         ...
+ *
+ */
+void ST7789_Queue_GetStats(ST7789_QueueStatsTypeDef *Stats);
+
+#endif /* ST7789_ATOMIC_CAS */
+
+/* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ End of the program ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+#endif /* __ST7789_QUEUE_H_ */
@@ -0,0 +1,577 @@
+/*
+------------------------------------------------------------------------------
+~ File   : st7789_sprite.c
+~ Author : Majid Derhambakhsh
+~ Version: V1.0.0
+~ Created: 08/25/2023 18:00:00 PM
+~ Brief  : Sprite layer compositor with background restore
+~ Support:
+           E-Mail : Majid.Derhambakhsh@gmail.com (subject : Embedded Library Support)
+
+           Github : https://github.com/Majid-Derhambakhsh
+------------------------------------------------------------------------------
+~ Description:
+
+~ Attention  :
+
+~ Changes    :
+------------------------------------------------------------------------------
+*/
+
+/* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ Include ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+#include "st7789_sprite.h"
+
+#include <string.h>
+
+/* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ Defines ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+#define SPRITE_USED     0x01
+#define SPRITE_VISIBLE  0x02
+#define SPRITE_KEYED    0x04
+#define SPRITE_CHANGED  0x08
+#define SPRITE_SHOWN    0x10 // Area holds the position on the LCD
+
+/* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ G Struct ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+typedef struct /* Sprite */
+{
+	
+	const uint16_t    *Image; // Pixels in the ST7789_PutImage format
+	uint16_t           Width;
+	uint16_t           Height;
+	
+	int16_t            X;     // Position of the top left pixel
+	int16_t            Y;
+	uint8_t            Z;
+	uint8_t            Flags;
+	uint16_t           Key;   // Transparent color (Big-endian)
+	
+	ST7789_AreaTypeDef Area;  // Visible part on the LCD since the last update
+	
+}ST7789_SpriteTypeDef;
+
+/* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ G Variables ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+static ST7789_HandleTypeDef       *SpriteDisplay;
+static const ST7789_TileTypeDef   *SpriteBackground;
+
+static ST7789_SpriteTypeDef        SpritePool[ST7789_SPRITE_MAX];
+static uint8_t                     SpriteOrder[ST7789_SPRITE_MAX]; // Shown sprites from the lowest z-order
+static uint8_t                     SpriteOrderCount;
+
+static ST7789_AreaTypeDef          SpriteAreas[ST7789_SPRITE_MAX_AREAS];
+static uint8_t                     SpriteAreaCount;
+
+static ST7789_SpriteStatsTypeDef   SpriteStats;
+
+/* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ Function ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+static uint32_t ST7789_Sprite_GetAreaSize(const ST7789_AreaTypeDef *Area)
+{
+	return (uint32_t)(Area->XEnd - Area->XStart + 1) * (Area->YEnd - Area->YStart + 1);
+}
+
+static void ST7789_Sprite_Union(ST7789_AreaTypeDef *Dest, const ST7789_AreaTypeDef *Area)
+{
+	
+	Dest->XStart = (Area->XStart < Dest->XStart) ? Area->XStart : Dest->XStart;
+	Dest->YStart = (Area->YStart < Dest->YStart) ? Area->YStart : Dest->YStart;
+	Dest->XEnd   = (Area->XEnd > Dest->XEnd) ? Area->XEnd : Dest->XEnd;
+	Dest->YEnd   = (Area->YEnd > Dest->YEnd) ? Area->YEnd : Dest->YEnd;
+	
+}
+
+static void ST7789_Sprite_AddArea(ST7789_AreaTypeDef Area)
+{
+	
+	ST7789_AreaTypeDef merged;
+	
+	uint32_t growth;
+	uint32_t minGrowth = UINT32_MAX;
+	uint8_t  areaCounter;
+	uint8_t  mergeIndex = 0;
+	
+	/* ------- Merge while One Window is Cheaper ------ */
+	areaCounter = 0;
+	
+	while (areaCounter < SpriteAreaCount)
+	{
+		
+		merged = SpriteAreas[areaCounter];
+		ST7789_Sprite_Union(&merged, &Area);
+		
+		if (ST7789_Sprite_GetAreaSize(&merged) <= (ST7789_Sprite_GetAreaSize(&Area) + ST7789_Sprite_GetAreaSize(&SpriteAreas[areaCounter])))
+		{
+			
+			/* The merged area may reach the others, search again */
+			Area = merged;
+			SpriteAreas[areaCounter] = SpriteAreas[--SpriteAreaCount];
+			areaCounter = 0;
+			
+			continue;
+			
+		}
+		
+		areaCounter++;
+		
+	}
+	
+	if (SpriteAreaCount < ST7789_SPRITE_MAX_AREAS)
+	{
+		SpriteAreas[SpriteAreaCount++] = Area;
+		return;
+	}
+	
+	/* ----------- Full: Merge with the Nearest ------- */
+	for (areaCounter = 0; areaCounter < SpriteAreaCount; areaCounter++)
+	{
+		
+		merged = SpriteAreas[areaCounter];
+		ST7789_Sprite_Union(&merged, &Area);
+		
+		growth = ST7789_Sprite_GetAreaSize(&merged) - ST7789_Sprite_GetAreaSize(&SpriteAreas[areaCounter]);
+		
+		if (growth < minGrowth)
+		{
+			minGrowth  = growth;
+			mergeIndex = areaCounter;
+		}
+		
+	}
+	
+	ST7789_Sprite_Union(&SpriteAreas[mergeIndex], &Area);
+	
+}
+
+static uint8_t ST7789_Sprite_GetArea(const ST7789_SpriteTypeDef *Sprite, ST7789_AreaTypeDef *Area)
+{
+	
+	int32_t xStart = Sprite->X;
+	int32_t yStart = Sprite->Y;
+	int32_t xEnd   = xStart + Sprite->Width - 1;
+	int32_t yEnd   = yStart + Sprite->Height - 1;
+	
+	/* ---------- Clip to the Display --------------- */
+	xStart = (xStart < 0) ? 0 : xStart;
+	yStart = (yStart < 0) ? 0 : yStart;
+	xEnd   = (xEnd >= SpriteDisplay->Width) ? (SpriteDisplay->Width - 1) : xEnd;
+	yEnd   = (yEnd >= SpriteDisplay->Height) ? (SpriteDisplay->Height - 1) : yEnd;
+	
+	if ((xStart > xEnd) || (yStart > yEnd))
+	{
+		return 0;
+	}
+	
+	Area->XStart = (uint16_t)xStart;
+	Area->YStart = (uint16_t)yStart;
+	Area->XEnd   = (uint16_t)xEnd;
+	Area->YEnd   = (uint16_t)yEnd;
+	
+	return 1;
+	
+}
+
+static void ST7789_Sprite_Compose(uint16_t *Dest, uint16_t XStart, uint16_t Y, uint16_t Pixels)
+{
+	
+	const ST7789_SpriteTypeDef *sprite;
+	const uint16_t             *src;
+	const uint16_t             *tileRow;
+	uint16_t                   *dest;
+	
+	uint16_t tileColumn;
+	uint16_t xStart;
+	uint16_t xEnd;
+	uint16_t count;
+	uint8_t  orderCounter;
+	
+	/* ------------------ Background ---------------- */
+	if (SpriteBackground != NULL)
+	{
+		
+		tileRow    = &SpriteBackground->Data[(uint32_t)(Y % SpriteBackground->Height) * SpriteBackground->Width];
+		tileColumn = XStart % SpriteBackground->Width;
+		
+		for (count = 0; count < Pixels; count++)
+		{
+			
+			Dest[count] = tileRow[tileColumn];
+			
+			if (++tileColumn == SpriteBackground->Width)
+			{
+				tileColumn = 0;
+			}
+			
+		}
+		
+	}
+	else
+	{
+		memset(Dest, 0, Pixels * sizeof(uint16_t));
+	}
+	
+	/* --------- Sprites from the Lowest Z ---------- */
+	for (orderCounter = 0; orderCounter < SpriteOrderCount; orderCounter++)
+	{
+		
+		sprite = &SpritePool[SpriteOrder[orderCounter]];
+		
+		if ((Y < sprite->Area.YStart) || (Y > sprite->Area.YEnd))
+		{
+			continue;
+		}
+		
+		xStart = (XStart > sprite->Area.XStart) ? XStart : sprite->Area.XStart;
+		xEnd   = ((XStart + Pixels - 1) < sprite->Area.XEnd) ? (XStart + Pixels - 1) : sprite->Area.XEnd;
+		
+		if (xStart > xEnd)
+		{
+			continue;
+		}
+		
+		src   = &sprite->Image[(uint32_t)(Y - sprite->Y) * sprite->Width + (xStart - sprite->X)];
+		dest  = &Dest[xStart - XStart];
+		count = xEnd - xStart + 1;
+		
+		if (sprite->Flags & SPRITE_KEYED)
+		{
+			
+			while (count--)
+			{
+				
+				if (*src != sprite->Key)
+				{
+					*dest = *src;
+				}
+				
+				src++;
+				dest++;
+				
+			}
+			
+		}
+		else
+		{
+			memcpy(dest, src, count * sizeof(uint16_t));
+		}
+		
+	}
+	
+}
+
+static void ST7789_Sprite_DrawArea(const ST7789_AreaTypeDef *Area, uint16_t *Band[2], uint32_t BandLength)
+{
+	
+	uint8_t  band = 0;
+	uint16_t x    = Area->XStart;
+	uint16_t y    = Area->YStart;
+	uint32_t filled;
+	uint32_t count;
+	
+	ST7789_Disp_SetWindowAddress(SpriteDisplay, Area->XStart, Area->YStart, Area->XEnd, Area->YEnd);
+	
+	/* --- Compose a Band while the Other is Sent --- */
+	while (y <= Area->YEnd)
+	{
+		
+		for (filled = 0; (filled < BandLength) && (y <= Area->YEnd); filled += count)
+		{
+			
+			count = (uint32_t)(Area->XEnd - x + 1);
+			count = (count < (BandLength - filled)) ? count : (BandLength - filled);
+			
+			ST7789_Sprite_Compose(&Band[band][filled], x, y, (uint16_t)count);
+			
+			x += (uint16_t)count;
+			
+			if (x > Area->XEnd)
+			{
+				x = Area->XStart;
+				y++;
+			}
+			
+		}
+		
+		ST7789_Disp_WritePixels(SpriteDisplay, Band[band], filled);
+		
+		/* One band: The next pass writes the same memory */
+		if (Band[0] == Band[1])
+		{
+			ST7789_Disp_WaitForTransfer(SpriteDisplay);
+		}
+		
+		band ^= 1;
+		
+	}
+	
+}
+
+void ST7789_Sprite_Init(ST7789_HandleTypeDef *hlcd, const ST7789_TileTypeDef *Background)
+{
+	
+	SpriteDisplay    = (hlcd != NULL) ? hlcd : &ST7789_Display;
+	SpriteBackground = ((Background != NULL) && (Background->Width > 0) && (Background->Height > 0)) ? Background : NULL;
+	
+	memset(SpritePool, 0, sizeof(SpritePool));
+	memset(&SpriteStats, 0, sizeof(SpriteStats));
+	
+	SpriteOrderCount = 0;
+	SpriteAreaCount  = 0;
+	
+}
+
+uint8_t ST7789_Sprite_Create(const uint16_t *Image, uint16_t Width, uint16_t Height, uint8_t Z)
+{
+	
+	uint8_t id;
+	
+	if ((Image == NULL) || (Width == 0) || (Height == 0))
+	{
+		return ST7789_SPRITE_NONE;
+	}
+	
+	/* ---------------- Free Sprite ----------------- */
+	for (id = 0; id < ST7789_SPRITE_MAX; id++)
+	{
+		
+		if (!(SpritePool[id].Flags & SPRITE_USED))
+		{
+			
+			memset(&SpritePool[id], 0, sizeof(SpritePool[id]));
+			
+			SpritePool[id].Image  = Image;
+			SpritePool[id].Width  = Width;
+			SpritePool[id].Height = Height;
+			SpritePool[id].Z      = Z;
+			SpritePool[id].Flags  = SPRITE_USED;
+			
+			return id;
+			
+		}
+		
+	}
+	
+	return ST7789_SPRITE_NONE;
+	
+}
+
+void ST7789_Sprite_Delete(uint8_t Id)
+{
+	
+	if ((Id >= ST7789_SPRITE_MAX) || !(SpritePool[Id].Flags & SPRITE_USED))
+	{
+		return;
+	}
+	
+	/* The area is restored by the next update */
+	if (SpritePool[Id].Flags & SPRITE_SHOWN)
+	{
+		ST7789_Sprite_AddArea(SpritePool[Id].Area);
+	}
+	
+	SpritePool[Id].Flags = 0;
+	
+}
+
+void ST7789_Sprite_Move(uint8_t Id, int16_t X, int16_t Y)
+{
+	
+	if ((Id >= ST7789_SPRITE_MAX) || ((SpritePool[Id].X == X) && (SpritePool[Id].Y == Y)))
+	{
+		return;
+	}
+	
+	SpritePool[Id].X      = X;
+	SpritePool[Id].Y      = Y;
+	SpritePool[Id].Flags |= SPRITE_CHANGED;
+	
+}
+
+void ST7789_Sprite_Show(uint8_t Id, uint8_t Visible)
+{
+	
+	if (Id >= ST7789_SPRITE_MAX)
+	{
+		return;
+	}
+	
+	SpritePool[Id].Flags = Visible ? (SpritePool[Id].Flags | SPRITE_VISIBLE) : (SpritePool[Id].Flags & ~SPRITE_VISIBLE);
+	SpritePool[Id].Flags |= SPRITE_CHANGED;
+	
+}
+
+void ST7789_Sprite_SetImage(uint8_t Id, const uint16_t *Image)
+{
+	
+	if ((Id >= ST7789_SPRITE_MAX) || (Image == NULL) || (SpritePool[Id].Image == Image))
+	{
+		return;
+	}
+	
+	SpritePool[Id].Image  = Image;
+	SpritePool[Id].Flags |= SPRITE_CHANGED;
+	
+}
+
+void ST7789_Sprite_SetZ(uint8_t Id, uint8_t Z)
+{
+	
+	if ((Id >= ST7789_SPRITE_MAX) || (SpritePool[Id].Z == Z))
+	{
+		return;
+	}
+	
+	SpritePool[Id].Z      = Z;
+	SpritePool[Id].Flags |= SPRITE_CHANGED;
+	
+}
+
+void ST7789_Sprite_SetKey(uint8_t Id, ST7789_ColorTypeDef Key, uint8_t Enable)
+{
+	
+	if (Id >= ST7789_SPRITE_MAX)
+	{
+		return;
+	}
+	
+	SpritePool[Id].Key    = (uint16_t)((Key >> 8) | ((Key & 0xFF) << 8)); // Big-endian like the image
+	SpritePool[Id].Flags  = Enable ? (SpritePool[Id].Flags | SPRITE_KEYED) : (SpritePool[Id].Flags & ~SPRITE_KEYED);
+	SpritePool[Id].Flags |= SPRITE_CHANGED;
+	
+}
+
+void ST7789_Sprite_Invalidate(uint16_t XStart, uint16_t YStart, uint16_t XEnd, uint16_t YEnd)
+{
+	
+	ST7789_AreaTypeDef area;
+	
+	if ((SpriteDisplay == NULL) || (XStart > XEnd) || (YStart > YEnd) || (XStart >= SpriteDisplay->Width) || (YStart >= SpriteDisplay->Height))
+	{
+		return;
+	}
+	
+	area.XStart = XStart;
+	area.YStart = YStart;
+	area.XEnd   = (XEnd >= SpriteDisplay->Width) ? (SpriteDisplay->Width - 1) : XEnd;
+	area.YEnd   = (YEnd >= SpriteDisplay->Height) ? (SpriteDisplay->Height - 1) : YEnd;
+	
+	ST7789_Sprite_AddArea(area);
+	
+}
+
+uint8_t ST7789_Sprite_Update(void)
+{
+	
+	ST7789_SpriteTypeDef *sprite;
+	
+	uint16_t  chunkBuff[ST7789_SPRITE_CHUNK];
+	uint16_t *band[2];
+	uint32_t  bandLength;
+	uint8_t   id;
+	uint8_t   orderCounter;
+	uint8_t   areaCounter;
+	uint8_t   areas;
+	
+	if (SpriteDisplay == NULL)
+	{
+		return 0;
+	}
+	
+	/* ------- Old and New Area of Changed Sprites ------- */
+	for (id = 0; id < ST7789_SPRITE_MAX; id++)
+	{
+		
+		sprite = &SpritePool[id];
+		
+		if ((sprite->Flags & (SPRITE_USED | SPRITE_CHANGED)) != (SPRITE_USED | SPRITE_CHANGED))
+		{
+			continue;
+		}
+		
+		if (sprite->Flags & SPRITE_SHOWN)
+		{
+			ST7789_Sprite_AddArea(sprite->Area);
+		}
+		
+		sprite->Flags &= ~(SPRITE_CHANGED | SPRITE_SHOWN);
+		
+		if ((sprite->Flags & SPRITE_VISIBLE) && ST7789_Sprite_GetArea(sprite, &sprite->Area))
+		{
+			
+			sprite->Flags |= SPRITE_SHOWN;
+			ST7789_Sprite_AddArea(sprite->Area);
+			
+		}
+		
+	}
+	
+	if (SpriteAreaCount == 0)
+	{
+		return 0;
+	}
+	
+	/* ------------ Z-order (Insertion Sort) -------- */
+	SpriteOrderCount = 0;
+	
+	for (id = 0; id < ST7789_SPRITE_MAX; id++)
+	{
+		
+		if (!(SpritePool[id].Flags & SPRITE_SHOWN))
+		{
+			continue;
+		}
+		
+		for (orderCounter = SpriteOrderCount; (orderCounter > 0) && (SpritePool[SpriteOrder[orderCounter - 1]].Z > SpritePool[id].Z); orderCounter--)
+		{
+			SpriteOrder[orderCounter] = SpriteOrder[orderCounter - 1];
+		}
+		
+		SpriteOrder[orderCounter] = id;
+		SpriteOrderCount++;
+		
+	}
+	
+	ST7789_OS_LOCK(SpriteDisplay);
+	
+	/* The buffer may still be sent by the last transfer */
+	ST7789_Disp_WaitForTransfer(SpriteDisplay);
+	
+	/* ------ Two Bands in the LCD Buffer, or One on the Stack ------ */
+	bandLength = (SpriteDisplay->Buffer != NULL) ? (SpriteDisplay->BufferLength / 2) : 0;
+	
+	if (bandLength > 0)
+	{
+		band[0] = SpriteDisplay->Buffer;
+		band[1] = SpriteDisplay->Buffer + bandLength;
+	}
+	else
+	{
+		band[0]    = chunkBuff;
+		band[1]    = chunkBuff;
+		bandLength = ST7789_SPRITE_CHUNK;
+	}
+	
+	/* ------------------ Draw Areas ---------------- */
+	for (areaCounter = 0; areaCounter < SpriteAreaCount; areaCounter++)
+	{
+		
+		ST7789_Sprite_DrawArea(&SpriteAreas[areaCounter], band, bandLength);
+		
+		SpriteStats.Pixels += ST7789_Sprite_GetAreaSize(&SpriteAreas[areaCounter]);
+		
+	}
+	
+	ST7789_OS_UNLOCK(SpriteDisplay);
+	
+	areas           = SpriteAreaCount;
+	SpriteAreaCount = 0;
+	
+	SpriteStats.Updates++;
+	SpriteStats.Windows += areas;
+	
+	return areas;
+	
+}
+
+void ST7789_Sprite_GetStats(ST7789_SpriteStatsTypeDef *Stats)
+{
+	*Stats = SpriteStats;
+}
+
+/* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ End of the program ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
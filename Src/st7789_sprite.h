@@ -0,0 +1,195 @@
+/*
+------------------------------------------------------------------------------
+~ File   : st7789_sprite.h
+~ Author : Majid Derhambakhsh
+~ Version: V1.0.0
+~ Created: 08/25/2023 18:00:00 PM
+~ Brief  : Sprite layer compositor with background restore
+~ Support:
+           E-Mail : Majid.Derhambakhsh@gmail.com (subject : Embedded Library Support)
+
+           Github : https://github.com/Majid-Derhambakhsh
+------------------------------------------------------------------------------
+~ Description:    Markers and cursors are sprites of a fixed pool with a position, a
+                  z-order, an image and a visibility. ST7789_Sprite_Update merges the old
+                  and the new area of every changed sprite and draws each area in one
+                  window: the background tile and the sprites over it are composed band
+                  by band in the LCD buffer, so nothing is erased and nothing flickers.
+
+                  A small move is one window of the union of both areas, a far move is
+                  two windows of the sprite size.
+
+~ Attention  :    The images are not copied, keep them while the sprite uses them.
+                  Draw the background (or ST7789_Sprite_Invalidate the full display) once,
+                  ST7789_Sprite_Update only draws the changed areas.
+
+~ Changes    :
+------------------------------------------------------------------------------
+*/
+
+#ifndef __ST7789_SPRITE_H_
+#define __ST7789_SPRITE_H_
+
+/* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ Include ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+#include "st7789.h"
+
+/* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ Defines ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+#ifndef ST7789_SPRITE_MAX
+	#define ST7789_SPRITE_MAX        8  // Sprites of the pool
+#endif
+
+#ifndef ST7789_SPRITE_MAX_AREAS
+	#define ST7789_SPRITE_MAX_AREAS  8  // Dirty areas of one update (Extra areas are merged)
+#endif
+
+#ifndef ST7789_SPRITE_CHUNK
+	#define ST7789_SPRITE_CHUNK      32 // Pixels composed per pass without the LCD Buffer
+#endif
+
+#define ST7789_SPRITE_NONE           0xFF // No free sprite
+
+/* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ Types ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+typedef struct /* Sprite Statistics */
+{
+	
+	uint32_t Updates; // ST7789_Sprite_Update calls that drew an area
+	uint32_t Windows; // Drawn areas
+	uint32_t Pixels;  // Drawn pixels
+	
+}ST7789_SpriteStatsTypeDef;
+
+/* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ Prototype ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+/*
+ * Function: ST7789_Sprite_Init
+ * ----------------------------
+ * Remove all sprites and set the background behind them
+ *
+ * Param  :
+ *         hlcd       : Display handle (NULL: ST7789_Display)
+ *         Background : Tile repeated from the top left corner, e.g. a full screen image (NULL: Black)
+ *
+ * Returns:
+ *         -
+ *
+ * Example:
+ *         ST7789_TileTypeDef dial = {dialImage, 240, 280};
+ *
+ *         ST7789_Sprite_Init(NULL, &dial);
+ *         ...
+ *
+ */
+void ST7789_Sprite_Init(ST7789_HandleTypeDef *hlcd, const ST7789_TileTypeDef *Background);
+
+/*
+ * Function: ST7789_Sprite_Create
+ * ------------------------------
+ * Take a sprite of the pool, it is hidden until ST7789_Sprite_Show
+ *
+ * Param  :
+ *         Image  : Pixels in the ST7789_PutImage format
+ *         Width  : Width of the image
+ *         Height : Height of the image
+ *         Z      : Z-order, higher sprites are drawn over lower ones
+ *
+ * Returns:
+ *         Id of the sprite (ST7789_SPRITE_NONE: The pool is full)
+ *
+ * Example:
+ *         uint8_t needle = ST7789_Sprite_Create(needleImage, 16, 16, 1);
+ *
+ *         ST7789_Sprite_Move(needle, 100, 40);
+ *         ST7789_Sprite_Show(needle, 1);
+ *         ST7789_Sprite_Update();
+ *         ...
+ *
+ */
+uint8_t ST7789_Sprite_Create(const uint16_t *Image, uint16_t Width, uint16_t Height, uint8_t Z);
+
+/*
+ * Function: ST7789_Sprite_xxx
+ * ---------------------------
+ * Change a sprite, the LCD is updated by the next ST7789_Sprite_Update
+ *
+ *         Delete   : Hide the sprite and return it to the pool
+ *         Move     : Position of the top left pixel, may be partly outside the display
+ *         Show     : 1: Visible, 0: Hidden
+ *         SetImage : New image of the same size (e.g. the next animation frame)
+ *         SetZ     : New z-order
+ *         SetKey   : Pixels of this color are transparent (Enable 0: Opaque sprite)
+ *
+ * Example:
+ *         ST7789_Sprite_SetKey(cursor, ST7789_COLOR_MAGENTA, 1);
+ *         ST7789_Sprite_Move(cursor, x, y);
+ *         ...
+ *
+ */
+void ST7789_Sprite_Delete(uint8_t Id);
+void ST7789_Sprite_Move(uint8_t Id, int16_t X, int16_t Y);
+void ST7789_Sprite_Show(uint8_t Id, uint8_t Visible);
+void ST7789_Sprite_SetImage(uint8_t Id, const uint16_t *Image);
+void ST7789_Sprite_SetZ(uint8_t Id, uint8_t Z);
+void ST7789_Sprite_SetKey(uint8_t Id, ST7789_ColorTypeDef Key, uint8_t Enable);
+
+/*
+ * Function: ST7789_Sprite_Invalidate
+ * ----------------------------------
+ * Draw an area again in the next update (e.g. after the background is changed)
+ *
+ * Param  :
+ *         XStart : Start position of the area in the x-axis
+ *         YStart : Start position of the area in the y-axis
+ *         XEnd   : The end position of the area in the x-axis
+ *         YEnd   : The end position of the area in the y-axis
+ *
+ * Returns:
+ *         -
+ *
+ * Example:
+ *         ST7789_Sprite_Invalidate(0, 0, 239, 279);
+ *         ST7789_Sprite_Update();
+ *         ...
+ *
+ */
+void ST7789_Sprite_Invalidate(uint16_t XStart, uint16_t YStart, uint16_t XEnd, uint16_t YEnd);
+
+/*
+ * Function: ST7789_Sprite_Update
+ * ------------------------------
+ * Draw the areas of the changed sprites from the background and the sprites over it
+ *
+ * Param  :
+ *         -
+ *
+ * Returns:
+ *         Count : Drawn areas (windows)
+ *
+ * Example:
+ *         ST7789_Sprite_Move(needle, x, y);
+ *         ST7789_Sprite_Update();
+ *         ...
+ *
+ */
+uint8_t ST7789_Sprite_Update(void);
+
+/*
+ * Function: ST7789_Sprite_GetStats
+ * --------------------------------
+ * Get the statistics of the compositor
+ *
+ * Param  :
+ *         Stats : Pointer to the statistics
+ *
+ * Returns:
+ *         -
+ *
+ * Example:
+ *         ST7789_SpriteStatsTypeDef stats;
+ *
+ *         ST7789_Sprite_GetStats(&stats);
+ *         ...
+ *
+ */
+void ST7789_Sprite_GetStats(ST7789_SpriteStatsTypeDef *Stats);
+
+/* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ End of the program ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+#endif /* __ST7789_SPRITE_H_ */
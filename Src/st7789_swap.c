@@ -0,0 +1,228 @@
+/*
+------------------------------------------------------------------------------
+~ File   : st7789_swap.c
+~ Author : Majid Derhambakhsh
+~ Version: V1.0.0
+~ Created: 08/25/2023 18:00:00 PM
+~ Brief  : Double-buffered full-frame rendering (swap chain)
+~ Support:
+           E-Mail : Majid.Derhambakhsh@gmail.com (subject : Embedded Library Support)
+
+           Github : https://github.com/Majid-Derhambakhsh
+------------------------------------------------------------------------------
+~ Description:
+
+~ Attention  :
+
+~ Changes    :
+------------------------------------------------------------------------------
+*/
+
+/* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ Include ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+#include "st7789_swap.h"
+
+#include <string.h>
+
+/* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ G Variables ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+static ST7789_HandleTypeDef  *SwapPanel;
+static ST7789_HandleTypeDef   SwapRender;
+static ST7789_RAMBusTypeDef   SwapBus;
+
+static uint16_t              *SwapFrames[2];
+static uint8_t                SwapBack;
+static ST7789_SwapModeTypeDef SwapMode;
+
+static volatile uint8_t       SwapTxPending; // The transfer of the front buffer is running
+static volatile uint32_t      SwapTxEnd;
+static uint32_t               SwapTxStart;
+static uint32_t               SwapRenderStart;
+static uint32_t               SwapLastPresent;
+
+static ST7789_SwapStatsTypeDef SwapStats;
+
+/* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ Function ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+static void ST7789_Swap_TxCplt(ST7789_HandleTypeDef *hlcd)
+{
+	
+	(void)hlcd;
+	
+	/* ---------- End of the Front Buffer ----------- */
+	if (SwapTxPending)
+	{
+		SwapTxEnd     = ST7789_GetMicros();
+		SwapTxPending = 0;
+	}
+	
+}
+
+static void ST7789_Swap_UpdateStats(uint32_t PresentTime)
+{
+	
+	uint32_t overlapEnd;
+	
+	SwapStats.RenderTime   = PresentTime - SwapRenderStart;
+	SwapStats.TransferTime = SwapTxEnd - SwapTxStart;
+	
+	/* ---- Transfer Time Hidden by the Drawing ----- */
+	overlapEnd = ((int32_t)(SwapTxEnd - PresentTime) < 0) ? SwapTxEnd : PresentTime;
+	
+	if ((SwapStats.TransferTime == 0) || ((int32_t)(overlapEnd - SwapRenderStart) <= 0))
+	{
+		SwapStats.Overlap = 0;
+	}
+	else
+	{
+		SwapStats.Overlap = (uint8_t)(((uint64_t)(overlapEnd - SwapRenderStart) * 100U) / SwapStats.TransferTime);
+	}
+	
+}
+
+ST7789_HandleTypeDef *ST7789_Swap_Init(ST7789_HandleTypeDef *hlcd, uint16_t *Frame0, uint16_t *Frame1, ST7789_SwapModeTypeDef Mode)
+{
+	
+	if (hlcd == NULL)
+	{
+		hlcd = &ST7789_Display;
+	}
+	
+	if ((Frame0 == NULL) || (Frame1 == NULL))
+	{
+		return NULL;
+	}
+	
+	ST7789_Disp_WaitForTransfer(hlcd);
+	
+	SwapPanel     = hlcd;
+	SwapFrames[0] = Frame0;
+	SwapFrames[1] = Frame1;
+	SwapBack      = 0;
+	SwapMode      = Mode;
+	SwapTxPending = 0;
+	
+	/* ------ Render Handle with the Display Geometry ------ */
+	memset(&SwapBus, 0, sizeof(SwapBus));
+	memset(&SwapRender, 0, sizeof(SwapRender));
+	
+	SwapBus.Pixels  = Frame0;
+	
+	SwapRender.Bus         = &ST7789_Bus_RAM;
+	SwapRender.BusContext  = &SwapBus;
+	SwapRender.PanelWidth  = hlcd->PanelWidth;
+	SwapRender.PanelHeight = hlcd->PanelHeight;
+	
+	ST7789_Disp_SetRotation(&SwapRender, hlcd->Rotation);
+	
+	SwapBus.Width  = SwapRender.Width;
+	SwapBus.Height = SwapRender.Height;
+	
+	/* ------------------ Statistics ---------------- */
+	memset(&SwapStats, 0, sizeof(SwapStats));
+	
+	SwapRenderStart = ST7789_GetMicros();
+	SwapLastPresent = SwapRenderStart;
+	SwapTxStart     = SwapRenderStart;
+	SwapTxEnd       = SwapRenderStart;
+	
+	hlcd->TxCpltHook = ST7789_Swap_TxCplt;
+	
+	return &SwapRender;
+	
+}
+
+void ST7789_Swap_Present(void)
+{
+	
+	uint16_t *sent;
+	uint16_t *next;
+	uint32_t  presentTime = ST7789_GetMicros();
+	uint32_t  yStart;
+	uint32_t  rows;
+	uint32_t  row;
+	uint32_t  rowBytes;
+	
+	if (SwapPanel == NULL)
+	{
+		return;
+	}
+	
+	/* ------- The Front Buffer becomes the Back Buffer ------- */
+	ST7789_Disp_WaitForTransfer(SwapPanel);
+	
+	/* Synchronous bus or no TX complete callback since the last present */
+	if (SwapTxPending)
+	{
+		SwapTxEnd     = ST7789_GetMicros();
+		SwapTxPending = 0;
+	}
+	
+	SwapStats.WaitTime  = ST7789_GetMicros() - presentTime;
+	SwapStats.FrameTime = presentTime - SwapLastPresent;
+	SwapLastPresent     = presentTime;
+	
+	ST7789_Swap_UpdateStats(presentTime);
+	
+	/* --------------- Nothing is Drawn ------------- */
+	if (!SwapBus.DirtyValid)
+	{
+		
+		SwapStats.Skipped++;
+		SwapStats.SentRows = 0;
+		SwapRenderStart    = ST7789_GetMicros();
+		
+		return;
+		
+	}
+	
+	/* ----------- Rows to Send (Contiguous) -------- */
+	if (SwapMode == ST7789_SWAP_DIRTY)
+	{
+		yStart = SwapBus.Dirty.YStart;
+		rows   = SwapBus.Dirty.YEnd - SwapBus.Dirty.YStart + 1U;
+	}
+	else
+	{
+		yStart = 0;
+		rows   = SwapBus.Height;
+	}
+	
+	sent = SwapFrames[SwapBack];
+	next = SwapFrames[SwapBack ^ 1];
+	
+	/* ------------ Start the Transfer -------------- */
+	SwapTxStart   = ST7789_GetMicros();
+	SwapTxPending = 1;
+	
+	ST7789_Disp_PutImage(SwapPanel, 0, (uint16_t)yStart, SwapBus.Width, (uint16_t)rows, &sent[yStart * SwapBus.Width]);
+	
+	if (!SwapPanel->TxBusy)
+	{
+		ST7789_Swap_TxCplt(SwapPanel);
+	}
+	
+	/* ---------------- Swap Buffers ---------------- */
+	SwapBack       = SwapBack ^ 1;
+	SwapBus.Pixels = next;
+	
+	/* Copy the new pixels to the frame before, the DMA reads the same source */
+	rowBytes = (SwapBus.Dirty.XEnd - SwapBus.Dirty.XStart + 1U) * sizeof(uint16_t);
+	
+	for (row = SwapBus.Dirty.YStart; row <= SwapBus.Dirty.YEnd; row++)
+	{
+		memcpy(&next[row * SwapBus.Width + SwapBus.Dirty.XStart], &sent[row * SwapBus.Width + SwapBus.Dirty.XStart], rowBytes);
+	}
+	
+	SwapBus.DirtyValid = 0;
+	
+	SwapStats.Frames++;
+	SwapStats.SentRows = rows;
+	
+	SwapRenderStart = ST7789_GetMicros();
+	
+}
+
+void ST7789_Swap_GetStats(ST7789_SwapStatsTypeDef *Stats)
+{
+	*Stats = SwapStats;
+}
+
+/* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ End of the program ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
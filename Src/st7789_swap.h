@@ -0,0 +1,141 @@
+/*
+------------------------------------------------------------------------------
+~ File   : st7789_swap.h
+~ Author : Majid Derhambakhsh
+~ Version: V1.0.0
+~ Created: 08/25/2023 18:00:00 PM
+~ Brief  : Double-buffered full-frame rendering (swap chain)
+~ Support:
+           E-Mail : Majid.Derhambakhsh@gmail.com (subject : Embedded Library Support)
+
+           Github : https://github.com/Majid-Derhambakhsh
+------------------------------------------------------------------------------
+~ Description:    The application draws the next frame with the ST7789_Disp_xxx functions on
+                  the render handle of ST7789_Swap_Init, its bus (ST7789_Bus_RAM) writes the
+                  pixels to the back buffer. ST7789_Swap_Present starts the DMA transfer of
+                  the finished frame and swaps the buffers, so the next frame is drawn while
+                  the last one is sent to the LCD.
+
+                  ST7789_SWAP_DIRTY: Only the rows written since the last present are sent.
+                  The other buffer still holds the frame before, so the area of the sent
+                  frame is copied to it at the swap (the union of the dirty areas of the
+                  two frames is up to date in the back buffer).
+
+~ Attention  :    Two frames of Width x Height pixels are needed (e.g. 2 x 131KB for
+                  240x280), keep them out of the DTCM if it is not reachable by the DMA.
+                  Call ST7789_Disp_TxCpltCallback from HAL_SPI_TxCpltCallback, it starts
+                  the next 64KB DMA packet of the frame and records the end of the transfer.
+                  Otherwise only the first packet overlaps the drawing, the rest is sent by
+                  the next present.
+                  Add a buffer to the render handle (ST7789_Disp_AddMemory) to draw the
+                  glyphs with one bus write per glyph.
+
+~ Changes    :
+------------------------------------------------------------------------------
+*/
+
+#ifndef __ST7789_SWAP_H_
+#define __ST7789_SWAP_H_
+
+/* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ Include ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+#include "st7789.h"
+#include "st7789_bus.h"
+
+/* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ Types ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+typedef enum /* Present Mode */
+{
+	
+	ST7789_SWAP_FULL  = 0x00, // Send the full frame
+	ST7789_SWAP_DIRTY = 0x01, // Send the rows written since the last present
+	
+}ST7789_SwapModeTypeDef;
+
+typedef struct /* Swap Chain Statistics */
+{
+	
+	uint32_t Frames;       // Presented frames
+	uint32_t Skipped;      // Presents without written pixels (Nothing sent)
+	
+	uint32_t RenderTime;   // Drawing time of the last frame (us)
+	uint32_t TransferTime; // Transfer time of the frame before (us)
+	uint32_t WaitTime;     // Time the last present waited for the transfer (us, > 0: Bus-bound)
+	uint32_t FrameTime;    // Time between the last two presents (us)
+	uint8_t  Overlap;      // Part of the transfer time that ran during the drawing (%)
+	
+	uint32_t SentRows;     // Rows sent by the last present
+	
+}ST7789_SwapStatsTypeDef;
+
+/* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ Prototype ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+/*
+ * Function: ST7789_Swap_Init
+ * --------------------------
+ * Initialize the swap chain of an initialized display
+ *
+ * Param  :
+ *         hlcd   : Display handle (NULL: ST7789_Display)
+ *         Frame0 : First frame buffer (Width x Height pixels of the current rotation)
+ *         Frame1 : Second frame buffer
+ *         Mode   : ST7789_SWAP_FULL or ST7789_SWAP_DIRTY
+ *
+ * Returns:
+ *         Render handle that draws to the back buffer (NULL: Invalid parameters)
+ *
+ * Example:
+ *         static uint16_t frames[2][240 * 280];
+ *         ST7789_HandleTypeDef *back;
+ *
+ *         ST7789_Init();
+ *         back = ST7789_Swap_Init(NULL, frames[0], frames[1], ST7789_SWAP_DIRTY);
+ *         ...
+ *
+ */
+ST7789_HandleTypeDef *ST7789_Swap_Init(ST7789_HandleTypeDef *hlcd, uint16_t *Frame0, uint16_t *Frame1, ST7789_SwapModeTypeDef Mode);
+
+/*
+ * Function: ST7789_Swap_Present
+ * -----------------------------
+ * Send the back buffer to the LCD in the background and swap the buffers, waits only for the
+ * transfer of the frame before
+ *
+ * Param  :
+ *         -
+ *
+ * Returns:
+ *         -
+ *
+ * Example:
+ *         while (1)
+ *         {
+ *             ST7789_Disp_FillScreen(back, ST7789_COLOR_BLACK);
+ *             ST7789_Disp_DrawLine(back, 0, 0, x, 279, ST7789_COLOR_GREEN);
+ *             ST7789_Swap_Present();
+ *         }
+ *
+ */
+void ST7789_Swap_Present(void);
+
+/*
+ * Function: ST7789_Swap_GetStats
+ * ------------------------------
+ * Get the render, transfer and overlap times of the swap chain, a WaitTime above 0 shows
+ * that the bus is slower than the drawing (Bus-bound), an Overlap of 100% with WaitTime 0
+ * shows that the drawing is slower (CPU-bound)
+ *
+ * Param  :
+ *         Stats : Pointer to the statistics
+ *
+ * Returns:
+ *         -
+ *
+ * Example:
+ *         ST7789_SwapStatsTypeDef stats;
+ *
+ *         ST7789_Swap_GetStats(&stats);
+ *         ...
+ *
+ */
+void ST7789_Swap_GetStats(ST7789_SwapStatsTypeDef *Stats);
+
+/* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ End of the program ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+#endif /* __ST7789_SWAP_H_ */